@@ -1,5 +1,7 @@
 import FWCore.ParameterSet.Config as cms
 
-dtCertificationSummary = cms.EDAnalyzer("DTCertificationSummary")
-
-
+dtCertificationSummary = cms.EDAnalyzer("DTCertificationSummary",
+    # keep the certification of each LS (DT/EventInfo/CertificationSummaryByLumi):
+    # run quality x HV fraction of the LS from dtDCSByLumiSummary, to be run before
+    byLumiCertification = cms.untracked.bool(True)
+)
@@ -7,7 +7,12 @@ chamberEfficiencyTest = cms.EDAnalyzer("DTChamberEfficiencyTest",
     YEfficiencyTestName = cms.untracked.string('ChEfficiencyInRangeY'),
     folderRoot = cms.untracked.string(''),
     debug = cms.untracked.bool(False),
-    diagnosticPrescale = cms.untracked.int32(1)
+    diagnosticPrescale = cms.untracked.int32(1),
+    # keep the X vs Y efficiencies sparse, the MEs are booked only for the chambers with data
+    sparseStorage = cms.untracked.bool(True),
+    # export them only at the end of the run; True: at each diagnostic too, to see them
+    # online during the run (a dense ME is then kept for each chamber with data)
+    exportByLumi = cms.untracked.bool(False)
 )
 
 
@@ -0,0 +1,7 @@
+import FWCore.ParameterSet.Config as cms
+
+# to be put at the end of the client sequence
+dtClientPerformanceMonitor = cms.EDAnalyzer("DTClientPerformanceMonitor",
+                                            # one JSON line per client method and LS (empty: no file)
+                                            jsonFile = cms.untracked.string('')
+                                            )
@@ -0,0 +1,9 @@
+import FWCore.ParameterSet.Config as cms
+
+# to be put at the beginning of the client sequence
+dtClientSchedulePlanner = cms.EDAnalyzer("DTClientSchedulePlanner",
+                                         # CPU time (s) the clients can use at the end of each LS
+                                         cpuBudgetPerLS = cms.untracked.double(2.),
+                                         # every client runs at least once every maxSkippedLS LS
+                                         maxSkippedLS = cms.untracked.int32(5)
+                                         )
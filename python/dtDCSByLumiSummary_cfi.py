@@ -1,5 +1,6 @@
 import FWCore.ParameterSet.Config as cms
 
-dtDCSByLumiSummary = cms.EDAnalyzer("DTDCSByLumiSummary")
-
-
+dtDCSByLumiSummary = cms.EDAnalyzer("DTDCSByLumiSummary",
+                                    # max # of LS in the HV trend plots
+                                    trendCapacity = cms.untracked.int32(5000)
+                                    )
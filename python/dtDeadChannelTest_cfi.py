@@ -6,7 +6,9 @@ deadChannelTest = cms.EDAnalyzer("DTDeadChannelTest",
     diagnosticPrescale = cms.untracked.int32(1),
     folderRoot = cms.untracked.string(''),
     #Names of the quality tests: they must match those specified in "qtList"
-    EfficiencyTestName = cms.untracked.string('OccupancyDiffInRange')
+    EfficiencyTestName = cms.untracked.string('OccupancyDiffInRange'),
+    # book the layer MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False)
 )
 
 
@@ -0,0 +1,23 @@
+import FWCore.ParameterSet.Config as cms
+
+wheels = range(-2,3)
+
+# to be put at the end of the client sequence
+dtDeltaStreamWriter = cms.EDAnalyzer("DTDeltaStreamWriter",
+                                     # binary log of the changes of the MEs, LS by LS
+                                     fileName = cms.untracked.string('DTClientDeltas.dtdl'),
+                                     # full copy of the MEs every keyFrameInterval blocks
+                                     keyFrameInterval = cms.untracked.int32(100),
+                                     monitorElements = cms.untracked.vstring(
+    ['DT/00-DataIntegrity/DataIntegritySummary',
+     'DT/00-ROChannels/ROChannelSummary',
+     'DT/01-Digi/OccupancySummary',
+     'DT/05-Noise/NoiseSummary',
+     'DT/05-Noise/SynchNoise/SynchNoiseSummary',
+     'DT/02-Segments/ResidualsGlbSummary',
+     'DT/EventInfo/reportSummaryMap'] +
+    # per chamber results (sector x station)
+    ['DT/00-ROChannels/ROChannelSummary_W%d' % wheel for wheel in wheels] +
+    ['DT/01-Digi/OccupancySummary_W%d' % wheel for wheel in wheels] +
+    ['DT/05-Noise/NoiseSummary_W%d' % wheel for wheel in wheels])
+                                     )
@@ -7,7 +7,9 @@ efficiencyTest = cms.EDAnalyzer("DTEfficiencyTest",
     EfficiencyTestName = cms.untracked.string('EfficiencyInRange'),
     folderRoot = cms.untracked.string(''),
     debug = cms.untracked.bool(False),
-    diagnosticPrescale = cms.untracked.int32(1)
+    diagnosticPrescale = cms.untracked.int32(1),
+    # book the layer MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False)
 )
 
 
@@ -20,6 +20,8 @@ dtFineDelayCorr = cms.EDAnalyzer("DTFineDelayCorr",
     writeDB = cms.bool(False),
     # output file name
     outputFile = cms.string("dtFineDelaysNew.txt"),
+    # write the output file in binary format (see test/dtFineDelayConvert.py)
+    binaryOutput = cms.untracked.bool(False),
     # Tag for the t0Mean Histograms
     t0MeanHistoTag  = cms.string("TrackCrossingTimeAll"),
     # Hardware Source (DDU or DCC)
@@ -27,7 +29,9 @@ dtFineDelayCorr = cms.EDAnalyzer("DTFineDelayCorr",
     # Choose to use Hist Mean or Gaussian Fit Mean
     gaussMean = cms.bool(False),
     # Require Minimum Number Of Entries in the t0Mean Histogram
-    minEntries = cms.untracked.int32(300)
+    minEntries = cms.untracked.int32(300),
+    # history of the new delays per chamber across runs (empty: disabled)
+    calibHistoryFile = cms.untracked.string('')
                                 
     #bxTimeInterval = cms.double(24.95),
     #rangeWithinBX  = cms.bool(True),
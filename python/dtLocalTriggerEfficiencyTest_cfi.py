@@ -10,7 +10,11 @@ triggerEfficiencyTest = cms.EDAnalyzer("DTLocalTriggerEfficiencyTest",
     # false if DTLocalTriggerTask used LTC digis
     localrun = cms.untracked.bool(True),
     # root folder for booking of histograms
-    folderRoot = cms.untracked.string('')
+    folderRoot = cms.untracked.string(''),
+    # use Wilson score interval instead of binomial errors for efficiencies
+    wilsonErrors = cms.untracked.bool(False),
+    # book the chamber MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False)
 )
 
 
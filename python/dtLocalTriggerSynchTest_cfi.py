@@ -11,6 +11,8 @@ triggerSynchTest = cms.EDAnalyzer("DTLocalTriggerSynchTest",
     localrun = cms.untracked.bool(True),                         
     # root folder for booking of histograms
     folderRoot = cms.untracked.string(''),
+    # book the chamber MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False),
     # correlated fraction test tresholds
     bxTimeInterval  = cms.double(25),
     rangeWithinBX   = cms.bool(True),
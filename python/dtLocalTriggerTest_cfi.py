@@ -20,7 +20,9 @@ triggerTest = cms.EDAnalyzer("DTLocalTriggerTest",
     # DDU-DCC matching tests tresholds
     matchingFracError     = cms.untracked.double(0.65),
     matchingFracWarning   = cms.untracked.double(0.85),
-    nEventsCert = cms.untracked.int32(1000)
+    nEventsCert = cms.untracked.int32(1000),
+    # book the sector MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False)
                              
 
 )
@@ -5,7 +5,8 @@ dtNoiseAnalysisMonitor = cms.EDAnalyzer("DTNoiseAnalysisTest",
                                         doSynchNoise = cms.untracked.bool(False),
                                         detailedAnalysis = cms.untracked.bool(False),
                                         maxSynchNoiseRate = cms.untracked.double(0.001),
-                                        nEventsCert = cms.untracked.int32(1000)
+                                        nEventsCert = cms.untracked.int32(1000),
+                                        asyncMode = cms.untracked.bool(False)
                                         )
 
 
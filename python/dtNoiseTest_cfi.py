@@ -7,7 +7,9 @@ noiseTest = cms.EDAnalyzer("DTNoiseTest",
     folderTag = cms.untracked.string('Occupancies'),
     folderRoot = cms.untracked.string(''),
     debug = cms.untracked.bool(False),
-    diagnosticPrescale = cms.untracked.int32(1000)
+    diagnosticPrescale = cms.untracked.int32(1000),
+    # book the chamber/layer MEs up front instead of on data
+    eagerBooking = cms.untracked.bool(False)
 )
 
 
@@ -5,7 +5,8 @@ dtOccupancyTest = cms.EDAnalyzer("DTOccupancyTest",
                                  runOnAllHitsOccupancies = cms.untracked.bool(True),
                                  runOnNoiseOccupancies = cms.untracked.bool(False),
                                  runOnInTimeOccupancies = cms.untracked.bool(False),
-                                 nEventsCert = cms.untracked.int32(2500)
+                                 nEventsCert = cms.untracked.int32(2500),
+                                 asyncMode = cms.untracked.bool(False)
                                  )
 
 
@@ -0,0 +1,24 @@
+import FWCore.ParameterSet.Config as cms
+
+dtReferenceComparisonTest = cms.EDAnalyzer("DTReferenceComparisonTest",
+                                           diagnosticPrescale = cms.untracked.int32(1),
+                                           # "chi2" or "KS"
+                                           method = cms.untracked.string('chi2'),
+                                           # local cache of the reference shapes
+                                           referenceFile = cms.untracked.string('DTReference.dtrc'),
+                                           # True on the reference run to write the cache
+                                           writeReference = cms.untracked.bool(False),
+                                           # {W}, {St}, {Sec}, {SL}, {L} are replaced for each chamber:
+                                           # per layer histos with {L}, otherwise one 2D histo
+                                           # per chamber with the layers as Y bins.
+                                           # The tests need counts: use occupancies, not rates or efficiencies
+                                           shapes = cms.untracked.VPSet(
+    cms.PSet(name = cms.untracked.string('Occupancy'),
+             histoPath = cms.untracked.string('DT/01-Digi/Wheel{W}/Sector{Sec}/Station{St}/OccupancyAllHits_perCh_W{W}_St{St}_Sec{Sec}')),
+    # hits in the noise window (NoiseRate is in Hz and can not be used)
+    cms.PSet(name = cms.untracked.string('NoiseOccupancy'),
+             histoPath = cms.untracked.string('DT/01-Digi/Wheel{W}/Sector{Sec}/Station{St}/OccupancyNoise_perCh_W{W}_St{St}_Sec{Sec}')),
+    # cells crossed by the segments (denominator of the layer efficiency)
+    cms.PSet(name = cms.untracked.string('SegmentOccupancy'),
+             histoPath = cms.untracked.string('DT/DTEfficiencyTask/Wheel{W}/Station{St}/Sector{Sec}/SuperLayer{SL}/hEffOccupancy_W{W}_St{St}_Sec{Sec}_SL{SL}_L{L}')))
+                                           )
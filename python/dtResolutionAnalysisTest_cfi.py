@@ -7,7 +7,9 @@ dtResolutionAnalysisTest = cms.EDAnalyzer("DTResolutionAnalysisTest",
                                           maxGoodSigmaValue = cms.untracked.double(0.05),
                                           minBadSigmaValue = cms.untracked.double(0.08),
                                           # top folder for the histograms in DQMStore
-                                          topHistoFolder = cms.untracked.string("DT/02-Segments")
+                                          topHistoFolder = cms.untracked.string("DT/02-Segments"),
+                                          # history of the residual mean and sigma per SL across runs (empty: disabled)
+                                          calibHistoryFile = cms.untracked.string('')
                                           )
 
 
@@ -19,4 +19,10 @@ dtRunConditionVarClient = cms.EDAnalyzer("DTRunConditionVarClient",
    maxGoodT0Sigma     = cms.untracked.double(2.),
    minBadT0Sigma      = cms.untracked.double(4.),
 
+   # fill the summaries also at each end of LS
+   runOnline          = cms.untracked.bool(False),
+
+   # history of vDrift and t0 per chamber across runs (empty: disabled)
+   calibHistoryFile   = cms.untracked.string(''),
+
 )
@@ -0,0 +1,20 @@
+import FWCore.ParameterSet.Config as cms
+
+# to be put at the end of the client sequence
+dtSummaryShmPublisher = cms.EDAnalyzer("DTSummaryShmPublisher",
+                                       # POSIX shared memory segment read by the local consumers
+                                       segmentName = cms.untracked.string('/dtDQMSummaries'),
+                                       # remove the segment at the end of the job
+                                       removeAtEnd = cms.untracked.bool(False),
+                                       summaryMaps = cms.untracked.vstring('DT/00-DataIntegrity/DataIntegritySummary',
+                                                                           'DT/01-Digi/OccupancySummary',
+                                                                           'DT/05-Noise/SynchNoise/SynchNoiseSummary',
+                                                                           'DT/02-Segments/ResidualsGlbSummary',
+                                                                           'DT/EventInfo/reportSummaryMap'),
+                                       reports = cms.untracked.vstring('DT/EventInfo/reportSummary',
+                                                                       'DT/EventInfo/reportSummaryContents/DT_Wheel-2',
+                                                                       'DT/EventInfo/reportSummaryContents/DT_Wheel-1',
+                                                                       'DT/EventInfo/reportSummaryContents/DT_Wheel0',
+                                                                       'DT/EventInfo/reportSummaryContents/DT_Wheel1',
+                                                                       'DT/EventInfo/reportSummaryContents/DT_Wheel2')
+                                       )
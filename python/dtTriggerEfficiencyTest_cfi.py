@@ -11,6 +11,8 @@ triggerEffTest = cms.EDAnalyzer("DTTriggerEfficiencyTest",
     localrun = cms.untracked.bool(True),
     # root folder for booking of histograms
     folderRoot = cms.untracked.string(''),
+    # use Wilson score interval instead of binomial errors for efficiencies
+    wilsonErrors = cms.untracked.bool(False),
     #enable generation of chamber granularity plots
     detailedAnalysis = cms.untracked.bool(False)                                  
 )
@@ -6,7 +6,9 @@ tTrigCalibrationTest = cms.EDAnalyzer("DTtTrigCalibrationTest",
     diagnosticPrescale = cms.untracked.int32(1),
     histoTag = cms.untracked.string('TimeBox'),
     #Names of the quality test: it must match those specified in "qtList"
-    folderRoot = cms.untracked.string('')
+    folderRoot = cms.untracked.string(''),
+    # history of the tTrig per SL across runs (empty: disabled)
+    calibHistoryFile = cms.untracked.string('')
 )
 
 
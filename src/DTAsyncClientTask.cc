@@ -0,0 +1,85 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTAsyncClientTask.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <exception>
+
+using namespace std;
+
+
+DTAsyncClientTask::DTAsyncClientTask(const string& client) :
+  theClient(client), theThread(0), theNTasks(0), theTaskTime(0.), theWaitTime(0.) {}
+
+
+DTAsyncClientTask::~DTAsyncClientTask() {
+
+  wait();
+
+}
+
+
+void DTAsyncClientTask::start(const boost::function<void ()>& work) {
+
+  wait();
+  theThread = new boost::thread(boost::bind(&DTAsyncClientTask::run, this, work));
+  theNTasks++;
+
+}
+
+
+void DTAsyncClientTask::wait() {
+
+  if(theThread == 0) return;
+
+  double start = DTClientPerformance::wallTime();
+  theThread->join();
+  theWaitTime += DTClientPerformance::wallTime() - start;
+
+  delete theThread;
+  theThread = 0;
+
+  if(!theError.empty()) {
+    edm::LogError("DTDQM|DTMonitorClient|" + theClient)
+      << "[" << theClient << "]: background task failed: " << theError;
+    theError.clear();
+  }
+
+}
+
+
+void DTAsyncClientTask::report() const {
+
+  double overlap = theTaskTime > 0. ? 100.*(theTaskTime - theWaitTime)/theTaskTime : 0.;
+  edm::LogVerbatim("DTDQM|DTMonitorClient|" + theClient)
+    << "[" << theClient << "]: " << theNTasks << " background tasks, "
+    << theTaskTime << " s of work, " << theWaitTime << " s waited at the LS boundaries ("
+    << overlap << "% overlapped with the framework)";
+
+}
+
+
+void DTAsyncClientTask::run(boost::function<void ()> work) {
+
+  double start = DTClientPerformance::wallTime();
+  // no exception may leave the thread
+  try {
+    work();
+  } catch(std::exception& exception) {
+    theError = exception.what();
+  } catch(...) {
+    theError = "unknown exception";
+  }
+  theTaskTime += DTClientPerformance::wallTime() - start;
+
+}
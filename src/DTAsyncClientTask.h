@@ -0,0 +1,61 @@
+#ifndef DTAsyncClientTask_H
+#define DTAsyncClientTask_H
+
+/** \class DTAsyncClientTask
+ *  Runs the end of LS work of a client in a background thread.
+ *  The work must only touch private copies of the histos (never the DQMStore);
+ *  at most one task is in flight: start() and wait() join the previous one.
+ *  The time spent in the tasks and the time the framework thread was
+ *  blocked waiting for them are accumulated to report the overlap achieved.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <boost/function.hpp>
+
+#include <string>
+
+namespace boost { class thread; }
+
+class DTAsyncClientTask {
+
+public:
+
+  /// Constructor
+  explicit DTAsyncClientTask(const std::string& client);
+
+  /// Destructor: waits for the task in flight
+  ~DTAsyncClientTask();
+
+  /// Run the work in a background thread (after waiting for the previous task)
+  void start(const boost::function<void ()>& work);
+
+  /// Wait for the task in flight, if any
+  void wait();
+
+  /// Is a task in flight?
+  bool inFlight() const { return theThread != 0; };
+
+  /// Log the # of tasks, the time spent in them and the overlap with the framework thread
+  void report() const;
+
+private:
+
+  DTAsyncClientTask(const DTAsyncClientTask&);
+  DTAsyncClientTask& operator=(const DTAsyncClientTask&);
+
+  void run(boost::function<void ()> work);
+
+  std::string theClient;
+  boost::thread* theThread;
+
+  int theNTasks;
+  // written by the task, read after the join
+  double theTaskTime;
+  std::string theError;
+  double theWaitTime;
+
+};
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+
+// Framework
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+//C++ headers
+#include <algorithm>
+#include <sstream>
+
+using namespace edm;
+using namespace std;
+
+
+const vector<dqm::me_util::Channel> DTBadChannelCollector::noChannels;
+
+
+bool DTBadChannelCollector::BadChannel::operator<(const BadChannel& other) const {
+
+  if (element != other.element) return element < other.element;
+  if (test != other.test) return test < other.test;
+  return bin < other.bin;
+
+}
+
+
+DTBadChannelCollector::DTBadChannelCollector(const ParameterSet& ps, const string& clientName, const string& category,
+					     bool errorOnNew) :
+  theClientName(clientName), theCategory(category), theErrorOnNew(errorOnNew), theLumi(0), theFoundQReport(false), theCountsME(0), theDumpFile(0) {
+
+  theMaxDetails = ps.getUntrackedParameter<unsigned int>("badChannelMaxDetails",10);
+
+  string dumpFileName = ps.getUntrackedParameter<string>("badChannelDumpFile","");
+  if (dumpFileName != "") {
+    theDumpFile = new ofstream(dumpFileName.c_str(), ios::out | ios::binary | ios::app);
+  }
+
+}
+
+
+DTBadChannelCollector::~DTBadChannelCollector() {
+
+  if (theDumpFile) {
+    theDumpFile->close();
+    delete theDumpFile;
+  }
+
+}
+
+
+int DTBadChannelCollector::addTest(const string& qTestName) {
+
+  theTests.push_back(qTestName);
+  return theTests.size()-1;
+
+}
+
+
+void DTBadChannelCollector::bookHistos(DQMStore* dbe, const string& folder) {
+
+  // booked once per job (the clients booking in beginRun call it at each run)
+  if (theCountsME) return;
+
+  dbe->setCurrentFolder(folder);
+  string histoName = "BadChannels_" + theClientName;
+  int nTests = theTests.size();
+  theCountsME = dbe->book1D(histoName.c_str(),histoName.c_str(),nTests,0,nTests);
+  for (int iTest=0; iTest<nTests; ++iTest) {
+    theCountsME->setBinLabel(iTest+1,theTests[iTest],1);
+  }
+
+}
+
+
+void DTBadChannelCollector::beginCollection(int lumi) {
+
+  theLumi = lumi;
+  thePrevious.swap(theCurrent);
+  theCurrent.clear();
+
+}
+
+
+const vector<dqm::me_util::Channel>& DTBadChannelCollector::collect(const MonitorElement* me, int test, uint32_t element) {
+
+  const QReport * theQReport = me->getQReport(theTests[test]);
+  theFoundQReport = (theQReport != 0);
+  if (!theFoundQReport) return noChannels;
+
+  const vector<dqm::me_util::Channel>& badChannels = theQReport->getBadChannels();
+  for (vector<dqm::me_util::Channel>::const_iterator channel = badChannels.begin(); 
+       channel != badChannels.end(); ++channel) {
+    BadChannel bad;
+    bad.element  = element;
+    bad.test     = test;
+    bad.bin      = (*channel).getBin();
+    bad.contents = (*channel).getContents();
+    bad.me       = me;
+    theCurrent.push_back(bad);
+  }
+
+  return badChannels;
+
+}
+
+
+void DTBadChannelCollector::endCollection() {
+
+  sort(theCurrent.begin(),theCurrent.end());
+
+  // compare with the previous collection (both are sorted)
+  vector<const BadChannel*> newChannels;
+  int nRecovered = 0;
+  vector<BadChannel>::const_iterator curr = theCurrent.begin();
+  vector<BadChannel>::const_iterator prev = thePrevious.begin();
+  while (curr != theCurrent.end() || prev != thePrevious.end()) {
+    if (prev == thePrevious.end() || (curr != theCurrent.end() && (*curr) < (*prev))) {
+      newChannels.push_back(&(*curr));
+      ++curr;
+    } else if (curr == theCurrent.end() || (*prev) < (*curr)) {
+      ++nRecovered;
+      ++prev;
+    } else {
+      ++curr;
+      ++prev;
+    }
+  }
+
+  // one record per LS
+  if (!newChannels.empty() || nRecovered) {
+    stringstream record;
+    record << "[" << theClientName << "]: LS " << theLumi << " " << theCurrent.size() << " bad channels ("
+	   << newChannels.size() << " new, " << nRecovered << " recovered)";
+    unsigned int nDetails = min(theMaxDetails,(unsigned int)newChannels.size());
+    for (unsigned int iNew=0; iNew<nDetails; ++iNew) {
+      const BadChannel& bad = *(newChannels[iNew]);
+      record << "\n  " << bad.me->getName() << " " << theTests[bad.test]
+	     << " bin: " << bad.bin << " contents: " << bad.contents;
+    }
+    if (nDetails < newChannels.size()) {
+      record << "\n  ... " << newChannels.size()-nDetails << " more";
+    }
+    if (theErrorOnNew && !newChannels.empty()) {
+      LogError(theCategory) << record.str();
+    } else {
+      LogVerbatim(theCategory) << record.str();
+    }
+  }
+
+  // # of bad channels per test
+  if (theCountsME) {
+    vector<int> counts(theTests.size(),0);
+    for (curr = theCurrent.begin(); curr != theCurrent.end(); ++curr) {
+      counts[(*curr).test]++;
+    }
+    for (unsigned int iTest=0; iTest<counts.size(); ++iTest) {
+      theCountsME->setBinContent(iTest+1,counts[iTest]);
+    }
+  }
+
+  // binary dump of the full table
+  if (theDumpFile) {
+    int32_t lumi = theLumi;
+    int32_t nChannels = theCurrent.size();
+    theDumpFile->write(reinterpret_cast<const char*>(&lumi),sizeof(lumi));
+    theDumpFile->write(reinterpret_cast<const char*>(&nChannels),sizeof(nChannels));
+    for (curr = theCurrent.begin(); curr != theCurrent.end(); ++curr) {
+      uint32_t element = (*curr).element;
+      int32_t test     = (*curr).test;
+      int32_t bin      = (*curr).bin;
+      float contents   = (*curr).contents;
+      theDumpFile->write(reinterpret_cast<const char*>(&element),sizeof(element));
+      theDumpFile->write(reinterpret_cast<const char*>(&test),sizeof(test));
+      theDumpFile->write(reinterpret_cast<const char*>(&bin),sizeof(bin));
+      theDumpFile->write(reinterpret_cast<const char*>(&contents),sizeof(contents));
+    }
+    theDumpFile->flush();
+  }
+
+}
@@ -0,0 +1,101 @@
+#ifndef DTBadChannelCollector_H
+#define DTBadChannelCollector_H
+
+/** \class DTBadChannelCollector
+ *  Collects the bad channels reported by the QTests of a client into a
+ *  compact table (one table per LS).
+ *  Instead of one log message per bad channel, a single record per LS
+ *  is emitted, reporting the new and recovered channels with respect to
+ *  the previous collection. The number of bad channels per test is
+ *  published as ME and the full table can be dumped to a binary file
+ *  (badChannelDumpFile parameter). Each LS is written as:
+ *  int32 LS, int32 # of channels, then per channel
+ *  uint32 element, int32 test, int32 bin, float contents.
+ *
+ *  The element is a client defined identifier: the raw DetId for
+ *  chamber/SL/layer based histos, wheelSectorElement() for the sector ones.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQMServices/Core/interface/QReport.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class DQMStore;
+class MonitorElement;
+
+namespace edm {
+  class ParameterSet;
+}
+
+class DTBadChannelCollector {
+
+public:
+
+  /// Bad channel record
+  struct BadChannel {
+    uint32_t element;
+    int test;
+    int bin;
+    float contents;
+    const MonitorElement* me;
+    bool operator<(const BadChannel& other) const;
+  };
+
+  /// Constructor: the records with new bad channels are LogError if errorOnNew, LogVerbatim otherwise
+  DTBadChannelCollector(const edm::ParameterSet& ps, const std::string& clientName, const std::string& category,
+			bool errorOnNew = true);
+
+  /// Destructor
+  virtual ~DTBadChannelCollector();
+
+  /// Register a QTest by name, returns its index in the table
+  int addTest(const std::string& qTestName);
+
+  /// Book the ME with the # of bad channels per test (once)
+  void bookHistos(DQMStore* dbe, const std::string& folder);
+
+  /// Start the collection for a new LS
+  void beginCollection(int lumi);
+
+  /// Collect the bad channels of a test on an ME (the list is returned for further use)
+  const std::vector<dqm::me_util::Channel>& collect(const MonitorElement* me, int test, uint32_t element);
+
+  /// True if the ME of the last collect call had the QReport
+  bool foundQReport() const { return theFoundQReport; };
+
+  /// Compare with the previous collection, emit the LS record, fill the ME and dump the table
+  void endCollection();
+
+  /// Table of the last collection (ordered by element, test, bin)
+  const std::vector<BadChannel>& badChannels() const { return theCurrent; };
+
+  /// Element identifier for histos by wheel and sector
+  static uint32_t wheelSectorElement(int wheel, int sector) { return (wheel+2)*100 + sector; };
+
+private:
+
+  std::string theClientName;
+  std::string theCategory;
+  bool theErrorOnNew;
+  unsigned int theMaxDetails;
+  int theLumi;
+  bool theFoundQReport;
+
+  std::vector<std::string> theTests;
+  std::vector<BadChannel> theCurrent;
+  std::vector<BadChannel> thePrevious;
+
+  MonitorElement* theCountsME;
+  std::ofstream* theDumpFile;
+
+  static const std::vector<dqm::me_util::Channel> noChannels;
+
+};
+
+#endif
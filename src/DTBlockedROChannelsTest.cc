@@ -9,6 +9,7 @@
  */
 
 #include <DQM/DTMonitorClient/src/DTBlockedROChannelsTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 //Framework
 #include "DataFormats/FEDRawData/interface/FEDNumbering.h"
@@ -18,7 +19,8 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
-#include "DQM/DTMonitorModule/interface/DTTimeEvolutionHisto.h"
+#include "DQM/DTMonitorClient/src/DTTrendBuffer.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
 #include <iostream>
 #include <string>
 
@@ -47,6 +49,7 @@ DTBlockedROChannelsTest::DTBlockedROChannelsTest(const ParameterSet& ps) : neven
 DTBlockedROChannelsTest::~DTBlockedROChannelsTest() {
   LogTrace("DTDQM|DTRawToDigi|DTMonitorClient|DTBlockedROChannelsTest")
     << "DataIntegrityTest: analyzed " << nupdates << " updates";
+  delete hSystFractionVsLS;
 }
 
 
@@ -79,8 +82,8 @@ void DTBlockedROChannelsTest::beginJob() {
   }
 
   if(!offlineMode) {
-    hSystFractionVsLS = new DTTimeEvolutionHisto(dbe, "EnabledROChannelsVsLS", "% RO channels",
-        500, 5, true, 3);
+    hSystFractionVsLS = new DTTrendBuffer(dbe, "EnabledROChannelsVsLS", "% RO channels",
+        500, 5, true);
   }
 
 }
@@ -155,6 +158,7 @@ void DTBlockedROChannelsTest::analyze(const Event& e, const EventSetup& context)
 
 
 void DTBlockedROChannelsTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTBlockedROChannelsTest", DTClientPerformance::EndLumi);
 
   // counts number of lumiSegs 
   nLumiSegs = lumiSeg.id().luminosityBlock();
@@ -173,13 +177,14 @@ void DTBlockedROChannelsTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 
 
 void DTBlockedROChannelsTest::performClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTBlockedROChannelsTest", DTClientPerformance::Diagnostic);
 
   // skip empty LSs
 
   if(nevents == 0) { // hack to work also in offline DQM
-    MonitorElement *procEvt =  dbe->get("DT/EventInfo/processedEvents");
-    if(procEvt != 0) {
-      int procEvents = procEvt->getIntValue();
+    const DTEventCounters& counters = DTEventCounters::get(dbe, run, nLumiSegs);
+    if(counters.found(DTEventCounters::Processed)) {
+      int procEvents = counters.events(DTEventCounters::Processed);
       nevents = procEvents - neventsPrev;
       neventsPrev = procEvents;
     }
@@ -245,8 +250,8 @@ void DTBlockedROChannelsTest::performClientDiagnostic() {
   //   }
 
   if(!offlineMode) { // fill trend histo only in online
-    hSystFractionVsLS->accumulateValueTimeSlot(totalPerc);
-    hSystFractionVsLS->updateTimeSlot(nLumiSegs, nevents);
+    hSystFractionVsLS->append(nLumiSegs, totalPerc);
+    hSystFractionVsLS->materialize();
     prevTotalPerc = totalPerc;
   }
 
@@ -263,10 +268,12 @@ void DTBlockedROChannelsTest::endJob(){
 
 
 void DTBlockedROChannelsTest::endRun(edm::Run const& run, edm::EventSetup const& eSetup) {
+  DTClientPerformance::Timer timer("DTBlockedROChannelsTest", DTClientPerformance::EndRun);
 
   if (offlineMode) {
     LogTrace("DTDQM|DTRawToDigi|DTMonitorClient|DTBlockedROChannelsTest")
       <<"[DTBlockedROChannelsTest] endRun called. Client called in offline mode, performing operations.";
+    DTEventCounters::refresh(dbe, run.run());
     performClientDiagnostic();
   }
   // commented out since trend plots need to be updated in by lumi certification  
@@ -21,7 +21,7 @@
 class DQMStore;
 class MonitorElement;
 class DTReadOutMapping;
-class DTTimeEvolutionHisto;
+class DTTrendBuffer;
 
 class DTBlockedROChannelsTest: public edm::EDAnalyzer{
 
@@ -89,7 +89,7 @@ class DTBlockedROChannelsTest: public edm::EDAnalyzer{
     bool offlineMode;
 
     std::map<int, double> resultsPerLumi;
-    DTTimeEvolutionHisto* hSystFractionVsLS;
+    DTTrendBuffer* hSystFractionVsLS;
 
 
     class DTRobBinsMap {
@@ -0,0 +1,80 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTBookingPolicy.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TH1.h"
+
+using namespace std;
+using namespace edm;
+
+namespace {
+  // ROOT object, axes and DQMStore bookkeeping of a ME, on top of its bins (bytes)
+  const long meOverhead = 1024;
+}
+
+
+DTBookingPolicy::DTBookingPolicy() : theEager(true), theNBooked(0), theBytes(0) {}
+
+
+DTBookingPolicy::DTBookingPolicy(const ParameterSet& ps, const string& clientName) :
+  theNBooked(0), theBytes(0) {
+
+  configure(ps, clientName);
+
+}
+
+
+void DTBookingPolicy::configure(const ParameterSet& ps, const string& clientName) {
+
+  theClientName = clientName;
+  // book the output MEs of all the elements up front (expert runs)
+  theEager = ps.getUntrackedParameter<bool>("eagerBooking", false);
+
+}
+
+
+bool DTBookingPolicy::materialize(uint32_t element, bool hasData, bool notOK) {
+
+  if(theEager || hasData || notOK) {
+    theUnbooked.erase(element);
+    return true;
+  }
+  theUnbooked.insert(element);
+  return false;
+
+}
+
+
+MonitorElement* DTBookingPolicy::booked(MonitorElement* me) {
+
+  if(me == 0) return me;
+  theNBooked++;
+  theBytes += meOverhead;
+  TH1* histo = me->getTH1();
+  if(histo != 0) {
+    bool singlePrecision = me->kind() == MonitorElement::DQM_KIND_TH1F || me->kind() == MonitorElement::DQM_KIND_TH2F;
+    theBytes += histo->GetNcells()*(singlePrecision ? sizeof(float) : sizeof(double));
+  }
+  return me;
+
+}
+
+
+void DTBookingPolicy::report() const {
+
+  LogVerbatim("DTDQM|DTMonitorClient|" + theClientName)
+    << "[" << theClientName << "]: " << (theEager ? "eager" : "lazy") << " booking, "
+    << theNBooked << " output MEs booked (~" << theBytes/1024 << " kB), "
+    << theUnbooked.size() << " elements left unbooked (no data)";
+
+}
@@ -0,0 +1,61 @@
+#ifndef DTBookingPolicy_H
+#define DTBookingPolicy_H
+
+/** \class DTBookingPolicy
+ *  Booking policy for the per chamber/SL/layer output MEs of a client.
+ *  By default (lazy booking) the output MEs of an element are booked only
+ *  once the element has input data or a non-OK result; the eagerBooking
+ *  parameter restores the booking of all the elements up front.
+ *  The booked MEs and their (estimated) memory are accounted and reported
+ *  at the end of the job together with the elements left unbooked.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <string>
+#include <set>
+#include <stdint.h>
+
+class MonitorElement;
+
+namespace edm {
+  class ParameterSet;
+}
+
+class DTBookingPolicy {
+
+public:
+
+  /// Constructor (configure has to be called before use)
+  DTBookingPolicy();
+
+  /// Constructor
+  DTBookingPolicy(const edm::ParameterSet& ps, const std::string& clientName);
+
+  /// Read the eagerBooking switch of the client
+  void configure(const edm::ParameterSet& ps, const std::string& clientName);
+
+  /// True if all the output MEs are booked up front
+  bool eager() const { return theEager; };
+
+  /// Should the output MEs of an element be booked? Elements refused are counted in the report
+  bool materialize(uint32_t element, bool hasData, bool notOK = false);
+
+  /// Account a newly booked ME (returned unchanged)
+  MonitorElement* booked(MonitorElement* me);
+
+  /// Log the # of booked MEs, their memory and the # of elements left unbooked
+  void report() const;
+
+private:
+
+  std::string theClientName;
+  bool theEager;
+  int theNBooked;
+  long theBytes;
+  std::set<uint32_t> theUnbooked;
+
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTBookingTable.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+using namespace std;
+
+
+const char* const DTBookingTable::stationLabels[4] = { "MB1", "MB2", "MB3", "MB4" };
+const char* const DTBookingTable::qualityLabels[7] = { "LI", "LO", "HI", "HO", "LL", "HL", "HH" };
+
+
+DTBookingTable::DTBookingTable(const DTHistoSpec* specs, int nSpecs) :
+  theSpecs(specs), theNSpecs(nSpecs) {}
+
+
+const DTHistoSpec* DTBookingTable::find(const string& hTag) const {
+
+  map<string, const DTHistoSpec*>::const_iterator match = theMatches.find(hTag);
+  if(match != theMatches.end()) return (*match).second;
+
+  const DTHistoSpec* spec = 0;
+  for(int iSpec = 0; iSpec < theNSpecs && spec == 0; ++iSpec) {
+    if(hTag.find(theSpecs[iSpec].tag) != string::npos) spec = &theSpecs[iSpec];
+  }
+  theMatches[hTag] = spec;
+  return spec;
+
+}
+
+
+MonitorElement* DTBookingTable::book(DQMStore* dbe, const DTHistoSpec& spec,
+				     const string& name, const string& title) {
+
+  MonitorElement* me = spec.nBinsY == 0 ?
+    dbe->book1D(name, title, spec.nBinsX, spec.lowX, spec.highX) :
+    dbe->book2D(name, title, spec.nBinsX, spec.lowX, spec.highX, spec.nBinsY, spec.lowY, spec.highY);
+
+  for(int iLabel = 0; iLabel < spec.nLabelsX; ++iLabel) {
+    me->setBinLabel(iLabel+1, spec.labelsX[iLabel], 1);
+  }
+  for(int iLabel = 0; iLabel < spec.nLabelsY; ++iLabel) {
+    me->setBinLabel(iLabel+1, spec.labelsY[iLabel], 2);
+  }
+  if(spec.titleX != 0) me->setAxisTitle(spec.titleX, 1);
+  if(spec.titleY != 0) me->setAxisTitle(spec.titleY, 2);
+
+  return me;
+
+}
+
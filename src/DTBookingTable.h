@@ -0,0 +1,65 @@
+#ifndef DTBookingTable_H
+#define DTBookingTable_H
+
+/** \class DTBookingTable
+ *  Declarative booking of the client MEs. A client describes the MEs it
+ *  books in a static array of DTHistoSpec (tag, binning, labels, axis
+ *  titles); the table finds the spec of a histo tag, caching the match,
+ *  and books the ME applying the shared label arrays. The tables are
+ *  meant to be file-static objects shared by all the instances of a client.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <string>
+#include <map>
+
+class DQMStore;
+class MonitorElement;
+
+/// Binning and decoration of a ME (nBinsY = 0 for a 1D histo)
+struct DTHistoSpec {
+  const char* tag;
+  int nBinsX;
+  double lowX;
+  double highX;
+  int nBinsY;
+  double lowY;
+  double highY;
+  const char* const* labelsX;
+  int nLabelsX;
+  const char* const* labelsY;
+  int nLabelsY;
+  const char* titleX;
+  const char* titleY;
+};
+
+class DTBookingTable {
+
+public:
+
+  /// Constructor: the specs are matched in order, the first whose tag is
+  /// contained in the histo tag wins
+  DTBookingTable(const DTHistoSpec* specs, int nSpecs);
+
+  /// The spec of a histo tag (0 if none matches)
+  const DTHistoSpec* find(const std::string& hTag) const;
+
+  /// Book a ME in the current folder of the DQMStore according to the spec
+  static MonitorElement* book(DQMStore* dbe, const DTHistoSpec& spec,
+			      const std::string& name, const std::string& title);
+
+  /// Shared bin labels
+  static const char* const stationLabels[4];
+  static const char* const qualityLabels[7];
+
+private:
+
+  const DTHistoSpec* theSpecs;
+  int theNSpecs;
+  mutable std::map<std::string, const DTHistoSpec*> theMatches;
+
+};
+
+#endif
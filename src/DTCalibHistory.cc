@@ -0,0 +1,184 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTCalibHistory.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <math.h>
+
+using namespace std;
+using namespace edm;
+
+namespace {
+  const uint32_t fileMagic = 0x48435444;   // "DTCH"
+  const uint32_t fileVersion = 1;
+  // header: magic, version, record size, spare
+  const int headerSize = 4*sizeof(uint32_t);
+}
+
+
+DTCalibHistory* DTCalibHistory::get(const string& fileName) {
+
+  static map<string, DTCalibHistory*> stores;
+  map<string, DTCalibHistory*>::const_iterator store = stores.find(fileName);
+  if(store != stores.end()) return (*store).second;
+
+  DTCalibHistory *history = new DTCalibHistory(fileName);
+  if(!history->open()) {
+    delete history;
+    history = 0;
+  }
+  stores[fileName] = history;
+  return history;
+
+}
+
+
+DTCalibHistory::DTCalibHistory(const string& fileName) :
+  theFileName(fileName), theFd(-1), theMapped(0), theNMapped(0) {}
+
+
+DTCalibHistory::~DTCalibHistory() {
+
+  if(theMapped != 0) munmap((void*)(reinterpret_cast<const char*>(theMapped) - headerSize),
+			    headerSize + theNMapped*sizeof(Record));
+  if(theFd >= 0) close(theFd);
+
+}
+
+
+bool DTCalibHistory::open() {
+
+  theFd = ::open(theFileName.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if(theFd < 0) {
+    LogError("DTDQM|DTMonitorClient|DTCalibHistory") << "Cannot open the calibration history " << theFileName;
+    return false;
+  }
+
+  struct stat info;
+  fstat(theFd, &info);
+  uint32_t header[4];
+  if(info.st_size == 0) {
+    header[0] = fileMagic;
+    header[1] = fileVersion;
+    header[2] = sizeof(Record);
+    header[3] = 0;
+    if(write(theFd, header, headerSize) != headerSize) {
+      LogError("DTDQM|DTMonitorClient|DTCalibHistory") << "Cannot write the calibration history " << theFileName;
+      return false;
+    }
+    return true;
+  }
+
+  if(pread(theFd, header, headerSize, 0) != headerSize ||
+     header[0] != fileMagic || header[1] != fileVersion || header[2] != sizeof(Record)) {
+    LogError("DTDQM|DTMonitorClient|DTCalibHistory") << theFileName << " is not a calibration history of version " << fileVersion;
+    return false;
+  }
+
+  // a record truncated by a job that crashed is ignored
+  theNMapped = (info.st_size - headerSize)/sizeof(Record);
+  if(theNMapped != 0) {
+    void *address = mmap(0, headerSize + theNMapped*sizeof(Record), PROT_READ, MAP_SHARED, theFd, 0);
+    if(address == MAP_FAILED) {
+      LogError("DTDQM|DTMonitorClient|DTCalibHistory") << "Cannot map the calibration history " << theFileName;
+      theNMapped = 0;
+      return false;
+    }
+    theMapped = reinterpret_cast<const Record*>(static_cast<const char*>(address) + headerSize);
+  }
+  if(info.st_size != off_t(headerSize + theNMapped*sizeof(Record))) {
+    // realign the end of the file on a record
+    if(ftruncate(theFd, headerSize + theNMapped*sizeof(Record)) != 0) {
+      LogError("DTDQM|DTMonitorClient|DTCalibHistory") << "Cannot repair the calibration history " << theFileName;
+      return false;
+    }
+  }
+
+  for(uint32_t position = 0; position != theNMapped; ++position) index(position);
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTCalibHistory")
+    << "[DTCalibHistory]: " << theNMapped << " records of " << theRunIndex.size() << " runs in " << theFileName;
+  return true;
+
+}
+
+
+void DTCalibHistory::index(uint32_t position) {
+
+  const Record& newRecord = record(position);
+  theIndex[key(newRecord.element, newRecord.quantity)][newRecord.run] = position;
+  theRunIndex[newRecord.run]++;
+
+}
+
+
+void DTCalibHistory::append(const vector<Record>& records) {
+
+  if(records.empty()) return;
+
+  ssize_t size = records.size()*sizeof(Record);
+  if(write(theFd, &records[0], size) != size) {
+    LogError("DTDQM|DTMonitorClient|DTCalibHistory") << "Cannot append to the calibration history " << theFileName;
+    return;
+  }
+  for(vector<Record>::const_iterator newRecord = records.begin(); newRecord != records.end(); ++newRecord) {
+    theAppended.push_back(*newRecord);
+    index(theNMapped + theAppended.size() - 1);
+  }
+
+}
+
+
+void DTCalibHistory::lastRuns(uint32_t element, Quantity quantity, uint32_t beforeRun, int nRuns,
+			      vector<Record>& records) const {
+
+  records.clear();
+  map<uint64_t, map<uint32_t, uint32_t> >::const_iterator runs = theIndex.find(key(element, quantity));
+  if(runs == theIndex.end()) return;
+
+  map<uint32_t, uint32_t>::const_iterator run = (*runs).second.lower_bound(beforeRun);
+  while(run != (*runs).second.begin() && int(records.size()) < nRuns) {
+    --run;
+    records.push_back(record((*run).second));
+  }
+
+}
+
+
+bool DTCalibHistory::baseline(uint32_t element, Quantity quantity, uint32_t beforeRun, int nRuns, int minRuns,
+			      float& mean, float& rms) const {
+
+  vector<Record> records;
+  lastRuns(element, quantity, beforeRun, nRuns, records);
+  if(records.empty() || int(records.size()) < minRuns) return false;
+
+  double sum = 0.;
+  double sum2 = 0.;
+  for(vector<Record>::const_iterator previous = records.begin(); previous != records.end(); ++previous) {
+    sum += (*previous).value;
+    sum2 += (*previous).value*(*previous).value;
+  }
+  mean = sum/records.size();
+  rms = sqrt(max(sum2/records.size() - mean*mean, 0.));
+  return true;
+
+}
+
+
+const char* DTCalibHistory::quantityName(int quantity) {
+
+  static const char* names[] = { "unknown", "tTrig", "vDriftMean", "vDriftSigma", "t0Mean", "t0Sigma",
+				 "residualMean", "residualSigma", "fineDelay" };
+  return quantity >= TTrig && quantity <= FineDelay ? names[quantity] : names[0];
+
+}
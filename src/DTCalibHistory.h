@@ -0,0 +1,93 @@
+#ifndef DTCalibHistory_H
+#define DTCalibHistory_H
+
+/** \class DTCalibHistory
+ *  Append-only history of the calibration numbers computed by the clients
+ *  (tTrig, vDrift, t0, residuals, fine delays), kept across jobs in a local
+ *  file of fixed width records. The records already in the file are memory
+ *  mapped at the first access, the new ones are appended at the end; an
+ *  index (element, quantity) -> (run -> record) gives the last runs of an
+ *  element without scanning the file. When a run is processed again the
+ *  latest record wins. The store of a file is shared by all the clients
+ *  of the job (see get).
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+class DTCalibHistory {
+
+public:
+
+  /// The calibration numbers
+  enum Quantity { TTrig = 1, VDriftMean, VDriftSigma, T0Mean, T0Sigma,
+		  ResidualMean, ResidualSigma, FineDelay };
+
+  /// A record of the file
+  struct Record {
+    uint32_t run;
+    uint32_t element;   // DetId raw id of the SL or chamber
+    uint16_t quantity;
+    uint16_t flags;
+    float value;
+  };
+
+  /// The store of a file, opened at the first call (0 if the file cannot be used)
+  static DTCalibHistory* get(const std::string& fileName);
+
+  /// Append records to the file
+  void append(const std::vector<Record>& records);
+
+  /// Records of the last nRuns runs before beforeRun, most recent first
+  void lastRuns(uint32_t element, Quantity quantity, uint32_t beforeRun, int nRuns,
+		std::vector<Record>& records) const;
+
+  /// Mean and RMS of the last nRuns runs before beforeRun (false if less than minRuns runs)
+  bool baseline(uint32_t element, Quantity quantity, uint32_t beforeRun, int nRuns, int minRuns,
+		float& mean, float& rms) const;
+
+  /// The runs in the store
+  const std::map<uint32_t, int>& runs() const { return theRunIndex; };
+
+  /// Name of a quantity
+  static const char* quantityName(int quantity);
+
+  /// Destructor
+  ~DTCalibHistory();
+
+private:
+
+  DTCalibHistory(const std::string& fileName);
+
+  /// Map the records already in the file and build the index
+  bool open();
+
+  /// Record at a position of the store
+  const Record& record(uint32_t position) const {
+    return position < theNMapped ? theMapped[position] : theAppended[position-theNMapped];
+  };
+
+  /// Add a record to the index
+  void index(uint32_t position);
+
+  static uint64_t key(uint32_t element, int quantity) { return (uint64_t(element) << 16) | quantity; };
+
+  std::string theFileName;
+  int theFd;
+  const Record *theMapped;
+  uint32_t theNMapped;
+  std::vector<Record> theAppended;
+
+  // (element, quantity) -> run -> position of the latest record
+  std::map<uint64_t, std::map<uint32_t, uint32_t> > theIndex;
+  // run -> # of records
+  std::map<uint32_t, int> theRunIndex;
+
+};
+
+#endif
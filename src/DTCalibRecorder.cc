@@ -0,0 +1,83 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTCalibRecorder.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <vector>
+#include <math.h>
+
+using namespace std;
+using namespace edm;
+
+
+DTCalibRecorder::DTCalibRecorder(const ParameterSet& ps, const string& clientName) :
+  theClientName(clientName), theHistory(0) {
+
+  string fileName = ps.getUntrackedParameter<string>("calibHistoryFile", "");
+  // baseline: the last regressionRuns runs, at least minBaselineRuns
+  theRegressionRuns = ps.getUntrackedParameter<int>("regressionRuns", 10);
+  theMinBaselineRuns = ps.getUntrackedParameter<int>("minBaselineRuns", 3);
+  theRegressionSigmas = ps.getUntrackedParameter<double>("regressionSigmas", 3.);
+  theMinRelativeSpread = ps.getUntrackedParameter<double>("minRelativeSpread", 0.02);
+
+  if(!fileName.empty()) theHistory = DTCalibHistory::get(fileName);
+
+}
+
+
+void DTCalibRecorder::set(uint32_t element, DTCalibHistory::Quantity quantity, float value) {
+
+  if(theHistory == 0) return;
+  thePending[make_pair(element, int(quantity))] = value;
+
+}
+
+
+int DTCalibRecorder::commit(uint32_t run) {
+
+  if(theHistory == 0 || thePending.empty()) return 0;
+
+  int nRegressions = 0;
+  vector<DTCalibHistory::Record> records;
+  records.reserve(thePending.size());
+  for(map<pair<uint32_t, int>, float>::const_iterator pending = thePending.begin();
+      pending != thePending.end(); ++pending) {
+    DTCalibHistory::Record newRecord;
+    newRecord.run = run;
+    newRecord.element = (*pending).first.first;
+    newRecord.quantity = (*pending).first.second;
+    newRecord.flags = 0;
+    newRecord.value = (*pending).second;
+
+    float mean, rms;
+    if(theHistory->baseline(newRecord.element, DTCalibHistory::Quantity(newRecord.quantity), run,
+			    theRegressionRuns, theMinBaselineRuns, mean, rms)) {
+      double spread = max(double(rms), theMinRelativeSpread*fabs(mean));
+      if(spread > 0 && fabs(newRecord.value - mean) > theRegressionSigmas*spread) {
+	// flagged in the history, so that the regressions can be found later
+	newRecord.flags = 1;
+	++nRegressions;
+	LogWarning("DTDQM|DTMonitorClient|" + theClientName)
+	  << "[" << theClientName << "]: " << DTCalibHistory::quantityName(newRecord.quantity)
+	  << " of element " << newRecord.element << " in run " << run << " is " << newRecord.value
+	  << ", baseline of the last runs " << mean << " +- " << rms;
+      }
+    }
+    records.push_back(newRecord);
+  }
+  theHistory->append(records);
+  thePending.clear();
+
+  LogVerbatim("DTDQM|DTMonitorClient|" + theClientName)
+    << "[" << theClientName << "]: " << records.size() << " calibration numbers of run " << run
+    << " added to the history, " << nRegressions << " regressions";
+  return nRegressions;
+
+}
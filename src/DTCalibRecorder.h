@@ -0,0 +1,57 @@
+#ifndef DTCalibRecorder_H
+#define DTCalibRecorder_H
+
+/** \class DTCalibRecorder
+ *  Client side of the calibration history (see DTCalibHistory): the client
+ *  sets the numbers computed in the run, at the end of the run they are
+ *  compared with the baseline of the previous runs and appended to the
+ *  history. A number farther than regressionSigmas RMS from the mean of the
+ *  last regressionRuns runs is reported as a regression (the RMS is taken
+ *  at least minRelativeSpread of the mean, to cope with stable numbers).
+ *  Disabled if no calibHistoryFile is configured.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTCalibHistory.h"
+
+#include <string>
+#include <map>
+
+namespace edm {
+  class ParameterSet;
+}
+
+class DTCalibRecorder {
+
+public:
+
+  /// Constructor
+  DTCalibRecorder(const edm::ParameterSet& ps, const std::string& clientName);
+
+  /// Is the history enabled?
+  bool enabled() const { return theHistory != 0; };
+
+  /// Set the value of a calibration number in the current run
+  void set(uint32_t element, DTCalibHistory::Quantity quantity, float value);
+
+  /// Check the numbers of the run against the baseline and append them to the history.
+  /// Return the # of regressions
+  int commit(uint32_t run);
+
+private:
+
+  std::string theClientName;
+  DTCalibHistory *theHistory;
+  int theRegressionRuns;
+  int theMinBaselineRuns;
+  double theRegressionSigmas;
+  double theMinRelativeSpread;
+
+  // (element, quantity) -> value
+  std::map<std::pair<uint32_t, int>, float> thePending;
+
+};
+
+#endif
@@ -9,6 +9,7 @@
 
 
 #include "DQM/DTMonitorClient/src/DTCertificationSummary.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 #include "DataFormats/FEDRawData/interface/FEDNumbering.h"
 
 #include "FWCore/ServiceRegistry/interface/Service.h"
@@ -19,12 +20,19 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <algorithm>
+#include <sstream>
+
 using namespace std;
 using namespace edm;
 
 
 
-DTCertificationSummary::DTCertificationSummary(const ParameterSet& pset) {}
+DTCertificationSummary::DTCertificationSummary(const ParameterSet& pset) : theSectorCert(60,0.) {
+
+  byLumi = pset.getUntrackedParameter<bool>("byLumiCertification",true);
+
+}
 
 
 
@@ -70,37 +78,121 @@ void DTCertificationSummary::beginLuminosityBlock(const LuminosityBlock& lumi, c
 
 
 void DTCertificationSummary::beginRun(const Run& run, const  EventSetup& setup) {
+
+  theLumis.clear();
+  theLumiWheelHV.clear();
+  theLumiWheelCert.clear();
+
 }
 
 
 
 
 void DTCertificationSummary::endLuminosityBlock(const LuminosityBlock&  lumi, const  EventSetup& setup){
+  DTClientPerformance::Timer timer("DTCertificationSummary", DTClientPerformance::EndLumi);
+
+  if(!byLumi) return;
+
+  // the quality summaries are filled only at end of run: what changes LS by LS
+  // is the fraction of HV ON of each wheel, filled by DTDCSByLumiSummary
+  vector<float> wheelHV(5,-1.);
+  for(int wheel = -2; wheel != 3; ++wheel) {
+    stringstream hvName; hvName << "DT/EventInfo/DCSContents/DT_Wheel" << wheel;
+    MonitorElement* hvFraction = theDbe->get(hvName.str());
+    if(hvFraction == 0) return;
+    wheelHV[wheel+2] = hvFraction->getFloatValue();
+  }
+
+  // store the HV fractions of this LS (overwritten if already there)
+  int lumiNumber = lumi.id().luminosityBlock();
+  int row = lumiRow(lumiNumber);
+  if(row < 0) {
+    vector<int>::iterator pos = lower_bound(theLumis.begin(),theLumis.end(),lumiNumber);
+    row = pos - theLumis.begin();
+    theLumis.insert(pos,lumiNumber);
+    theLumiWheelHV.insert(theLumiWheelHV.begin()+row*5,5,-1.);
+  }
+  copy(wheelHV.begin(),wheelHV.end(),theLumiWheelHV.begin()+row*5);
+
 }
 
 
 
 void DTCertificationSummary::endRun(const Run& run, const  EventSetup& setup){
-  // get the relevant summary histos
-  MonitorElement* effSummary = theDbe->get("DT/05-ChamberEff/EfficiencyGlbSummary");
-  MonitorElement* resSummary = theDbe->get("DT/02-Segments/ResidualsGlbSummary");
-  MonitorElement* segQualSummary = theDbe->get("DT/02-Segments/segmentSummary");
+  DTClientPerformance::Timer timer("DTCertificationSummary", DTClientPerformance::EndRun);
 
   // check that all needed histos are there
-  if(effSummary == 0 || resSummary == 0 || segQualSummary == 0) {
+  if(!computeSectorCertification(theSectorCert)) {
     LogWarning("DQM|DTMonitorClient|DTCertificationSummary") << "*** Warning: not all needed summaries are present!" << endl;
     return;
   }
 
-  // reset the MEs
-  totalCertFraction->Fill(0.);
-  certFractions[-2]->Fill(0.);
-  certFractions[-1]->Fill(0.);
-  certFractions[-0]->Fill(0.);
-  certFractions[1]->Fill(0.);
-  certFractions[2]->Fill(0.);
   certMap->Reset();
 
+  // accumulate the fractions with the sector weights and write each ME once
+  vector<double> wheelQuality(5,0.);
+  double totalCert = 0.;
+  for(int wheel = -2; wheel != 3; ++wheel) {
+    for(int sector = 1; sector != 13; ++sector) {
+      double total = theSectorCert[(wheel+2)*12 + sector-1];
+      certMap->Fill(sector,wheel,total);      
+      // can use variable weight depending on the sector
+      double weight = 1./12.;
+      wheelQuality[wheel+2] += weight*total;
+      double totalWeight = 1./60.;
+      totalCert += totalWeight*total;
+    }
+    certFractions[wheel]->Fill(wheelQuality[wheel+2]);
+  }
+  totalCertFraction->Fill(totalCert);
+
+  // certification of each LS: run quality x HV fraction of the LS (-1 if no HV information),
+  // only in the by-lumi query and ME, the run fractions above are the quality alone
+  int nLumis = theLumis.size();
+  theLumiWheelCert.assign(nLumis*5,-1.);
+  for(int row = 0; row != nLumis; ++row) {
+    for(int iWh = 0; iWh != 5; ++iWh) {
+      float hv = theLumiWheelHV[row*5 + iWh];
+      if(hv >= 0.) theLumiWheelCert[row*5 + iWh] = wheelQuality[iWh]*hv;
+    }
+  }
+
+  // by-lumi certification (LS x wheel)
+  if(byLumi && nLumis != 0) {
+    theDbe->setCurrentFolder("DT/EventInfo");
+    // the # of LS changes from run to run: book it again
+    if(theDbe->get("DT/EventInfo/CertificationSummaryByLumi") != 0) {
+      theDbe->removeElement("CertificationSummaryByLumi");
+    }
+    MonitorElement* certByLumi = theDbe->book2D("CertificationSummaryByLumi","DT Certification by LS",
+						nLumis,0,nLumis,5,-2,3);
+    certByLumi->setAxisTitle("LS",1);
+    certByLumi->setAxisTitle("wheel",2);
+    for(int row = 0; row != nLumis; ++row) {
+      stringstream lumiLabel;
+      lumiLabel << theLumis[row];
+      certByLumi->setBinLabel(row+1,lumiLabel.str(),1);
+      for(int wheel = -2; wheel != 3; ++wheel) {
+	certByLumi->setBinContent(row+1,wheel+3,theLumiWheelCert[row*5 + wheel+2]);
+      }
+    }
+  }
+
+}
+
+
+
+bool DTCertificationSummary::computeSectorCertification(vector<float>& sectorCert) const {
+
+  // get the relevant summary histos
+  MonitorElement* effSummary = theDbe->get("DT/05-ChamberEff/EfficiencyGlbSummary");
+  MonitorElement* resSummary = theDbe->get("DT/02-Segments/ResidualsGlbSummary");
+  MonitorElement* segQualSummary = theDbe->get("DT/02-Segments/segmentSummary");
+
+  if(effSummary == 0 || resSummary == 0 || segQualSummary == 0) {
+    return false;
+  }
+
   // loop over all sectors and wheels
   for(int wheel = -2; wheel != 3; ++wheel) {
     for(int sector = 1; sector != 13; ++sector) {
@@ -114,16 +206,50 @@ void DTCertificationSummary::endRun(const Run& run, const  EventSetup& setup){
       } else {
 	total = eff;
       }
-      
-      certMap->Fill(sector,wheel,total);      
-      // can use variable weight depending on the sector
-      double weight = 1./12.;
-      certFractions[wheel]->Fill(certFractions[wheel]->getFloatValue() + weight*total);
-      double totalWeight = 1./60.;
-      totalCertFraction->Fill(totalCertFraction->getFloatValue() + totalWeight*total);
+      sectorCert[(wheel+2)*12 + sector-1] = total;
     }
   }
 
+  return true;
+
+}
+
+
+
+int DTCertificationSummary::lumiRow(int lumi) const {
+
+  vector<int>::const_iterator pos = lower_bound(theLumis.begin(),theLumis.end(),lumi);
+  if(pos == theLumis.end() || (*pos) != lumi) return -1;
+  return pos - theLumis.begin();
+
+}
+
+
+
+bool DTCertificationSummary::lumiCertification(int lumi, int wheel, float& certification) const {
+
+  int row = lumiRow(lumi);
+  if(row < 0 || wheel < -2 || wheel > 2 || row*5 >= int(theLumiWheelCert.size())) return false;
+  certification = theLumiWheelCert[row*5 + wheel+2];
+  // no HV information for this LS
+  return certification >= 0.;
+
+}
+
+
+
+bool DTCertificationSummary::lumiCertification(int lumi, float& certification) const {
+
+  int row = lumiRow(lumi);
+  if(row < 0 || row*5 >= int(theLumiWheelCert.size())) return false;
+  // same weights as the run fraction: 1/60 per sector -> 1/5 per wheel,
+  // a wheel without HV information counts as not certified
+  certification = 0.;
+  for(int iWh = 0; iWh != 5; ++iWh) {
+    certification += max(theLumiWheelCert[row*5 + iWh],0.f)/5.;
+  }
+  return true;
+
 }
 
 
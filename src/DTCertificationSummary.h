@@ -13,6 +13,7 @@
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 
 #include <map>
+#include <vector>
 
 class DQMStore;
 class MonitorElement;
@@ -27,6 +28,14 @@ public:
 
   // Operations
 
+  /// Certification of a wheel in a given LS, available after endRun
+  /// (false if the LS was not certified or has no HV information)
+  bool lumiCertification(int lumi, int wheel, float& certification) const;
+
+  /// Certification of the whole barrel in a given LS, available after endRun
+  /// (false if the LS was not certified)
+  bool lumiCertification(int lumi, float& certification) const;
+
 protected:
   
 private:
@@ -38,7 +47,19 @@ private:
   virtual void endRun(const edm::Run& run, const  edm::EventSetup& setup);
   virtual void endJob() ;
   
+  /// Compute the certification of each sector from the summaries, false if some are missing
+  bool computeSectorCertification(std::vector<float>& sectorCert) const;
+
+  /// Row of a LS in the by-lumi store (-1 if not there)
+  int lumiRow(int lumi) const;
+
   DQMStore *theDbe;  
+
+  bool byLumi;
+  std::vector<float> theSectorCert;    // [(wheel+2)*12 + sector-1]
+  std::vector<int>   theLumis;         // certified LS, ordered
+  std::vector<float> theLumiWheelHV;   // [row*5 + wheel+2], HV ON fraction
+  std::vector<float> theLumiWheelCert; // [row*5 + wheel+2], filled at endRun
   
   MonitorElement*  totalCertFraction;
   MonitorElement*  certMap;
@@ -7,6 +7,7 @@
  */
 
 #include <DQM/DTMonitorClient/src/DTChamberEfficiencyClient.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 #include <DQMServices/Core/interface/MonitorElement.h>
 #include <DQMServices/Core/interface/DQMStore.h>
 
@@ -85,6 +86,8 @@ void DTChamberEfficiencyClient::analyze(const Event& e, const EventSetup& contex
 
 void DTChamberEfficiencyClient::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context)
 {
+  DTClientPerformance::Timer timer("DTChamberEfficiencyClient", DTClientPerformance::EndLumi);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyClient")
     << "DTChamberEfficiencyClient: endluminosityBlock";
 }  
@@ -92,6 +95,8 @@ void DTChamberEfficiencyClient::endLuminosityBlock(LuminosityBlock const& lumiSe
 
 void DTChamberEfficiencyClient::endRun(Run const& run, EventSetup const& context)
 {
+  DTClientPerformance::Timer timer("DTChamberEfficiencyClient", DTClientPerformance::EndRun);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyClient")
     << "DTChamberEfficiencyClient: endRun";
   // reset the global summary
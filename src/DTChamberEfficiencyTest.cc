@@ -10,6 +10,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTChamberEfficiencyTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "DQMServices/Core/interface/DQMStore.h"
 
@@ -33,7 +34,8 @@ using namespace std;
 
 
 
-DTChamberEfficiencyTest::DTChamberEfficiencyTest(const edm::ParameterSet& ps){
+DTChamberEfficiencyTest::DTChamberEfficiencyTest(const edm::ParameterSet& ps) :
+  badChannelCollector(ps,"DTChamberEfficiencyTest","DTDQM|DTMonitorClient|DTChamberEfficiencyTest") {
 
   edm::LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "[DTChamberEfficiencyTest]: Constructor";
 
@@ -43,6 +45,14 @@ DTChamberEfficiencyTest::DTChamberEfficiencyTest(const edm::ParameterSet& ps){
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 1);
 
+  // keep the X vs Y efficiencies sparse, the MEs are booked only for the chambers with data
+  sparseStorage = parameters.getUntrackedParameter<bool>("sparseStorage", true);
+  // export the sparse X vs Y efficiencies at each diagnostic or only at end of run (default)
+  exportByLumi = parameters.getUntrackedParameter<bool>("exportByLumi", false);
+
+  xEfficiencyTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("XEfficiencyTestName","ChEfficiencyInRangeX"));
+  yEfficiencyTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("YEfficiencyTestName","ChEfficiencyInRangeY"));
+
 }
 
 
@@ -60,6 +70,8 @@ void DTChamberEfficiencyTest::beginJob(){
 
   nevents = 0;
 
+  badChannelCollector.bookHistos(dbe,"DT/01-DTChamberEfficiency");
+
 }
 
 
@@ -99,6 +111,7 @@ void DTChamberEfficiencyTest::analyze(const edm::Event& e, const edm::EventSetup
 
 
 void DTChamberEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTChamberEfficiencyTest", DTClientPerformance::EndLumi);
   
   // counts number of updats (online mode) or number of events (standalone mode)
   //nevents++;
@@ -123,6 +136,8 @@ void DTChamberEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 
   edm::LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "[DTChamberEfficiencyTest]: ChamberEfficiency tests results"; 
   
+  badChannelCollector.beginCollection(nLumiSegs);
+
   // Loop over the chambers
   for (; ch_it != ch_end; ++ch_it) {
     DTChamberId chID = (*ch_it)->id();
@@ -159,7 +174,8 @@ void DTChamberEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 	for(int yBin=1; yBin<=lastBinY; yBin++) {
 	  if(GoodSegDen_histo_root->GetBinContent(xBin, yBin)!=0){
 	    float XvsYefficiency = GoodCloseSegNum_histo_root->GetBinContent(xBin, yBin) / GoodSegDen_histo_root->GetBinContent(xBin, yBin);
-	    xVSyEffHistos.find(HistoName)->second->setBinContent(xBin, yBin, XvsYefficiency);
+	    if(sparseStorage) xVSyEffSparse[chID.rawId()].setBinContent(xBin, yBin, XvsYefficiency);
+	    else xVSyEffHistos.find(HistoName)->second->setBinContent(xBin, yBin, XvsYefficiency);
 	  }
 	}
 	    
@@ -172,44 +188,22 @@ void DTChamberEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 	}
       }
     }
-  } // loop on chambers
-  
-  
-  // ChamberEfficiency test on X axis
-  string XEfficiencyCriterionName = parameters.getUntrackedParameter<string>("XEfficiencyTestName","ChEfficiencyInRangeX"); 
-  for(map<string, MonitorElement*>::const_iterator hXEff = xEfficiencyHistos.begin();
-      hXEff != xEfficiencyHistos.end();
-      hXEff++) {
-    const QReport * theXEfficiencyQReport = (*hXEff).second->getQReport(XEfficiencyCriterionName);
-    if(theXEfficiencyQReport) {
-      vector<dqm::me_util::Channel> badChannels = theXEfficiencyQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	edm::LogError ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "Chamber : " << (*hXEff).first << " Bad XChamberEfficiency channels: "<<(*channel).getBin()<<"  Contents : "<<(*channel).getContents();
-      }
-      // FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-      // edm::LogWarning ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "-------- Chamber : "<<(*hXEff).first<<"  "<<theXEfficiencyQReport->getMessage()<<" ------- "<<theXEfficiencyQReport->getStatus();
-    }
-  }
 
+    // ChamberEfficiency tests on X and Y axis
+    map<string, MonitorElement*>::const_iterator hXEff = xEfficiencyHistos.find(HistoName);
+    if(hXEff != xEfficiencyHistos.end())
+      badChannelCollector.collect((*hXEff).second,xEfficiencyTest,chID.rawId());
+    map<string, MonitorElement*>::const_iterator hYEff = yEfficiencyHistos.find(HistoName);
+    if(hYEff != yEfficiencyHistos.end())
+      badChannelCollector.collect((*hYEff).second,yEfficiencyTest,chID.rawId());
 
-  // ChamberEfficiency test on Y axis
-  string YEfficiencyCriterionName = parameters.getUntrackedParameter<string>("YEfficiencyTestName","ChEfficiencyInRangeY"); 
-  for(map<string, MonitorElement*>::const_iterator hYEff = yEfficiencyHistos.begin();
-      hYEff != yEfficiencyHistos.end();
-      hYEff++) {
-    const QReport * theYEfficiencyQReport = (*hYEff).second->getQReport(YEfficiencyCriterionName);
-    if(theYEfficiencyQReport) {
-      vector<dqm::me_util::Channel> badChannels = theYEfficiencyQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	edm::LogError ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "Chamber : " << (*hYEff).first <<" Bad YChamberEfficiency channels: "<<(*channel).getBin()<<"  Contents : "<<(*channel).getContents();
-      }
-      // FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-      // edm::LogWarning ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "-------- Chamber : "<<(*hYEff).first<<"  "<<theYEfficiencyQReport->getMessage()<<" ------- "<<theYEfficiencyQReport->getStatus();
-    }
-  }
+  } // loop on chambers
 
+  badChannelCollector.endCollection();
+
+  if(sparseStorage && exportByLumi) exportSparseHistos();
+  
+  
   //Fill the report summary histos
   for(int wh=-2; wh<=2; wh++){
     for(int sec=1; sec<=12; sec++){
@@ -225,10 +219,66 @@ void DTChamberEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 
 
 
+void DTChamberEfficiencyTest::endRun(const edm::Run& run, const edm::EventSetup& setup){
+
+  if(sparseStorage) exportSparseHistos();
+
+}
+
+
+
+void DTChamberEfficiencyTest::exportSparseHistos() {
+
+  // only the chambers with at least one efficiency get a dense ME
+  for(map<uint32_t, DTSparseHisto>::const_iterator histo = xVSyEffSparse.begin();
+      histo != xVSyEffSparse.end(); ++histo) {
+    DTChamberId chId((*histo).first);
+    stringstream wheel; wheel << chId.wheel();
+    stringstream station; station << chId.station();
+    stringstream sector; sector << chId.sector();
+    string HistoName = "W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
+    MonitorElement *me = xVSyEffHistos[HistoName];
+    if((*histo).second.nFilled() == 0) {
+      // booked in a previous run: clear it
+      if(me != 0) me->Reset();
+      continue;
+    }
+    if(me == 0) {
+      string xVSyEffHistoName =  "xVSyEff_" + HistoName;
+      dbe->setCurrentFolder("DT/01-DTChamberEfficiency/Wheel" + wheel.str() +
+			    "/Sector" + sector.str() +
+			    "/Station" + station.str());
+      me = dbe->book2D(xVSyEffHistoName.c_str(),xVSyEffHistoName.c_str(),25,-250.,250., 25,-250.,250.);
+      xVSyEffHistos[HistoName] = me;
+    }
+    (*histo).second.exportTo(me);
+  }
+
+}
+
+
+
 void DTChamberEfficiencyTest::endJob(){
 
   edm::LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest") << "[DTChamberEfficiencyTest] endjob called!";
 
+  if(sparseStorage) {
+    // estimated memory of the X vs Y efficiencies from the bin storage: sparse vs the dense MEs of the eager booking
+    long sparseBytes = 0;
+    long denseBytes = 0;
+    int nFilled = 0;
+    for(map<uint32_t, DTSparseHisto>::const_iterator histo = xVSyEffSparse.begin();
+	histo != xVSyEffSparse.end(); ++histo) {
+      sparseBytes += (*histo).second.bytes();
+      denseBytes += (*histo).second.denseBytes();
+      nFilled += (*histo).second.nFilled();
+    }
+    edm::LogVerbatim ("DTDQM|DTMonitorClient|DTChamberEfficiencyTest")
+      << "[DTChamberEfficiencyTest] X vs Y efficiencies: " << xVSyEffSparse.size() << " chambers, "
+      << nFilled << " filled bins, estimated " << sparseBytes/1024. << " kB sparse vs "
+      << denseBytes/1024. << " kB dense";
+  }
+
 }
 
 
@@ -273,7 +323,12 @@ void DTChamberEfficiencyTest::bookHistos(const DTChamberId & chId) {
 
   xEfficiencyHistos[HistoName] = dbe->book1D(xEfficiencyHistoName.c_str(),xEfficiencyHistoName.c_str(),25,-250.,250.);
   yEfficiencyHistos[HistoName] = dbe->book1D(yEfficiencyHistoName.c_str(),yEfficiencyHistoName.c_str(),25,-250.,250.);
-  xVSyEffHistos[HistoName] = dbe->book2D(xVSyEffHistoName.c_str(),xVSyEffHistoName.c_str(),25,-250.,250., 25,-250.,250.);
+  if(sparseStorage) {
+    // the ME, if any, is kept from the previous run and rewritten at its end
+    xVSyEffSparse[chId.rawId()] = DTSparseHisto(25, 25);
+    if(xVSyEffHistos.find(HistoName) == xVSyEffHistos.end()) xVSyEffHistos[HistoName] = 0;
+  } else
+    xVSyEffHistos[HistoName] = dbe->book2D(xVSyEffHistoName.c_str(),xVSyEffHistoName.c_str(),25,-250.,250., 25,-250.,250.);
 
 }
 
@@ -26,6 +26,9 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+#include "DQM/DTMonitorClient/src/DTSparseHisto.h"
+
 
 #include <memory>
 #include <iostream>
@@ -60,9 +63,15 @@ protected:
   /// Analyze
   void analyze(const edm::Event& e, const edm::EventSetup& c);
 
+  /// EndRun: export the sparse X vs Y efficiencies to the MEs
+  void endRun(const edm::Run& run, const edm::EventSetup& setup);
+
   /// Endjob
   void endJob();
 
+  /// Write the sparse X vs Y efficiencies to their MEs (booked at the first export)
+  void exportSparseHistos();
+
   /// book the new ME
   void bookHistos(const DTChamberId & ch);
 
@@ -96,8 +105,16 @@ private:
   std::map< std::string , MonitorElement* > xEfficiencyHistos;
   std::map< std::string , MonitorElement* > yEfficiencyHistos;
   std::map< std::string , MonitorElement* > xVSyEffHistos;
+  // X vs Y efficiencies kept sparse during the run (sparseStorage mode)
+  std::map< uint32_t , DTSparseHisto > xVSyEffSparse;
+  bool sparseStorage;
+  bool exportByLumi;
   std::map< int, MonitorElement* > summaryHistos;
 
+  DTBadChannelCollector badChannelCollector;
+  int xEfficiencyTest;
+  int yEfficiencyTest;
+
 };
 
 #endif
@@ -0,0 +1,103 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+
+#include <malloc.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <time.h>
+
+using namespace std;
+
+
+DTClientPerformance::Timer::Timer(const string& client, Method method) :
+  theActive(DTClientPerformance::instance().enabled()), theMethod(method) {
+
+  if(!theActive) return;
+  theClient = client;
+  theHeap = heapInUse();
+  theCpuTime = cpuTime();
+  theWallTime = wallTime();
+
+}
+
+
+DTClientPerformance::Timer::~Timer() {
+
+  if(!theActive) return;
+  double wall = wallTime() - theWallTime;
+  double cpu = cpuTime() - theCpuTime;
+  long heap = heapInUse() - theHeap;
+  DTClientPerformance::instance().add(theClient, theMethod, wall, cpu, heap);
+
+}
+
+
+DTClientPerformance& DTClientPerformance::instance() {
+
+  static DTClientPerformance performance;
+  return performance;
+
+}
+
+
+void DTClientPerformance::add(const string& client, Method method,
+			      double wallTime, double cpuTime, long heapGrowth) {
+
+  string key = client + ":" + methodName(method);
+  Measurement* records[2] = { &theCurrent[key], &theTotal[key] };
+  for(int iRecord = 0; iRecord != 2; ++iRecord) {
+    records[iRecord]->wallTime += wallTime;
+    records[iRecord]->cpuTime += cpuTime;
+    records[iRecord]->heapGrowth += heapGrowth;
+    records[iRecord]->calls++;
+  }
+
+}
+
+
+const char* DTClientPerformance::methodName(Method method) {
+
+  static const char* names[nMethods] = { "endLuminosityBlock", "endRun", "diagnostic", "booking" };
+  return names[method];
+
+}
+
+
+double DTClientPerformance::wallTime() {
+
+  timeval now;
+  gettimeofday(&now, 0);
+  return now.tv_sec + now.tv_usec*1e-6;
+
+}
+
+
+double DTClientPerformance::cpuTime() {
+
+  return double(clock())/CLOCKS_PER_SEC;
+
+}
+
+
+long DTClientPerformance::heapInUse() {
+
+  // allocated chunks plus the mmapped ones (large blocks)
+  struct mallinfo info = mallinfo();
+  return long(info.uordblks) + long(info.hblkhd);
+
+}
+
+
+long DTClientPerformance::maxRSS() {
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+
+}
@@ -0,0 +1,93 @@
+#ifndef DTClientPerformance_H
+#define DTClientPerformance_H
+
+/** \class DTClientPerformance
+ *  Job wide bookkeeping of the resources used by the DT clients.
+ *  A DTClientPerformance::Timer placed at the top of a client method
+ *  measures the wall time, the CPU time and the heap growth of the call
+ *  and adds them to the record of that client and method. The records
+ *  are kept both for the current LS and for the whole job; they are
+ *  published and reset by DTClientPerformanceMonitor, which also enables
+ *  the measurement: without it the timers do nothing.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <string>
+#include <map>
+
+class DTClientPerformance {
+
+public:
+
+  /// The instrumented client methods
+  enum Method { EndLumi = 0, EndRun, Diagnostic, Booking, nMethods };
+
+  /// Resources used by a client method
+  struct Measurement {
+    Measurement() : wallTime(0.), cpuTime(0.), heapGrowth(0), calls(0) {};
+    double wallTime;
+    double cpuTime;
+    long heapGrowth;
+    int calls;
+  };
+
+  /// Record key ("client:method") -> measurement
+  typedef std::map<std::string, Measurement> Records;
+
+  /// Scoped measurement of a client method
+  class Timer {
+  public:
+    Timer(const std::string& client, Method method);
+    ~Timer();
+  private:
+    bool theActive;
+    std::string theClient;
+    Method theMethod;
+    double theWallTime;
+    double theCpuTime;
+    long theHeap;
+  };
+
+  /// The job wide instance
+  static DTClientPerformance& instance();
+
+  /// Switch the measurement on/off
+  void enable(bool flag) { theEnabled = flag; };
+  bool enabled() const { return theEnabled; };
+
+  /// Add a measurement to the records of the current LS and of the job
+  void add(const std::string& client, Method method, double wallTime, double cpuTime, long heapGrowth);
+
+  /// Records since the last call to resetCurrent
+  const Records& current() const { return theCurrent; };
+
+  /// Records of the whole job
+  const Records& total() const { return theTotal; };
+
+  /// Start a new LS
+  void resetCurrent() { theCurrent.clear(); };
+
+  /// Name of the method used in the record keys
+  static const char* methodName(Method method);
+
+  /// Current wall time, CPU time (s) and heap in use (bytes)
+  static double wallTime();
+  static double cpuTime();
+  static long heapInUse();
+
+  /// High-water mark of the resident memory of the process (kB)
+  static long maxRSS();
+
+private:
+
+  DTClientPerformance() : theEnabled(false) {};
+
+  bool theEnabled;
+  Records theCurrent;
+  Records theTotal;
+
+};
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+#include "DQM/DTMonitorClient/src/DTClientPerformanceMonitor.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+
+
+using namespace std;
+using namespace edm;
+
+namespace {
+  // max # of client methods in the MEs
+  const int maxRecords = 64;
+
+  typedef pair<string, DTClientPerformance::Measurement> ClientRecord;
+  bool slowerThan(const ClientRecord& first, const ClientRecord& second) {
+    return first.second.wallTime > second.second.wallTime;
+  }
+}
+
+
+DTClientPerformanceMonitor::DTClientPerformanceMonitor(const ParameterSet& pset) {
+
+  // if not empty, one JSON line per client method and LS
+  theJsonFileName = pset.getUntrackedParameter<string>("jsonFile", "");
+
+  // the clients are constructed before any transition: their timers are active from the start
+  DTClientPerformance::instance().enable(true);
+
+}
+
+
+
+
+DTClientPerformanceMonitor::~DTClientPerformanceMonitor() {}
+
+
+
+void DTClientPerformanceMonitor::beginJob(){
+  // get the DQMStore
+  theDbe = Service<DQMStore>().operator->();
+
+  // book the MEs
+  theDbe->setCurrentFolder("DT/EventInfo/ClientPerformance");
+  wallTimeME = theDbe->book1D("WallTime","Wall time (s) per client method in the last LS",maxRecords,0.5,maxRecords+0.5);
+  cpuTimeME = theDbe->book1D("CpuTime","CPU time (s) per client method in the last LS",maxRecords,0.5,maxRecords+0.5);
+  heapGrowthME = theDbe->book1D("HeapGrowth","Heap growth (bytes) per client method in the last LS",maxRecords,0.5,maxRecords+0.5);
+  callsME = theDbe->book1D("Calls","Calls per client method in the last LS",maxRecords,0.5,maxRecords+0.5);
+
+  if(!theJsonFileName.empty()) {
+    theJsonFile.open(theJsonFileName.c_str(), ios::app);
+    if(!theJsonFile) {
+      LogError("DTDQM|DTMonitorClient|DTClientPerformanceMonitor")
+	<< "Cannot open " << theJsonFileName << ", JSON output disabled";
+    }
+  }
+
+}
+
+
+
+void DTClientPerformanceMonitor::analyze(const Event& event, const EventSetup& setup){}
+
+
+
+void DTClientPerformanceMonitor::endLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup){
+
+  publish(lumi.run(), lumi.luminosityBlock());
+
+}
+
+
+
+void DTClientPerformanceMonitor::endRun(const Run& run, const  EventSetup& setup){
+
+  // the endRun records are published with LS = 0
+  publish(run.run(), 0);
+
+}
+
+
+
+void DTClientPerformanceMonitor::endJob() {
+
+  const DTClientPerformance::Records& total = DTClientPerformance::instance().total();
+  vector<ClientRecord> records(total.begin(), total.end());
+  sort(records.begin(), records.end(), slowerThan);
+
+  LogVerbatim summary("DTDQM|DTMonitorClient|DTClientPerformanceMonitor");
+  summary << "DT client performance summary (sorted by wall time):\n";
+  char line[256];
+  sprintf(line, "%-55s %8s %10s %10s %12s\n", "client:method", "calls", "wall (s)", "cpu (s)", "heap (kB)");
+  summary << line;
+  for(vector<ClientRecord>::const_iterator record = records.begin(); record != records.end(); ++record) {
+    sprintf(line, "%-55s %8d %10.3f %10.3f %12ld\n", record->first.c_str(), record->second.calls,
+	    record->second.wallTime, record->second.cpuTime, record->second.heapGrowth/1024);
+    summary << line;
+  }
+  summary << "peak resident memory: " << DTClientPerformance::maxRSS()/1024 << " MB";
+
+  if(theJsonFile.is_open()) theJsonFile.close();
+
+}
+
+
+
+void DTClientPerformanceMonitor::publish(int run, int lumi) {
+
+  DTClientPerformance& performance = DTClientPerformance::instance();
+  const DTClientPerformance::Records& current = performance.current();
+  if(current.empty()) return;
+
+  wallTimeME->Reset();
+  cpuTimeME->Reset();
+  heapGrowthME->Reset();
+  callsME->Reset();
+
+  for(DTClientPerformance::Records::const_iterator record = current.begin();
+      record != current.end(); ++record) {
+    const DTClientPerformance::Measurement& measurement = record->second;
+    int recordBin = bin(record->first);
+    if(recordBin != 0) {
+      wallTimeME->setBinContent(recordBin, measurement.wallTime);
+      cpuTimeME->setBinContent(recordBin, measurement.cpuTime);
+      heapGrowthME->setBinContent(recordBin, measurement.heapGrowth);
+      callsME->setBinContent(recordBin, measurement.calls);
+    }
+    if(theJsonFile.is_open()) {
+      string::size_type colon = record->first.find(':');
+      char line[512];
+      sprintf(line, "{\"run\": %d, \"lumi\": %d, \"client\": \"%s\", \"method\": \"%s\", "
+	      "\"wallTime\": %.6f, \"cpuTime\": %.6f, \"heapGrowth\": %ld, \"calls\": %d, \"maxRSS\": %ld}\n",
+	      run, lumi, record->first.substr(0, colon).c_str(), record->first.substr(colon+1).c_str(),
+	      measurement.wallTime, measurement.cpuTime, measurement.heapGrowth, measurement.calls, DTClientPerformance::maxRSS());
+      theJsonFile << line;
+    }
+  }
+  if(theJsonFile.is_open()) theJsonFile.flush();
+
+  performance.resetCurrent();
+
+}
+
+
+
+int DTClientPerformanceMonitor::bin(const string& key) {
+
+  map<string, int>::const_iterator knownBin = theBins.find(key);
+  if(knownBin != theBins.end()) return knownBin->second;
+
+  if(int(theBins.size()) == maxRecords) return 0;
+  int newBin = theBins.size() + 1;
+  theBins[key] = newBin;
+  wallTimeME->setBinLabel(newBin, key);
+  cpuTimeME->setBinLabel(newBin, key);
+  heapGrowthME->setBinLabel(newBin, key);
+  callsME->setBinLabel(newBin, key);
+  return newBin;
+
+}
@@ -0,0 +1,60 @@
+#ifndef DTMonitorClient_DTClientPerformanceMonitor_H
+#define DTMonitorClient_DTClientPerformanceMonitor_H
+
+/** \class DTClientPerformanceMonitor
+ *  Publishes the resources used by the DT clients (see DTClientPerformance)
+ *  in DT/EventInfo/ClientPerformance at the end of each LS and run, one bin
+ *  per client method, and optionally appends them to a JSON-lines file.
+ *  A summary table of the whole job is printed at endJob.
+ *  To account for all the clients it has to be the last module of the sequence.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include <string>
+#include <map>
+#include <fstream>
+
+class DQMStore;
+class MonitorElement;
+
+class DTClientPerformanceMonitor : public edm::EDAnalyzer {
+public:
+  /// Constructor
+  DTClientPerformanceMonitor(const edm::ParameterSet& pset);
+
+  /// Destructor
+  virtual ~DTClientPerformanceMonitor();
+
+private:
+  virtual void beginJob();
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
+  virtual void endRun(const edm::Run& run, const edm::EventSetup& setup);
+  virtual void endJob();
+
+  /// Fill the MEs and the JSON file with the records of the current LS, then reset them
+  void publish(int run, int lumi);
+
+  /// Bin of a record in the MEs (0 if no bin is left)
+  int bin(const std::string& key);
+
+  DQMStore *theDbe;
+
+  MonitorElement* wallTimeME;
+  MonitorElement* cpuTimeME;
+  MonitorElement* heapGrowthME;
+  MonitorElement* callsME;
+  std::map<std::string, int> theBins;
+
+  std::string theJsonFileName;
+  std::ofstream theJsonFile;
+
+};
+
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+#include "DQM/DTMonitorClient/src/DTClientSchedulePlanner.h"
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+
+#include <stdio.h>
+#include <sstream>
+#include <vector>
+
+
+using namespace std;
+using namespace edm;
+
+
+DTClientSchedulePlanner::DTClientSchedulePlanner(const ParameterSet& pset) {
+
+  // CPU time (s) the scheduled clients can use at the end of each LS
+  double cpuBudget = pset.getUntrackedParameter<double>("cpuBudgetPerLS", 2.);
+  // every client runs at least once every maxSkippedLS LS
+  int maxSkippedLS = pset.getUntrackedParameter<int>("maxSkippedLS", 5);
+
+  DTClientScheduler::instance().enable(cpuBudget, maxSkippedLS);
+
+}
+
+
+
+
+DTClientSchedulePlanner::~DTClientSchedulePlanner() {}
+
+
+
+void DTClientSchedulePlanner::beginJob(){
+
+  theDbe = Service<DQMStore>().operator->();
+
+}
+
+
+
+void DTClientSchedulePlanner::beginRun(const Run& run, const EventSetup& setup){
+
+  DTClientScheduler::instance().beginRun(run.run());
+
+}
+
+
+
+void DTClientSchedulePlanner::analyze(const Event& event, const EventSetup& setup){}
+
+
+
+void DTClientSchedulePlanner::endLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup){
+
+  const DTEventCounters& counters = DTEventCounters::get(theDbe, lumi.run(), lumi.luminosityBlock());
+  DTClientScheduler& scheduler = DTClientScheduler::instance();
+  scheduler.plan(lumi.run(), lumi.luminosityBlock(), counters);
+
+  stringstream selected;
+  const vector<DTClientScheduler::Client>& clients = scheduler.clients();
+  for(vector<DTClientScheduler::Client>::const_iterator client = clients.begin();
+      client != clients.end(); ++client) {
+    if(client->selected) selected << " " << client->name;
+  }
+  LogTrace("DTDQM|DTMonitorClient|DTClientSchedulePlanner")
+    << "[DTClientSchedulePlanner]: LS " << lumi.luminosityBlock() << ", clients to run:" << selected.str();
+
+}
+
+
+
+void DTClientSchedulePlanner::endJob() {
+
+  LogVerbatim summary("DTDQM|DTMonitorClient|DTClientSchedulePlanner");
+  summary << "DT client schedule summary:\n";
+  char line[256];
+  sprintf(line, "%-40s %8s %8s %14s\n", "client", "runs", "skips", "last cost (s)");
+  summary << line;
+  const vector<DTClientScheduler::Client>& clients = DTClientScheduler::instance().clients();
+  for(vector<DTClientScheduler::Client>::const_iterator client = clients.begin();
+      client != clients.end(); ++client) {
+    sprintf(line, "%-40s %8d %8d %14.3f\n", client->name.c_str(), client->runs, client->skips, client->cost);
+    summary << line;
+  }
+
+}
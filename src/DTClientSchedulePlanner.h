@@ -0,0 +1,39 @@
+#ifndef DTMonitorClient_DTClientSchedulePlanner_H
+#define DTMonitorClient_DTClientSchedulePlanner_H
+
+/** \class DTClientSchedulePlanner
+ *  Enables the scheduling of the DT client diagnostics (see DTClientScheduler)
+ *  and selects at the end of each LS the clients to run.
+ *  It has to be the first module of the client sequence.
+ *  A summary of the runs and skips of each client is printed at endJob.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+class DQMStore;
+
+class DTClientSchedulePlanner : public edm::EDAnalyzer {
+public:
+  /// Constructor
+  DTClientSchedulePlanner(const edm::ParameterSet& pset);
+
+  /// Destructor
+  virtual ~DTClientSchedulePlanner();
+
+private:
+  virtual void beginJob();
+  virtual void beginRun(const edm::Run& run, const edm::EventSetup& setup);
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
+  virtual void endJob();
+
+  DQMStore *theDbe;
+
+};
+
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace {
+  // the minimum cost of a client (s), avoids dividing by 0 for the cheap ones
+  const double minCost = 1.e-4;
+
+  typedef pair<double, int> Candidate; // priority, slot
+  bool higherPriority(const Candidate& first, const Candidate& second) {
+    return first.first > second.first;
+  }
+}
+
+
+DTClientScheduler::Execution::Execution(int slot) : theSlot(slot) {
+
+  theCpuTime = DTClientPerformance::cpuTime();
+
+}
+
+
+DTClientScheduler::Execution::~Execution() {
+
+  Client& client = DTClientScheduler::instance().theClients[theSlot];
+  client.cost = DTClientPerformance::cpuTime() - theCpuTime;
+  client.eventsAtLastRun = client.eventsNow;
+  client.skippedLS = 0;
+  client.runs++;
+
+}
+
+
+DTClientScheduler& DTClientScheduler::instance() {
+
+  static DTClientScheduler scheduler;
+  return scheduler;
+
+}
+
+
+int DTClientScheduler::registerClient(const string& name, DTEventCounters::Stream stream, int prescale) {
+
+  Client client;
+  client.name = name;
+  client.stream = stream;
+  client.prescale = prescale > 0 ? prescale : 1;
+  client.cost = -1.;
+  client.eventsAtLastRun = 0;
+  client.eventsNow = 0;
+  client.skippedLS = 0;
+  client.selected = true;
+  client.runs = 0;
+  client.skips = 0;
+  theClients.push_back(client);
+  return theClients.size() - 1;
+
+}
+
+
+void DTClientScheduler::enable(double cpuBudget, int maxSkippedLS) {
+
+  theEnabled = true;
+  theCpuBudget = cpuBudget;
+  theMaxSkippedLS = maxSkippedLS > 0 ? maxSkippedLS : 1;
+
+}
+
+
+void DTClientScheduler::beginRun(int run) {
+
+  for(vector<Client>::iterator client = theClients.begin(); client != theClients.end(); ++client) {
+    client->eventsAtLastRun = 0;
+    client->eventsNow = 0;
+    client->skippedLS = 0;
+  }
+  theRun = run;
+  theLumi = -1;
+
+}
+
+
+void DTClientScheduler::plan(int run, int lumi, const DTEventCounters& counters) {
+
+  // the counters restart with the run
+  if(run != theRun) beginRun(run);
+  theLumi = lumi;
+
+  double spent = 0.;
+  vector<Candidate> candidates;
+  for(vector<Client>::iterator client = theClients.begin(); client != theClients.end(); ++client) {
+    // without the counter the statistics are assumed to have grown
+    client->eventsNow = counters.found(client->stream) ? counters.events(client->stream) : client->eventsAtLastRun + 1;
+    client->selected = false;
+    if(client->cost < 0. || client->skippedLS + 1 >= theMaxSkippedLS) {
+      client->selected = true;
+      spent += max(client->cost, 0.);
+      continue;
+    }
+    int gain = client->eventsNow - client->eventsAtLastRun;
+    if(gain <= 0) continue;
+    double relativeGain = double(gain)/double(max(client->eventsAtLastRun, 1));
+    candidates.push_back(make_pair(relativeGain/max(client->cost, minCost), client - theClients.begin()));
+  }
+
+  sort(candidates.begin(), candidates.end(), higherPriority);
+  for(vector<Candidate>::const_iterator candidate = candidates.begin();
+      candidate != candidates.end(); ++candidate) {
+    Client& client = theClients[candidate->second];
+    if(spent + client.cost > theCpuBudget) continue;
+    client.selected = true;
+    spent += client.cost;
+  }
+
+}
+
+
+bool DTClientScheduler::runInLS(int slot, int run, int lumi, int nUpdates) {
+
+  Client& client = theClients[slot];
+  if(!theEnabled) return nUpdates%client.prescale == 0;
+
+  // no plan for this LS (planner not before the clients): run
+  bool runNow = run != theRun || lumi != theLumi || client.selected;
+  if(!runNow) {
+    client.skippedLS++;
+    client.skips++;
+  }
+  return runNow;
+
+}
+
+
+bool DTClientScheduler::pending(int slot) const {
+
+  return theEnabled && theClients[slot].skippedLS != 0;
+
+}
@@ -0,0 +1,95 @@
+#ifndef DTClientScheduler_H
+#define DTClientScheduler_H
+
+/** \class DTClientScheduler
+ *  Job wide scheduling of the end of LS diagnostic of the DT clients.
+ *  Each client registers itself with the stream of DTEventCounters its
+ *  inputs depend on. At the end of each LS DTClientSchedulePlanner, placed
+ *  before the clients, selects the clients to run within a CPU budget:
+ *  the clients that never ran or were skipped for maxSkippedLS - 1 LS run
+ *  in any case, the others are ranked by the relative growth of their
+ *  statistics over the CPU cost of their last execution.
+ *  The clients still having unprocessed statistics run again at endRun.
+ *  The bookkeeping of the statistics restarts with each run, as the
+ *  event counters do.
+ *  Without the planner in the job the clients fall back to their
+ *  diagnosticPrescale.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
+
+#include <string>
+#include <vector>
+
+class DTClientScheduler {
+
+public:
+
+  /// Bookkeeping of a registered client
+  struct Client {
+    std::string name;
+    DTEventCounters::Stream stream;
+    int prescale;
+    double cost;          // CPU time of the last execution (s), < 0 if it never ran
+    int eventsAtLastRun;  // events of the stream when it last ran
+    int eventsNow;        // events of the stream in the current LS
+    int skippedLS;        // LS skipped since it last ran
+    bool selected;        // selected for the current LS
+    int runs;
+    int skips;
+  };
+
+  /// Scoped execution of a client diagnostic: measures its cost
+  class Execution {
+  public:
+    Execution(int slot);
+    ~Execution();
+  private:
+    int theSlot;
+    double theCpuTime;
+  };
+
+  /// The job wide instance
+  static DTClientScheduler& instance();
+
+  /// Register a client and return its slot
+  int registerClient(const std::string& name, DTEventCounters::Stream stream, int prescale);
+
+  /// Switch on the scheduling with a CPU budget per LS (s) and the max # of LS between two runs
+  void enable(double cpuBudget, int maxSkippedLS);
+  bool enabled() const { return theEnabled; };
+
+  /// Restart the bookkeeping of the statistics of the clients for a new run
+  void beginRun(int run);
+
+  /// Select the clients to run at the end of the given LS
+  void plan(int run, int lumi, const DTEventCounters& counters);
+
+  /// Should the client run its diagnostic at the end of this LS?
+  /// Without the planner the diagnosticPrescale is applied to nUpdates
+  bool runInLS(int slot, int run, int lumi, int nUpdates);
+
+  /// True if the client skipped some LS since it last ran
+  bool pending(int slot) const;
+
+  /// The registered clients
+  const std::vector<Client>& clients() const { return theClients; };
+
+private:
+
+  DTClientScheduler() : theEnabled(false), theCpuBudget(0.), theMaxSkippedLS(1), theRun(-1), theLumi(-1) {};
+
+  bool theEnabled;
+  double theCpuBudget;
+  int theMaxSkippedLS;
+  // run and LS of the current plan
+  int theRun;
+  int theLumi;
+  std::vector<Client> theClients;
+
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
+
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+#include "Geometry/DTGeometry/interface/DTLayer.h"
+#include "Geometry/DTGeometry/interface/DTTopology.h"
+
+#include "CondFormats/DTObjects/interface/DTTtrig.h"
+#include "CondFormats/DataRecord/interface/DTTtrigRcd.h"
+#include "CondFormats/DTObjects/interface/DTMtime.h"
+#include "CondFormats/DataRecord/interface/DTMtimeRcd.h"
+#include "CondFormats/DTObjects/interface/DTTPGParameters.h"
+#include "CondFormats/DataRecord/interface/DTTPGParametersRcd.h"
+#include "CondFormats/DTObjects/interface/DTStatusFlag.h"
+#include "CondFormats/DataRecord/interface/DTStatusFlagRcd.h"
+
+using namespace edm;
+using namespace std;
+
+
+DTConditionsSnapshot::DTConditionsSnapshot(int records) :
+  theRecords(records),
+  tTrigCacheId(0), mTimeCacheId(0), tpgCacheId(0), statusCacheId(0),
+  tTrigFound(nSLs,false), tTrigMean(nSLs,0.), tTrigRms(nSLs,0.), tTrigKFact(nSLs,0.),
+  vDriftFound(nSLs,false), vDriftMean(nSLs,0.), vDriftRes(nSLs,0.),
+  tpgFound(nChambers,false), tpgCoarse(nChambers,0), tpgFine(nChambers,0.),
+  layerFirstCell(nLayers,-1), layerFirstWire(nLayers,0), layerNWires(nLayers,0) {
+
+}
+
+
+DTConditionsSnapshot::~DTConditionsSnapshot() {}
+
+
+bool DTConditionsSnapshot::update(const EventSetup& context, const DTGeometry& geom) {
+
+  bool updated = false;
+
+  if (theRecords & TTrig) {
+    unsigned long long cacheId = context.get<DTTtrigRcd>().cacheIdentifier();
+    if (cacheId != tTrigCacheId) {
+      tTrigCacheId = cacheId;
+      readTTrig(context,geom);
+      updated = true;
+    }
+  }
+
+  if (theRecords & MTime) {
+    unsigned long long cacheId = context.get<DTMtimeRcd>().cacheIdentifier();
+    if (cacheId != mTimeCacheId) {
+      mTimeCacheId = cacheId;
+      readMTime(context,geom);
+      updated = true;
+    }
+  }
+
+  if (theRecords & TPGParameters) {
+    unsigned long long cacheId = context.get<DTTPGParametersRcd>().cacheIdentifier();
+    if (cacheId != tpgCacheId) {
+      tpgCacheId = cacheId;
+      readTPGParameters(context,geom);
+      updated = true;
+    }
+  }
+
+  if (theRecords & StatusFlag) {
+    unsigned long long cacheId = context.get<DTStatusFlagRcd>().cacheIdentifier();
+    if (cacheId != statusCacheId) {
+      statusCacheId = cacheId;
+      readStatusFlag(context,geom);
+      updated = true;
+    }
+  }
+
+  return updated;
+
+}
+
+
+unsigned char DTConditionsSnapshot::cellStatus(const DTWireId& wireId) const {
+
+  int lIndex = layerIndex(wireId.layerId());
+  int cell = wireId.wire() - layerFirstWire[lIndex];
+  if (layerFirstCell[lIndex] < 0 || cell < 0 || cell >= layerNWires[lIndex]) return 0;
+  return cellFlags[layerFirstCell[lIndex] + cell];
+
+}
+
+
+void DTConditionsSnapshot::readTTrig(const EventSetup& context, const DTGeometry& geom) {
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTConditionsSnapshot") << "[DTConditionsSnapshot]: new DTTtrig IOV";
+
+  ESHandle<DTTtrig> tTrigMap;
+  context.get<DTTtrigRcd>().get(tTrigMap);
+
+  vector<DTSuperLayer*>::const_iterator sl_it  = geom.superLayers().begin();
+  vector<DTSuperLayer*>::const_iterator sl_end = geom.superLayers().end();
+  for (; sl_it != sl_end; ++sl_it) {
+    DTSuperLayerId slId = (*sl_it)->id();
+    int index = slIndex(slId);
+    float tTrig = 0., tTrigRMS = 0., kFactor = 0.;
+    tTrigFound[index] = (tTrigMap->get(slId, tTrig, tTrigRMS, kFactor, DTTimeUnits::counts) == 0);
+    tTrigMean[index]  = tTrig;
+    tTrigRms[index]   = tTrigRMS;
+    tTrigKFact[index] = kFactor;
+  }
+
+}
+
+
+void DTConditionsSnapshot::readMTime(const EventSetup& context, const DTGeometry& geom) {
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTConditionsSnapshot") << "[DTConditionsSnapshot]: new DTMtime IOV";
+
+  ESHandle<DTMtime> mTimeMap;
+  context.get<DTMtimeRcd>().get(mTimeMap);
+
+  vector<DTSuperLayer*>::const_iterator sl_it  = geom.superLayers().begin();
+  vector<DTSuperLayer*>::const_iterator sl_end = geom.superLayers().end();
+  for (; sl_it != sl_end; ++sl_it) {
+    DTSuperLayerId slId = (*sl_it)->id();
+    int index = slIndex(slId);
+    float vDrift = 0., reso = 0.;
+    vDriftFound[index] = (mTimeMap->get(slId, vDrift, reso, DTVelocityUnits::cm_per_ns) == 0);
+    vDriftMean[index]  = vDrift;
+    vDriftRes[index]   = reso;
+  }
+
+}
+
+
+void DTConditionsSnapshot::readTPGParameters(const EventSetup& context, const DTGeometry& geom) {
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTConditionsSnapshot") << "[DTConditionsSnapshot]: new DTTPGParameters IOV";
+
+  ESHandle<DTTPGParameters> tpgMap;
+  context.get<DTTPGParametersRcd>().get(tpgMap);
+
+  vector<DTChamber*>::const_iterator ch_it  = geom.chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = geom.chambers().end();
+  for (; ch_it != ch_end; ++ch_it) {
+    DTChamberId chId = (*ch_it)->id();
+    int index = chamberIndex(chId);
+    int coarse = 0;
+    float fine = 0.;
+    tpgFound[index]  = (tpgMap->get(chId, coarse, fine, DTTimeUnits::ns) == 0);
+    tpgCoarse[index] = coarse;
+    tpgFine[index]   = fine;
+  }
+
+}
+
+
+void DTConditionsSnapshot::readStatusFlag(const EventSetup& context, const DTGeometry& geom) {
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTConditionsSnapshot") << "[DTConditionsSnapshot]: new DTStatusFlag IOV";
+
+  // wire layout from the geometry
+  int nCells = 0;
+  vector<DTLayer*>::const_iterator l_it  = geom.layers().begin();
+  vector<DTLayer*>::const_iterator l_end = geom.layers().end();
+  for (; l_it != l_end; ++l_it) {
+    int index = layerIndex((*l_it)->id());
+    const DTTopology& topo = (*l_it)->specificTopology();
+    layerFirstCell[index] = nCells;
+    layerFirstWire[index] = topo.firstChannel();
+    layerNWires[index]    = topo.channels();
+    nCells += topo.channels();
+  }
+  cellFlags.assign(nCells,0);
+
+  ESHandle<DTStatusFlag> statusMap;
+  context.get<DTStatusFlagRcd>().get(statusMap);
+
+  // only the flagged cells are stored in the record
+  DTStatusFlag::const_iterator st_it  = statusMap->begin();
+  DTStatusFlag::const_iterator st_end = statusMap->end();
+  for (; st_it != st_end; ++st_it) {
+    const DTStatusFlagId& id = (*st_it).first;
+    const DTStatusFlagData& data = (*st_it).second;
+    if (id.wheelId < -2 || id.wheelId > 2 || id.stationId < 1 || id.stationId > 4 ||
+	id.sectorId < 1 || id.sectorId > 14 || id.slId < 1 || id.slId > 3 ||
+	id.layerId < 1 || id.layerId > 4) continue;
+    int index = layerIndex(DTLayerId(id.wheelId, id.stationId, id.sectorId, id.slId, id.layerId));
+    int cell = id.cellId - layerFirstWire[index];
+    if (layerFirstCell[index] < 0 || cell < 0 || cell >= layerNWires[index]) continue;
+    unsigned char flags = 0;
+    if (data.noiseFlag) flags |= Noisy;
+    if (data.feMask)    flags |= FEMasked;
+    if (data.tdcMask)   flags |= TDCMasked;
+    if (data.trigMask)  flags |= TrigMasked;
+    if (data.deadFlag)  flags |= Dead;
+    if (data.nohvFlag)  flags |= NoHV;
+    cellFlags[layerFirstCell[index] + cell] = flags;
+  }
+
+}
@@ -0,0 +1,118 @@
+#ifndef DTConditionsSnapshot_H
+#define DTConditionsSnapshot_H
+
+/** \class DTConditionsSnapshot
+ *  Dense copy of the DT conditions used by the clients.
+ *  The selected records (DTTtrig, DTMtime, DTTPGParameters, DTStatusFlag)
+ *  are converted into arrays indexed by SL, chamber or wire, and are
+ *  refreshed only when the record cacheIdentifier changes (i.e. once per IOV).
+ *  The clients call update() at every transition and then read the arrays,
+ *  without accessing the EventSetup in their loops.
+ *
+ *  Units: tTrig in TDC counts, vDrift in cm/ns, TPG fine delay in ns.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DataFormats/MuonDetId/interface/DTChamberId.h"
+#include "DataFormats/MuonDetId/interface/DTSuperLayerId.h"
+#include "DataFormats/MuonDetId/interface/DTLayerId.h"
+#include "DataFormats/MuonDetId/interface/DTWireId.h"
+
+#include <vector>
+
+namespace edm {
+  class EventSetup;
+}
+class DTGeometry;
+
+class DTConditionsSnapshot {
+
+public:
+
+  /// Records which can be snapshotted
+  enum Record { TTrig = 1, MTime = 2, TPGParameters = 4, StatusFlag = 8 };
+
+  /// Bits of the cell status
+  enum CellFlag { Noisy = 1, FEMasked = 2, TDCMasked = 4, TrigMasked = 8, Dead = 16, NoHV = 32 };
+
+  /// Constructor (records is an OR of Record values)
+  DTConditionsSnapshot(int records);
+
+  /// Destructor
+  virtual ~DTConditionsSnapshot();
+
+  /// Refresh the records whose IOV changed, return true if any was refreshed
+  bool update(const edm::EventSetup& context, const DTGeometry& geom);
+
+  /// Dense indexes (sectors 1-14)
+  static int chamberIndex(const DTChamberId& chId) {
+    return ((chId.wheel()+2)*4 + chId.station()-1)*14 + chId.sector()-1;
+  };
+  static int slIndex(const DTSuperLayerId& slId) {
+    return chamberIndex(slId.chamberId())*3 + slId.superlayer()-1;
+  };
+  static int layerIndex(const DTLayerId& lId) {
+    return slIndex(lId.superlayerId())*4 + lId.layer()-1;
+  };
+  static const int nChambers = 5*4*14;
+  static const int nSLs = nChambers*3;
+  static const int nLayers = nSLs*4;
+
+  /// tTrig (TDC counts)
+  bool hasTTrig(const DTSuperLayerId& slId) const { return tTrigFound[slIndex(slId)]; };
+  float tTrig(const DTSuperLayerId& slId) const { return tTrigMean[slIndex(slId)]; };
+  float tTrigRMS(const DTSuperLayerId& slId) const { return tTrigRms[slIndex(slId)]; };
+  float tTrigKFactor(const DTSuperLayerId& slId) const { return tTrigKFact[slIndex(slId)]; };
+
+  /// vDrift (cm/ns)
+  bool hasVDrift(const DTSuperLayerId& slId) const { return vDriftFound[slIndex(slId)]; };
+  float vDrift(const DTSuperLayerId& slId) const { return vDriftMean[slIndex(slId)]; };
+  float vDriftReso(const DTSuperLayerId& slId) const { return vDriftRes[slIndex(slId)]; };
+
+  /// TPG parameters (coarse delay in BX, fine delay in ns)
+  bool hasTPGParameters(const DTChamberId& chId) const { return tpgFound[chamberIndex(chId)]; };
+  int tpgCoarseDelay(const DTChamberId& chId) const { return tpgCoarse[chamberIndex(chId)]; };
+  float tpgFineDelay(const DTChamberId& chId) const { return tpgFine[chamberIndex(chId)]; };
+
+  /// Cell status (OR of CellFlag values, 0 if the cell is not in the record)
+  unsigned char cellStatus(const DTWireId& wireId) const;
+
+private:
+
+  void readTTrig(const edm::EventSetup& context, const DTGeometry& geom);
+  void readMTime(const edm::EventSetup& context, const DTGeometry& geom);
+  void readTPGParameters(const edm::EventSetup& context, const DTGeometry& geom);
+  void readStatusFlag(const edm::EventSetup& context, const DTGeometry& geom);
+
+  int theRecords;
+
+  unsigned long long tTrigCacheId;
+  unsigned long long mTimeCacheId;
+  unsigned long long tpgCacheId;
+  unsigned long long statusCacheId;
+
+  // by slIndex
+  std::vector<bool> tTrigFound;
+  std::vector<float> tTrigMean;
+  std::vector<float> tTrigRms;
+  std::vector<float> tTrigKFact;
+  std::vector<bool> vDriftFound;
+  std::vector<float> vDriftMean;
+  std::vector<float> vDriftRes;
+
+  // by chamberIndex
+  std::vector<bool> tpgFound;
+  std::vector<int> tpgCoarse;
+  std::vector<float> tpgFine;
+
+  // by wire: layerFirstCell[layerIndex] + wire - layerFirstWire[layerIndex]
+  std::vector<int> layerFirstCell;
+  std::vector<int> layerFirstWire;
+  std::vector<int> layerNWires;
+  std::vector<unsigned char> cellFlags;
+
+};
+
+#endif
@@ -22,16 +22,55 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 #include <sstream>
 #include <math.h>
 
 #include "TCanvas.h"
 #include "TFile.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TClass.h"
 #include "TProfile.h"
+#include "TStopwatch.h"
 
 using namespace edm;
 using namespace std;
 
+namespace {
+  /// Rendering time of a page, sent by the workers to the main process
+  struct PageTiming {
+    int page;
+    int worker;
+    double seconds;
+  };
+}
+
+namespace {
+  // "_W<wheel>_St<station>_Sec<sector>"
+  string chamberTag(const DTChamberId& ch) {
+    stringstream tag;
+    tag << "_W" << ch.wheel() << "_St" << ch.station() << "_Sec" << ch.sector();
+    return tag.str();
+  }
+  // "/Wheel<wheel>/Station<station>/Sector<sector>"
+  string chamberFolder(const DTChamberId& ch) {
+    stringstream folder;
+    folder << "/Wheel" << ch.wheel() << "/Station" << ch.station() << "/Sector" << ch.sector();
+    return folder.str();
+  }
+  // The trigger folders and names have the sector before the station
+  string triggerHistoName(const string& folder, const DTChamberId& ch, const string& prefix) {
+    stringstream name;
+    name << folder << "/Wheel" << ch.wheel() << "/Sector" << ch.sector() << "/Station" << ch.station()
+	 << "/" << prefix << "_W" << ch.wheel() << "_Sec" << ch.sector() << "_St" << ch.station();
+    return name.str();
+  }
+}
+
 DTCreateSummaryHistos::DTCreateSummaryHistos(const edm::ParameterSet& ps){
 
   edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos]: Constructor";
@@ -39,7 +78,7 @@ DTCreateSummaryHistos::DTCreateSummaryHistos(const edm::ParameterSet& ps){
   parameters = ps;
 
   // The root file which contain the histos
-  string rootFileName = ps.getUntrackedParameter<string>("rootFileName", "DTEfficiencyTest.root");
+  rootFileName = ps.getUntrackedParameter<string>("rootFileName", "DTEfficiencyTest.root");
   theFile = new TFile(rootFileName.c_str(), "READ");
 
    // The *.ps file which contains the summary histos
@@ -54,6 +93,25 @@ DTCreateSummaryHistos::DTCreateSummaryHistos(const edm::ParameterSet& ps){
   TestPulsesHistos = ps.getUntrackedParameter<bool>("TestPulsesHistos", false);
   TriggerHistos = ps.getUntrackedParameter<bool>("TriggerHistos", false);
 
+  // A non empty list of categories overrides the flags above
+  vector<string> categories = ps.getUntrackedParameter<vector<string> >("categories", vector<string>());
+  if(!categories.empty()) {
+    set<string> selected(categories.begin(), categories.end());
+    DataIntegrityHistos = selected.count("DataIntegrity") != 0;
+    DigiHistos = selected.count("Digi") != 0;
+    RecoHistos = selected.count("Reco") != 0;
+    ResoHistos = selected.count("Reso") != 0;
+    EfficiencyHistos = selected.count("Efficiency") != 0;
+    TestPulsesHistos = selected.count("TestPulses") != 0;
+    TriggerHistos = selected.count("Trigger") != 0;
+  }
+
+  // With more than one worker each page goes to its own file (pdf or png)
+  nWorkers = ps.getUntrackedParameter<int>("nWorkers", 1);
+  pageFormat = ps.getUntrackedParameter<string>("pageFormat", "pdf");
+  // Called with the page files followed by the output file
+  mergeCommand = ps.getUntrackedParameter<string>("mergeCommand", "pdfunite");
+
   // The DDU Id
   DDUId = ps.getUntrackedParameter<int>("DDUId");
 
@@ -95,633 +153,425 @@ void DTCreateSummaryHistos::endJob(){
 
   edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos] endjob called!";
 
+  TStopwatch timer;
+
+  // Read the directory structure once instead of looking up every path
+  theKeyIndex.clear();
+  string topFolder = MainFolder.substr(0, MainFolder.size()-1);
+  TDirectory *topDir = theFile->GetDirectory(topFolder.c_str());
+  if(topDir) indexDirectory(topDir, topFolder);
+  buildPages();
+
+  edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos] " << theKeyIndex.size() << " histos in file, "
+			      << thePages.size() << " pages to render (index built in "
+			      << timer.RealTime() << " s)";
+
   stringstream RunNum; RunNum << runNumber;
-  string PsFileNameWithRun = PsFileName + "_" + RunNum.str() + ".ps";
-  TPostScript psFile(PsFileNameWithRun.c_str(),111);
-  psFile.Range(20,26);
-  //psFile.NewPage();
-  TCanvas c1("c1","",600,780);
+  string baseName = PsFileName + "_" + RunNum.str();
+  timer.Start();
+  if(nWorkers > 1) {
+    renderParallel(baseName);
+  } else {
+    renderSerial(baseName + ".ps");
+  }
+  edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos] pages rendered in " << timer.RealTime() << " s";
 
+}
 
 
-  // DataIntegrity summary histos **************************************************************
-  if(DataIntegrityHistos){
-    c1.Clear();
-    c1.Divide(2,2);    
-    stringstream dduID; dduID << DDUId;
+void DTCreateSummaryHistos::indexDirectory(TDirectory *dir, const string& path) {
 
-    string histo_name1 = MainFolder + "DataIntegrity/FED" + dduID.str() + "/FED" + dduID.str() + "_TTSValues";
-    TH1F *histo1 = (TH1F*) theFile -> Get(histo_name1.c_str());
-    c1.cd(1);
-    if(histo1)
-      histo1->Draw();
-    
-    string histo_name2 = MainFolder + "DataIntegrity/FED" + dduID.str() + "/FED" + dduID.str() + "_ROSStatus";
-    TH1F *histo2 = (TH1F*) theFile -> Get(histo_name2.c_str());
-    c1.cd(2);
-    if(histo2)
-      histo2->Draw();
-    
-    string histo_name3 = MainFolder + "DataIntegrity/FED" + dduID.str() + "/FED" + dduID.str() + "_ROSSummary";
-    TH1F *histo3 = (TH1F*) theFile -> Get(histo_name3.c_str());
-    c1.cd(3);
-    if(histo3)
-    histo3->Draw();
-    
-    string histo_name4 = MainFolder + "DataIntegrity/FED" + dduID.str() + "/ROS1/FED" + dduID.str() + "_ROS1_ROSError";
-    TH1F *histo4 = (TH1F*) theFile -> Get(histo_name4.c_str());
-    c1.cd(4);
-    if(histo4)
-      histo4->Draw();
-    
-    c1.Update();
-    psFile.NewPage();
+  TIter next(dir->GetListOfKeys());
+  TKey *key;
+  while((key = (TKey*) next())) {
+    string name = path + "/" + key->GetName();
+    TClass *keyClass = TClass::GetClass(key->GetClassName());
+    if(keyClass && keyClass->InheritsFrom("TDirectory")) {
+      TDirectory *subDir = dir->GetDirectory(key->GetName());
+      if(subDir) indexDirectory(subDir, name);
+    } else {
+      theKeyIndex.insert(name);
+    }
   }
 
-  // Digi summary histos  ********************************************************************
-  if(DigiHistos){
-    // Time Box Histos
-    c1.Clear();
-    c1.Divide(3,4);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_digi_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_digi_end = muonGeom->chambers().end();
-    for (; ch_digi_it != ch_digi_end; ++ch_digi_it) {
-      DTChamberId ch = (*ch_digi_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_digi_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_digi_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	stringstream superLayer; superLayer << sl.superlayer();
-	
-	string digiFolder = MainFolder + "DTDigiTask/Wheel" + wheel.str();
-	string histo_name = digiFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/TimeBoxes/TimeBox_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str()+ "_SL" + superLayer.str();
-	TH1F *histo = (TH1F *) theFile->Get(histo_name.c_str());
-	if(histo){
-	  int pad = (ch.station() - 1)*3 + sl.superlayer();
-	  c1.cd(pad);
-	  histo->Draw();
-	}
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
-    
-    // Occupancy in Time Histos
-    c1.Clear();
-    c1.Divide(4,3);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_digi2_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_digi2_end = muonGeom->chambers().end();
-    for (; ch_digi2_it != ch_digi2_end; ++ch_digi2_it) {
-      DTChamberId ch = (*ch_digi2_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      bool found = false;
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_digi2_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_digi2_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
-	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
-	stringstream superLayer; superLayer << sl.superlayer();
-	// Loop over the Ls
-	for(; l_it != l_end; ++l_it) {
-	  DTLayerId layerId = (*l_it)->id();
-	  stringstream layer; layer << layerId.layer();
-	  
-	  string digiFolder = MainFolder + "DTDigiTask/Wheel" + wheel.str();
-	  string histo_name = digiFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/Occupancies/OccupancyInTimeHits_perL_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str()+ "_SL" + superLayer.str() + "_L" + layer.str();     
-	  TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-	  if(histo){
-	    found = true;
-	    int pad = (sl.superlayer() - 1)*4 + layerId.layer();
-	    c1.cd(pad);
-	    histo->Draw();
-	  }
-	}
-      }
-      if(found){
-	c1.Update();
-	psFile.NewPage();
-      }
+}
+
+
+bool DTCreateSummaryHistos::inFile(const string& histoName) const {
+
+  return theKeyIndex.find(histoName) != theKeyIndex.end();
+
+}
+
+
+bool DTCreateSummaryHistos::addToPad(SummaryPage& page, int pad, const string& histoName,
+				     const string& option, bool efficiencyRange) const {
+
+  if(!inFile(histoName)) return false;
+
+  if(option.find("same") == string::npos) {
+    vector<PadContent>::iterator content = page.contents.begin();
+    while(content != page.contents.end()) {
+      if(content->pad == pad) content = page.contents.erase(content);
+      else ++content;
     }
-    
-    // Occupancy Noise
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_digi3_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_digi3_end = muonGeom->chambers().end();
-    for (; ch_digi3_it != ch_digi3_end; ++ch_digi3_it) {
-      DTChamberId ch = (*ch_digi3_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      bool found = false;
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_digi3_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_digi3_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
-	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
-	stringstream superLayer; superLayer << sl.superlayer();
-	// Loop over the Ls
-	for(; l_it != l_end; ++l_it) {
-	  DTLayerId layerId = (*l_it)->id();
-	  stringstream layer; layer << layerId.layer();
-	  
-	  string digiFolder = MainFolder + "DTDigiTask/Wheel" + wheel.str();
-	  string histo_name = digiFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/Occupancies/OccupancyNoise_perL_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str()+ "_SL" + superLayer.str() + "_L" + layer.str(); 
-	  TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-	  if(histo){
-	    found = true;
-	    int pad = (sl.superlayer() - 1)*4 + layerId.layer();
-	    c1.cd(pad);
-	    histo->Draw();
-	  }
-	}
-      }
-      if(found) {
-	c1.Update();
-	psFile.NewPage();
-      }
+  }
+
+  PadContent content;
+  content.pad = pad;
+  content.histoName = histoName;
+  content.option = option;
+  content.efficiencyRange = efficiencyRange;
+  page.contents.push_back(content);
+  return true;
+
+}
+
+
+void DTCreateSummaryHistos::addSLPages(const string& category, const string& title,
+				       const string& folder, const string& subFolder, const string& prefix) {
+
+  // One page for all the chambers, one pad per station and SL
+  SummaryPage page;
+  page.category = category;
+  page.title = title;
+  page.nx = 3;
+  page.ny = 4;
+
+  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
+  for (; ch_it != ch_end; ++ch_it) {
+    DTChamberId ch = (*ch_it)->id();
+    vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_it)->superLayers().begin(); 
+    vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_it)->superLayers().end();
+    // Loop over the SLs
+    for(; sl_it != sl_end; ++sl_it) {
+      DTSuperLayerId sl = (*sl_it)->id();
+      stringstream histoName;
+      histoName << MainFolder << folder << chamberFolder(ch) << subFolder << "/" << prefix
+		<< chamberTag(ch) << "_SL" << sl.superlayer();
+      addToPad(page, (ch.station() - 1)*3 + sl.superlayer(), histoName.str());
     }
-    
-    // Digi Per Event
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_digi4_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_digi4_end = muonGeom->chambers().end();
-    for (; ch_digi4_it != ch_digi4_end; ++ch_digi4_it) {
-      DTChamberId ch = (*ch_digi4_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      bool found = false;
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_digi4_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_digi4_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
-	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
-	stringstream superLayer; superLayer << sl.superlayer();
-	// Loop over the Ls
-	for(; l_it != l_end; ++l_it) {
-	  DTLayerId layerId = (*l_it)->id();
-	  stringstream layer; layer << layerId.layer();
-	  
-	  string digiFolder = MainFolder + "DTDigiTask/Wheel" + wheel.str();
-	  string histo_name = digiFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/DigiPerEvent/DigiPerEvent_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() + "_SL" + superLayer.str() + "_L" + layer.str();
-	  TProfile *histo = (TProfile*) theFile -> Get(histo_name.c_str());
-	  if(histo){
-	    found = true;
-	    int pad = (sl.superlayer() - 1)*4 + layerId.layer();
-	    c1.cd(pad);
-	    histo->Draw();
-	  }
-	}
+  }
+
+  if(!page.contents.empty()) thePages.push_back(page);
+
+}
+
+
+void DTCreateSummaryHistos::addLayerPages(const string& category, const string& title,
+					  const string& folder, const string& subFolder, const string& prefix) {
+
+  // One page per chamber, one pad per SL and layer
+  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
+  for (; ch_it != ch_end; ++ch_it) {
+    DTChamberId ch = (*ch_it)->id();
+    SummaryPage page;
+    page.category = category;
+    page.title = title + chamberTag(ch);
+    page.nx = 4;
+    page.ny = 3;
+    vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_it)->superLayers().begin(); 
+    vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_it)->superLayers().end();
+    // Loop over the SLs
+    for(; sl_it != sl_end; ++sl_it) {
+      DTSuperLayerId sl = (*sl_it)->id();
+      // The test pulse histos have a folder per SL
+      string slFolder = subFolder;
+      if(category == "TestPulses") {
+	stringstream superLayer; superLayer << "/SuperLayer" << sl.superlayer();
+	slFolder = superLayer.str() + subFolder;
       }
-      if(found){
-	c1.Update();
-	psFile.NewPage();
+      vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
+      vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
+      // Loop over the Ls
+      for(; l_it != l_end; ++l_it) {
+	DTLayerId layerId = (*l_it)->id();
+	stringstream histoName;
+	histoName << MainFolder << folder << chamberFolder(ch) << slFolder << "/" << prefix
+		  << chamberTag(ch) << "_SL" << sl.superlayer() << "_L" << layerId.layer();
+	addToPad(page, (sl.superlayer() - 1)*4 + layerId.layer(), histoName.str());
       }
     }
+    if(!page.contents.empty()) thePages.push_back(page);
+  }
+
+}
+
+
+void DTCreateSummaryHistos::buildPages() {
+
+  thePages.clear();
+
+  // DataIntegrity summary histos **************************************************************
+  if(DataIntegrityHistos){
+    SummaryPage page;
+    page.category = "DataIntegrity";
+    page.title = "FED summary";
+    page.nx = 2;
+    page.ny = 2;
+    stringstream dduID; dduID << DDUId;
+    string fedFolder = MainFolder + "DataIntegrity/FED" + dduID.str();
+    addToPad(page, 1, fedFolder + "/FED" + dduID.str() + "_TTSValues");
+    addToPad(page, 2, fedFolder + "/FED" + dduID.str() + "_ROSStatus");
+    addToPad(page, 3, fedFolder + "/FED" + dduID.str() + "_ROSSummary");
+    addToPad(page, 4, fedFolder + "/ROS1/FED" + dduID.str() + "_ROS1_ROSError");
+    if(!page.contents.empty()) thePages.push_back(page);
+  }
+
+  // Digi summary histos  ********************************************************************
+  if(DigiHistos){
+    addSLPages("Digi", "Time boxes", "DTDigiTask", "/TimeBoxes", "TimeBox");
+    addLayerPages("Digi", "Occupancy in time", "DTDigiTask", "/Occupancies", "OccupancyInTimeHits_perL");
+    addLayerPages("Digi", "Occupancy noise", "DTDigiTask", "/Occupancies", "OccupancyNoise_perL");
+    addLayerPages("Digi", "Digi per event", "DTDigiTask", "/DigiPerEvent", "DigiPerEvent");
   }
   
   // Reconstruction summary histos  *********************************************************
   if(RecoHistos){
-    // reco segment Histos - page1
-    c1.Clear(); 
-    c1.Divide(2,4);
-    // Loop over all the chambers
+    SummaryPage page1;
+    page1.category = "Reco";
+    page1.title = "Segments multiplicity and position";
+    page1.nx = 2;
+    page1.ny = 4;
+    SummaryPage page2 = page1;
+    page2.title = "Segments direction";
     vector<DTChamber*>::const_iterator ch_reco_it = muonGeom->chambers().begin();
     vector<DTChamber*>::const_iterator ch_reco_end = muonGeom->chambers().end();
     for (; ch_reco_it != ch_reco_end; ++ch_reco_it) {
       DTChamberId ch = (*ch_reco_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string recoFolder = MainFolder + "DTSegmentAnalysisTask/Wheel" + wheel.str();
-      string histo_name = recoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/hN4DSeg_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();  
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	int pad = (ch.station() - 1)*2 + 1;
-	c1.cd(pad);
-	histo->Draw();
-      }
-      histo_name = recoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/h4DSegmXvsYInCham_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
-      TProfile *histo2 = (TProfile*) theFile -> Get(histo_name.c_str());
-      if(histo2){
-	int pad = (ch.station() - 1)*2 + 2;
-	c1.cd(pad);
-	histo2->Draw();
-      }
+      string recoFolder = MainFolder + "DTSegmentAnalysisTask" + chamberFolder(ch);
+      int pad = (ch.station() - 1)*2;
+      addToPad(page1, pad + 1, recoFolder + "/hN4DSeg" + chamberTag(ch));
+      addToPad(page1, pad + 2, recoFolder + "/h4DSegmXvsYInCham" + chamberTag(ch));
+      addToPad(page2, pad + 1, recoFolder + "/h4DSegmPhiDirection" + chamberTag(ch));
+      addToPad(page2, pad + 2, recoFolder + "/h4DSegmThetaDirection" + chamberTag(ch));
     }
-    c1.Update();
-    psFile.NewPage();
-    
-    // reco segment Histos - page2
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_reco2_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_reco2_end = muonGeom->chambers().end();
-    for (; ch_reco2_it != ch_reco2_end; ++ch_reco2_it) {
-      DTChamberId ch = (*ch_reco2_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string recoFolder = MainFolder + "DTSegmentAnalysisTask/Wheel" + wheel.str();
-      string histo_name = recoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/h4DSegmPhiDirection_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo) {
-	int pad = (ch.station() - 1)*2 + 1;
-	c1.cd(pad);
-	histo->Draw();
-      }
-      histo_name = recoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/h4DSegmThetaDirection_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
-      TH1F *histo2 = (TH1F*) theFile -> Get(histo_name.c_str()); 
-      if(histo2) {
-	int pad = (ch.station() - 1)*2 + 2;
-	c1.cd(pad);
-	histo2->Draw();
-      }
-    }      
-    c1.Update();
-    psFile.NewPage();
+    if(!page1.contents.empty()) thePages.push_back(page1);
+    if(!page2.contents.empty()) thePages.push_back(page2);
   }
     
   // Resolution summary histos  *******************************************************************
   if(ResoHistos){
-    // Residuals histos
-    c1.Clear();
-    c1.Divide(3,4);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_reso_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_reso_end = muonGeom->chambers().end();
-    for (; ch_reso_it != ch_reso_end; ++ch_reso_it) {
-      DTChamberId ch = (*ch_reso_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_reso_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_reso_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	stringstream superLayer; superLayer << sl.superlayer();
-	
-	string resoFolder = MainFolder + "DTResolutionAnalysisTask/Wheel" + wheel.str();
-	string histo_name = resoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/hResDist_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() + "_SL" + superLayer.str();  
-	TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-	if(histo){
-	  int pad = (ch.station() - 1)*3 + sl.superlayer();
-	  c1.cd(pad);
-	  histo->Draw();
-	}
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
-    
-    // Residuals as a function of the position Histos
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_reso2_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_reso2_end = muonGeom->chambers().end();
-    for (; ch_reso2_it != ch_reso2_end; ++ch_reso2_it) {
-      DTChamberId ch = (*ch_reso2_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_reso2_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_reso2_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	stringstream superLayer; superLayer << sl.superlayer();
-	
-	string resoFolder = MainFolder + "DTResolutionAnalysisTask/Wheel" + wheel.str();
-	string histo_name = resoFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/hResDistVsDist_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() + "_SL" + superLayer.str();
-	TProfile *histo = (TProfile*) theFile -> Get(histo_name.c_str());
-	if(histo){
-	  int pad = (ch.station() - 1)*3 + sl.superlayer();
-	  c1.cd(pad);
-	  histo->Draw();
-	}
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
+    addSLPages("Reso", "Residuals", "DTResolutionAnalysisTask", "", "hResDist");
+    addSLPages("Reso", "Residuals vs distance", "DTResolutionAnalysisTask", "", "hResDistVsDist");
   }
   
   // Efficiency summary histos  ******************************************************************
   if(EfficiencyHistos){
-    // Cell efficiency
-    c1.Clear();
-    c1.Divide(4,3);
-    // Loop over all the chambers
+    addLayerPages("Efficiency", "Cell efficiency", "Tests/DTEfficiency", "", "UnassEfficiency");
+
+    SummaryPage pageX;
+    pageX.category = "Efficiency";
+    pageX.title = "Chamber X efficiency";
+    pageX.nx = 2;
+    pageX.ny = 2;
+    SummaryPage pageY = pageX;
+    pageY.title = "Chamber Y efficiency";
     vector<DTChamber*>::const_iterator ch_eff_it = muonGeom->chambers().begin();
     vector<DTChamber*>::const_iterator ch_eff_end = muonGeom->chambers().end();
     for (; ch_eff_it != ch_eff_end; ++ch_eff_it) {
       DTChamberId ch = (*ch_eff_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      bool found = false;
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_eff_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_eff_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
-	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
-	stringstream superLayer; superLayer << sl.superlayer();
-	// Loop over the Ls
-	for(; l_it != l_end; ++l_it) {
-	  DTLayerId layerId = (*l_it)->id();
-	  stringstream layer; layer << layerId.layer();
-	  
-	  string efficiencyFolder = MainFolder + "Tests/DTEfficiency/Wheel" + wheel.str();
-	  string histo_name = efficiencyFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/UnassEfficiency_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() + "_SL" + superLayer.str() + "_L" + layer.str();
-	  TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-	  if(histo){
-	    found = true;
-	    int pad = (sl.superlayer() - 1)*4 + layerId.layer();
-	    c1.cd(pad);
-	    histo->Draw();
-	  }
-	}
-      }
-      if(found){
-	c1.Update();
-	psFile.NewPage();
-      }
+      string efficiencyFolder = MainFolder + "Tests/DTChamberEfficiency" + chamberFolder(ch);
+      addToPad(pageX, ch.station(), efficiencyFolder + "/xEfficiency" + chamberTag(ch));
+      addToPad(pageY, ch.station(), efficiencyFolder + "/yEfficiency" + chamberTag(ch));
     }
-    
-    // Chamber X efficiency
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_eff2_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_eff2_end = muonGeom->chambers().end();
-    for (; ch_eff2_it != ch_eff2_end; ++ch_eff2_it) {
-      DTChamberId ch = (*ch_eff2_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string efficiencyFolder = MainFolder + "Tests/DTChamberEfficiency/Wheel" + wheel.str();
-      string histo_name = efficiencyFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/xEfficiency_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->Draw();
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
-    
-    // Chamber Y efficiency
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_eff3_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_eff3_end = muonGeom->chambers().end();
-    for (; ch_eff3_it != ch_eff3_end; ++ch_eff3_it) {
-      DTChamberId ch = (*ch_eff3_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string efficiencyFolder = MainFolder + "Tests/DTChamberEfficiency/Wheel" + wheel.str();
-      string histo_name = efficiencyFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/yEfficiency_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->Draw();
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
+    if(!pageX.contents.empty()) thePages.push_back(pageX);
+    if(!pageY.contents.empty()) thePages.push_back(pageY);
   }
 
   // Test Pulses Summary Histos  **************************************************************
   if(TestPulsesHistos){
-    c1.Clear();
-    c1.Divide(4,3);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_TP_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_TP_end = muonGeom->chambers().end();
-    for (; ch_TP_it != ch_TP_end; ++ch_TP_it) {
-      DTChamberId ch = (*ch_TP_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      bool found = false;
-      vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_TP_it)->superLayers().begin(); 
-      vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_TP_it)->superLayers().end();
-      // Loop over the SLs
-      for(; sl_it != sl_end; ++sl_it) {
-	DTSuperLayerId sl = (*sl_it)->id();
-	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin(); 
-	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
-	stringstream superLayer; superLayer << sl.superlayer();
-	// Loop over the Ls
-	for(; l_it != l_end; ++l_it) {
-	  DTLayerId layerId = (*l_it)->id();
-	  stringstream layer; layer << layerId.layer();
-	  
-	  string testPulsesFolder = MainFolder + "DTTestPulsesTask/Wheel" + wheel.str();
-	  string histo_name = testPulsesFolder + "/Station" + station.str() + "/Sector" + sector.str() + "/SuperLayer" + superLayer.str() +  "/TPProfile/TestPulses2D_W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() + "_SL" + superLayer.str() + "_L" + layer.str();
-	  TProfile *histo = (TProfile*) theFile -> Get(histo_name.c_str());
-	  if(histo){
-	    found = true;
-	    int pad = (sl.superlayer() - 1)*4 + layerId.layer();
-	    c1.cd(pad);
-	    histo->Draw();
-	  }
-      }
-      }
-      if(found){
-	c1.Update();
-	psFile.NewPage();
-      }
-    }
+    addLayerPages("TestPulses", "Test pulses", "DTTestPulsesTask", "/TPProfile", "TestPulses2D");
   }
 
   // Trigger Summary Histos ************************************************************************
   if(TriggerHistos){
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
+    string taskFolder = MainFolder + "DTLocalTriggerTask";
+    string testFolder = MainFolder + "Tests/DTLocalTrigger";
+
+    SummaryPage stationPage;
+    stationPage.category = "Trigger";
+    stationPage.nx = 2;
+    stationPage.ny = 2;
+    vector<SummaryPage> stationPages(6, stationPage);
+    stationPages[0].title = "Phi BX vs quality";
+    stationPages[1].title = "Theta BX vs quality";
+    stationPages[2].title = "Phi efficiency vs position";
+    stationPages[3].title = "Phi efficiency vs angle";
+    stationPages[4].title = "Theta efficiency vs position";
+    stationPages[5].title = "Theta efficiency vs angle";
+
+    SummaryPage fractionPage;
+    fractionPage.category = "Trigger";
+    fractionPage.title = "Trigger fractions";
+    fractionPage.nx = 1;
+    fractionPage.ny = 2;
+    bool phiFraction = false;
+    bool thetaFraction = false;
+
     vector<DTChamber*>::const_iterator ch_trigger_it = muonGeom->chambers().begin();
     vector<DTChamber*>::const_iterator ch_trigger_end = muonGeom->chambers().end();
     for (; ch_trigger_it != ch_trigger_end; ++ch_trigger_it) {
       DTChamberId ch = (*ch_trigger_it)->id();
+      int pad = ch.station();
+      addToPad(stationPages[0], pad, triggerHistoName(taskFolder, ch, "LocalTriggerPhi/DDU_BXvsQual"));
+      addToPad(stationPages[1], pad, triggerHistoName(taskFolder, ch, "LocalTriggerTheta/DDU_ThetaBXvsQual"));
+      if(addToPad(stationPages[2], pad, triggerHistoName(testFolder, ch, "TrigEffPos_Phi"), "", true))
+	addToPad(stationPages[2], pad, triggerHistoName(testFolder, ch, "TrigEffPosHHHL_Phi"), "same");
+      addToPad(stationPages[3], pad, triggerHistoName(testFolder, ch, "TrigEffAngle_Phi"), "", true);
+      addToPad(stationPages[4], pad, triggerHistoName(testFolder, ch, "TrigEffPos_Theta"), "", true);
+      addToPad(stationPages[5], pad, triggerHistoName(testFolder, ch, "TrigEffAngle_Theta"), "", true);
+
+      // Only the first sector with the fractions is shown
       stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
       stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "DTLocalTriggerTask/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/LocalTriggerPhi/DDU_BXvsQual_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->Draw();
-      }
-    }
-    c1.Update();
-    psFile.NewPage();
-    
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger2_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger2_end = muonGeom->chambers().end();
-    for (; ch_trigger2_it != ch_trigger2_end; ++ch_trigger2_it) {
-      DTChamberId ch = (*ch_trigger2_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "DTLocalTriggerTask/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/LocalTriggerTheta/DDU_ThetaBXvsQual_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->Draw();
-      }
+      string sectorFolder = testFolder + "/Wheel" + wheel.str() + "/Sector" + sector.str();
+      string sectorTag = "_W" + wheel.str() + "_Sec" + sector.str();
+      if(!phiFraction)
+	phiFraction = addToPad(fractionPage, 1, sectorFolder + "/LocalTriggerPhi/CorrFraction_Phi" + sectorTag);
+      if(!thetaFraction)
+	thetaFraction = addToPad(fractionPage, 2, sectorFolder + "/LocalTriggerTheta/HFraction_Theta" + sectorTag);
     }
-    c1.Update();
-    psFile.NewPage();
-    
-    c1.Clear();
-    c1.Divide(1,2);
-    int counter1=0,counter2=0;
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger3_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger3_end = muonGeom->chambers().end();
-    for (; ch_trigger3_it != ch_trigger3_end; ++ch_trigger3_it) {
-      DTChamberId ch = (*ch_trigger3_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "Tests/DTLocalTrigger/Wheel" + wheel.str();
-      string histo_Name = triggerFolder + "/Sector" + sector.str() + "/LocalTriggerPhi/CorrFraction_Phi_W" +  wheel.str() + "_Sec" + sector.str();
-      TH1F *Histo1 = (TH1F*) theFile -> Get(histo_Name.c_str());
-      if(Histo1 && counter1==0){
-	counter1++;
-	c1.cd(1);
-	Histo1->Draw();
-      }
-      histo_Name = triggerFolder + "/Sector" + sector.str() + "/LocalTriggerTheta/HFraction_Theta_W" +  wheel.str() + "_Sec" + sector.str();
-      TH1F *Histo2 = (TH1F*) theFile -> Get(histo_Name.c_str());
-      if(Histo2 && counter2==0){
-	counter2++;
-	c1.cd(2);
-	Histo2->Draw();
-      }
+
+    if(!stationPages[0].contents.empty()) thePages.push_back(stationPages[0]);
+    if(!stationPages[1].contents.empty()) thePages.push_back(stationPages[1]);
+    if(!fractionPage.contents.empty()) thePages.push_back(fractionPage);
+    for(int page = 2; page < 6; ++page) {
+      if(!stationPages[page].contents.empty()) thePages.push_back(stationPages[page]);
     }
-    c1.Update();
-    psFile.NewPage();
-    
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger4_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger4_end = muonGeom->chambers().end();
-    for (; ch_trigger4_it != ch_trigger4_end; ++ch_trigger4_it) {
-      DTChamberId ch = (*ch_trigger4_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "Tests/DTLocalTrigger/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/TrigEffPos_Phi_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      string histo_nameHHHL = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/TrigEffPosHHHL_Phi_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histoHHHL = (TH1F*) theFile -> Get(histo_nameHHHL.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->GetYaxis()->SetRangeUser(0,1.1);
-	histo->Draw();
-	if(histoHHHL){
-		histoHHHL->Draw("same");
-	}
-      }
+  }
+
+}
+
+
+void DTCreateSummaryHistos::drawPage(const SummaryPage& page, TCanvas& canvas, TFile *file) const {
+
+  canvas.Clear();
+  canvas.Divide(page.nx, page.ny);
+  for(vector<PadContent>::const_iterator content = page.contents.begin();
+      content != page.contents.end(); ++content) {
+    TH1 *histo = (TH1*) file->Get(content->histoName.c_str());
+    if(!histo) continue;
+    canvas.cd(content->pad);
+    if(content->efficiencyRange) histo->GetYaxis()->SetRangeUser(0,1.1);
+    histo->Draw(content->option.c_str());
+  }
+  canvas.Update();
+
+}
+
+
+void DTCreateSummaryHistos::renderSerial(const string& fileName) {
+
+  TPostScript psFile(fileName.c_str(),111);
+  psFile.Range(20,26);
+  TCanvas c1("c1","",600,780);
+
+  TStopwatch timer;
+  for(unsigned int iPage = 0; iPage != thePages.size(); ++iPage) {
+    timer.Start();
+    drawPage(thePages[iPage], c1, theFile);
+    if(iPage + 1 != thePages.size()) psFile.NewPage();
+    edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos] page " << iPage << " (" << thePages[iPage].category
+				<< ": " << thePages[iPage].title << ") rendered in " << timer.RealTime() << " s";
+  }
+  psFile.Close();
+
+}
+
+
+void DTCreateSummaryHistos::renderParallel(const string& baseName) {
+
+  vector<string> pageFiles;
+  for(unsigned int iPage = 0; iPage != thePages.size(); ++iPage) {
+    char pageNumber[16];
+    sprintf(pageNumber, "_p%03d.", iPage);
+    pageFiles.push_back(baseName + pageNumber + pageFormat);
+  }
+
+  // The workers send the rendering time of each page through a pipe,
+  // the main process does all the logging
+  int timings[2];
+  if(pipe(timings) < 0) {
+    edm::LogError ("histos") << "[DTCreateSummaryHistos] cannot create the pipe of the workers, rendering serially";
+    renderSerial(baseName + ".ps");
+    return;
+  }
+
+  // Worker w renders the pages w, w+nWorkers, ...
+  vector<pid_t> workers;
+  for(int worker = 0; worker != nWorkers; ++worker) {
+    pid_t pid = fork();
+    if(pid < 0) {
+      edm::LogError ("histos") << "[DTCreateSummaryHistos] cannot start worker " << worker
+			       << ", its pages are rendered by the main process";
+      break;
     }
-    c1.Update();
-    psFile.NewPage();
-
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger5_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger5_end = muonGeom->chambers().end();
-    for (; ch_trigger5_it != ch_trigger5_end; ++ch_trigger5_it) {
-      DTChamberId ch = (*ch_trigger5_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "Tests/DTLocalTrigger/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/TrigEffAngle_Phi_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->GetYaxis()->SetRangeUser(0,1.1);
-	histo->Draw();
+    if(pid == 0) {
+      close(timings[0]);
+      // The file offset is shared with the parent: each worker opens its own file
+      TFile workerFile(rootFileName.c_str(), "READ");
+      TCanvas canvas("c1","",600,780);
+      TStopwatch timer;
+      for(unsigned int iPage = worker; iPage < thePages.size(); iPage += nWorkers) {
+	timer.Start();
+	drawPage(thePages[iPage], canvas, &workerFile);
+	canvas.Print(pageFiles[iPage].c_str());
+	// a record is smaller than PIPE_BUF: the writes of the workers do not mix
+	PageTiming timing = { int(iPage), worker, timer.RealTime() };
+	if(write(timings[1], &timing, sizeof(timing)) != sizeof(timing)) _exit(1);
       }
+      workerFile.Close();
+      _exit(0);
     }
-    c1.Update();
-    psFile.NewPage();
-    
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger6_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger6_end = muonGeom->chambers().end();
-    for (; ch_trigger6_it != ch_trigger6_end; ++ch_trigger6_it) {
-      DTChamberId ch = (*ch_trigger6_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "Tests/DTLocalTrigger/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/TrigEffPos_Theta_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	c1.cd(ch.station());
-	histo->GetYaxis()->SetRangeUser(0,1.1);
-	histo->Draw();
-      }
+    workers.push_back(pid);
+  }
+
+  // Log the page timings until all the workers have closed the pipe
+  close(timings[1]);
+  PageTiming timing;
+  while(read(timings[0], &timing, sizeof(timing)) == sizeof(timing)) {
+    edm::LogVerbatim ("histos") << "[DTCreateSummaryHistos] page " << timing.page << " (" << thePages[timing.page].category
+				<< ": " << thePages[timing.page].title << ") rendered by worker " << timing.worker
+				<< " in " << timing.seconds << " s";
+  }
+  close(timings[0]);
+
+  // Pages of the workers which could not be started
+  int nStarted = workers.size();
+  if(nStarted != nWorkers) {
+    TCanvas canvas("c1","",600,780);
+    for(unsigned int iPage = 0; iPage != thePages.size(); ++iPage) {
+      if(int(iPage % nWorkers) < nStarted) continue;
+      drawPage(thePages[iPage], canvas, theFile);
+      canvas.Print(pageFiles[iPage].c_str());
     }
-    c1.Update();
-    psFile.NewPage();
-
-    c1.Clear();
-    c1.Divide(2,2);
-    // Loop over all the chambers
-    vector<DTChamber*>::const_iterator ch_trigger7_it = muonGeom->chambers().begin();
-    vector<DTChamber*>::const_iterator ch_trigger7_end = muonGeom->chambers().end();
-    for (; ch_trigger7_it != ch_trigger7_end; ++ch_trigger7_it) {
-      DTChamberId ch = (*ch_trigger7_it)->id();
-      stringstream wheel; wheel << ch.wheel();
-      stringstream station; station << ch.station();
-      stringstream sector; sector << ch.sector();
-      
-      string triggerFolder = MainFolder + "Tests/DTLocalTrigger/Wheel" + wheel.str();
-      string histo_name = triggerFolder + "/Sector" + sector.str() + "/Station" + station.str() + "/TrigEffAngle_Theta_W" +  wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-      TH1F *histo = (TH1F*) theFile -> Get(histo_name.c_str());
-      if(histo){
-	histo->GetYaxis()->SetRangeUser(0,1.1);
-	c1.cd(ch.station());
-	histo->Draw();
-      }
+  }
+
+  bool allDone = true;
+  for(vector<pid_t>::const_iterator pid = workers.begin(); pid != workers.end(); ++pid) {
+    int status = 0;
+    if(waitpid(*pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      edm::LogError ("histos") << "[DTCreateSummaryHistos] worker " << *pid << " failed";
+      allDone = false;
     }
-    c1.Update();
   }
-  psFile.Close();
+
+  // Merge the pages in order
+  if(pageFormat != "pdf" || mergeCommand.empty()) return;
+  if(!allDone) {
+    edm::LogError ("histos") << "[DTCreateSummaryHistos] pages missing, " << baseName << ".pdf not written";
+    return;
+  }
+  string command = mergeCommand;
+  for(vector<string>::const_iterator page = pageFiles.begin(); page != pageFiles.end(); ++page) {
+    command += " " + *page;
+  }
+  command += " " + baseName + ".pdf";
+  if(system(command.c_str()) != 0) {
+    edm::LogError ("histos") << "[DTCreateSummaryHistos] merge failed: " << command;
+  }
+
 }
@@ -31,9 +31,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include "TPostScript.h"
 
 class DTGeometry;
+class TDirectory;
+class TCanvas;
 
 class DTCreateSummaryHistos: public edm::EDAnalyzer{
 
@@ -62,6 +65,52 @@ protected:
 
  private:
 
+  /// One histo drawn in a pad of a summary page
+  struct PadContent {
+    int pad;
+    std::string histoName;
+    std::string option;
+    bool efficiencyRange;
+  };
+
+  /// A summary page: canvas division and the histos of each pad
+  struct SummaryPage {
+    std::string category;
+    std::string title;
+    int nx;
+    int ny;
+    std::vector<PadContent> contents;
+  };
+
+  /// Walk the input file once and record the full path of every histo
+  void indexDirectory(TDirectory *dir, const std::string& path);
+
+  /// Is the histo in the input file?
+  bool inFile(const std::string& histoName) const;
+
+  /// Add a histo to a pad if it is in the input file. A draw without the "same"
+  /// option replaces what is already in the pad, as it would on the canvas
+  bool addToPad(SummaryPage& page, int pad, const std::string& histoName,
+		const std::string& option = "", bool efficiencyRange = false) const;
+
+  /// Build the list of pages of the enabled categories, in output order
+  void buildPages();
+
+  /// Helpers used by buildPages for the per-SL and per-layer layouts
+  void addSLPages(const std::string& category, const std::string& title,
+		  const std::string& folder, const std::string& subFolder, const std::string& prefix);
+  void addLayerPages(const std::string& category, const std::string& title,
+		     const std::string& folder, const std::string& subFolder, const std::string& prefix);
+
+  /// Draw one page on the canvas reading the histos from file
+  void drawPage(const SummaryPage& page, TCanvas& canvas, TFile *file) const;
+
+  /// Render all the pages in a single postscript file
+  void renderSerial(const std::string& fileName);
+
+  /// Render the pages in forked workers, one file per page, then merge them
+  void renderParallel(const std::string& baseName);
+
   int nevents;
   std::string MainFolder;
 
@@ -69,8 +118,15 @@ protected:
   edm::ESHandle<DTGeometry> muonGeom;
 
   // The file which contain the occupancy plot and the digi event plot
+  std::string rootFileName;
   TFile *theFile;
-  
+
+  // The full path of all the histos in the input file
+  std::set<std::string> theKeyIndex;
+
+  // The pages to render
+  std::vector<SummaryPage> thePages;
+
   // The *.ps file which contains the summary histos
   TPostScript *psFile;
   std::string PsFileName;
@@ -83,6 +139,11 @@ protected:
   bool EfficiencyHistos;
   bool TestPulsesHistos;
   bool TriggerHistos;
+
+  // Parallel rendering: number of worker processes, page format and merge command
+  int nWorkers;
+  std::string pageFormat;
+  std::string mergeCommand;
   
   // The DDUId
   int DDUId;
@@ -92,5 +153,3 @@ protected:
 };
 
 #endif
-  
-  
@@ -10,7 +10,8 @@
 
 
 #include "DQM/DTMonitorClient/src/DTDCSByLumiSummary.h"
-#include "DQM/DTMonitorModule/interface/DTTimeEvolutionHisto.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTTrendBuffer.h"
 
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Framework/interface/ESHandle.h"
@@ -27,10 +28,21 @@ using namespace std;
 using namespace edm;
 
 
-DTDCSByLumiSummary::DTDCSByLumiSummary(const ParameterSet& pset) {}
+DTDCSByLumiSummary::DTDCSByLumiSummary(const ParameterSet& pset) {
 
+  trendCapacity = pset.getUntrackedParameter<int>("trendCapacity", 5000);
 
-DTDCSByLumiSummary::~DTDCSByLumiSummary() {}
+}
+
+
+DTDCSByLumiSummary::~DTDCSByLumiSummary() {
+
+  for(vector<DTTrendBuffer*>::const_iterator trend = hDCSFracTrend.begin();
+      trend != hDCSFracTrend.end(); ++trend) {
+    delete *trend;
+  }
+
+}
 
 
 void DTDCSByLumiSummary::beginJob(){
@@ -55,6 +67,11 @@ void DTDCSByLumiSummary::beginJob(){
     FractionWh->setLumiFlag(); // set LumiFlag to DCS content value (save it by lumi)
 
     totalDCSFractionWh.push_back(FractionWh);
+
+    // trend plots, the range is set by the LS of the run
+    hDCSFracTrend.push_back(new DTTrendBuffer(theDQMStore, "hDCSFracTrendWh" + wheel_str.str(),
+					      "Fraction of DT-HV ON Wh" + wheel_str.str(),
+					      trendCapacity, 1, false));
   }
 
   globalHVSummary->Reset();
@@ -62,6 +79,17 @@ void DTDCSByLumiSummary::beginJob(){
 }
 
 
+void DTDCSByLumiSummary::beginRun(const edm::Run& run, const edm::EventSetup& setup) {
+
+  for(int wh=-2; wh<=2; wh++) {
+    hDCSFracTrend[wh+2]->reset();
+    goodLSperWh[wh+2] = 0;
+    badLSperWh[wh+2] = 0;
+  }
+
+}
+
+
 void DTDCSByLumiSummary::beginLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup) {
 
   // CB LumiFlag marked products are reset on LS boundaries
@@ -75,6 +103,7 @@ void DTDCSByLumiSummary::beginLuminosityBlock(const LuminosityBlock& lumi, const
 
 
 void DTDCSByLumiSummary::endLuminosityBlock(const LuminosityBlock&  lumi, const  EventSetup& setup){
+  DTClientPerformance::Timer timer("DTDCSByLumiSummary", DTClientPerformance::EndLumi);
 
   // Get the by lumi product plot from the task
   int lumiNumber = lumi.id().luminosityBlock();
@@ -113,65 +142,38 @@ void DTDCSByLumiSummary::endLuminosityBlock(const LuminosityBlock&  lumi, const
 
   } // end loop on wheels
 
-  if(!null_pointer_histo) dcsFracPerLumi[lumiNumber] = wh_activeFrac; // Fill map to be used to compute trend plots
-
-}
-
-
-void DTDCSByLumiSummary::endRun(const edm::Run& run, const edm::EventSetup& setup) {
-
-
-  // Book trend plots ME & loop on map to fill it with by lumi info
-  map<int,std::vector<float> >::const_iterator fracPerLumiIt  = dcsFracPerLumi.begin();
-  map<int,std::vector<float> >::const_iterator fracPerLumiEnd = dcsFracPerLumi.end();
-
-  int fLumi = dcsFracPerLumi.begin()->first;
-  int lLumi = dcsFracPerLumi.rbegin()->first;
-  theDQMStore->setCurrentFolder("DT/EventInfo/DCSContents");
-
-  int nLumis = lLumi-fLumi + 1.;
-
-  // trend plots
-  for(int wh=-2; wh<=2; wh++) {
-
-    stringstream wheel_str; wheel_str << wh;	
-
-    DTTimeEvolutionHisto* trend;
-
-    trend = new DTTimeEvolutionHisto(theDQMStore, "hDCSFracTrendWh" + wheel_str.str(), "Fraction of DT-HV ON Wh" + wheel_str.str(),
-        nLumis, fLumi, 1, false, 2);
-
-    hDCSFracTrend.push_back(trend);
-
-  }
-
-  float goodLSperWh[5] = {0,0,0,0,0}; 
-  float badLSperWh[5] = {0,0,0,0,0};
-
-  // fill trend plots and save infos for summaryPlot
-  for(;fracPerLumiIt!=fracPerLumiEnd;++fracPerLumiIt) {
+  if(!null_pointer_histo) { // fill the trend plots and count the good and bad LS for the summaryPlot
 
     for(int wh=-2; wh<=2; wh++) {
 
-      std::vector<float> activeFracPerWh;
-      activeFracPerWh =  fracPerLumiIt->second;
-
-      hDCSFracTrend[wh+2]->setTimeSlotValue(activeFracPerWh[wh+2],fracPerLumiIt->first);
+      hDCSFracTrend[wh+2]->append(lumiNumber, wh_activeFrac[wh+2]);
 
-      if( activeFracPerWh[wh+2] > 0 ) { // we do not count the lumi were the DTs are off (no real problem), 
+      if( wh_activeFrac[wh+2] > 0 ) { // we do not count the lumi were the DTs are off (no real problem), 
         // even if this can happen in the middle of a run (real problem: to be fixed)
-        if( activeFracPerWh[wh+2] > 0.9 ) goodLSperWh[wh+2]++;
+        if( wh_activeFrac[wh+2] > 0.9 ) goodLSperWh[wh+2]++;
         else { 
           badLSperWh[wh+2]++;
         }
       } else {  // there is no HV value OR all channels OFF
-        if( activeFracPerWh[wh+2] < 0 ) badLSperWh[wh+2]=-1;       // if there were no HV values, activeFrac returning -1
+        if( wh_activeFrac[wh+2] < 0 ) badLSperWh[wh+2]=-1;       // if there were no HV values, activeFrac returning -1
       }
 
     }
 
   }
 
+}
+
+
+void DTDCSByLumiSummary::endRun(const edm::Run& run, const edm::EventSetup& setup) {
+  DTClientPerformance::Timer timer("DTDCSByLumiSummary", DTClientPerformance::EndRun);
+
+
+  // copy the trend plots to their ME
+  for(int wh=-2; wh<=2; wh++) {
+    hDCSFracTrend[wh+2]->materialize();
+  }
+
   // fill summaryPlot
   for(int wh=-2; wh<=2; wh++) {
 
@@ -17,11 +17,11 @@
 
 #include <FWCore/Framework/interface/LuminosityBlock.h>
 
-#include <map>
+#include <vector>
 
 class DQMStore;
 class MonitorElement;
-class DTTimeEvolutionHisto;
+class DTTrendBuffer;
 
 class DTDCSByLumiSummary : public edm::EDAnalyzer {
 
@@ -38,6 +38,7 @@ private:
 
   // Operations
   virtual void beginJob();
+  virtual void beginRun(const edm::Run& run, const edm::EventSetup& setup);
   virtual void beginLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
   virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
   virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
@@ -49,10 +50,15 @@ private:
   MonitorElement*       totalDCSFraction;
   MonitorElement*       globalHVSummary;
 
-  std::vector<DTTimeEvolutionHisto*> hDCSFracTrend;
+  std::vector<DTTrendBuffer*> hDCSFracTrend;
   std::vector<MonitorElement*> totalDCSFractionWh;
-  
- std::map<int, std::vector<float> > dcsFracPerLumi;
+
+  // max # of LS in the trend plots
+  int trendCapacity;
+
+  // # of good and bad LS per wheel in the run
+  float goodLSperWh[5];
+  float badLSperWh[5];
 
 };
 
@@ -9,6 +9,8 @@
  */
 
 #include <DQM/DTMonitorClient/src/DTDataIntegrityTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
 
 //Framework
 #include "DataFormats/FEDRawData/interface/FEDNumbering.h"
@@ -33,6 +35,7 @@ DTDataIntegrityTest::DTDataIntegrityTest(const ParameterSet& ps) : nevents(0) {
 
   // prescale on the # of LS to update the test
   prescaleFactor = ps.getUntrackedParameter<int>("diagnosticPrescale", 1);
+  schedulerSlot = DTClientScheduler::instance().registerClient("DTDataIntegrityTest", DTEventCounters::Processed, prescaleFactor);
 
 
 }
@@ -103,17 +106,35 @@ void DTDataIntegrityTest::analyze(const Event& e, const EventSetup& context){
 
 
 void DTDataIntegrityTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTDataIntegrityTest", DTClientPerformance::EndLumi);
 
   // counts number of lumiSegs 
   nLumiSegs = lumiSeg.id().luminosityBlock();
   stringstream nLumiSegs_s; nLumiSegs_s << nLumiSegs;
   
-  // prescale factor
-  if (nLumiSegs%prescaleFactor != 0) return;
+  // prescale factor or scheduler decision
+  if (!DTClientScheduler::instance().runInLS(schedulerSlot, lumiSeg.run(), nLumiSegs, nLumiSegs)) return;
   
   LogTrace ("DTDQM|DTRawToDigi|DTMonitorClient|DTDataIntegrityTest")
     <<"[DTDataIntegrityTest]: End of LS " << nLumiSegs << ", performing client operations";
 
+  runClientDiagnostic();
+
+}
+
+
+
+void DTDataIntegrityTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTDataIntegrityTest", DTClientPerformance::EndRun);
+
+  if (DTClientScheduler::instance().pending(schedulerSlot)) runClientDiagnostic();
+
+}
+
+
+
+void DTDataIntegrityTest::runClientDiagnostic() {
+  DTClientScheduler::Execution execution(schedulerSlot);
 
   // counts number of updats 
   nupdates++;
@@ -55,6 +55,12 @@ protected:
   /// DQM Client Diagnostic
   void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& c);
 
+  /// EndRun: run the client operations if the last LS were skipped
+  void endRun(edm::Run const& run, edm::EventSetup const& c);
+
+  /// Fill the summaries from the FED histos
+  void runClientDiagnostic();
+
 private:
   int readOutToGeometry(int dduId, int rosNumber, int& wheel, int& sector);
 
@@ -65,6 +71,7 @@ private:
 
   // prescale on the # of LS to update the test
   int prescaleFactor;
+  int schedulerSlot;
 
 
   //Counter between 0 and nTimeBin
@@ -9,6 +9,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTDeadChannelTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/EventSetup.h>
@@ -20,9 +21,6 @@
 #include "Geometry/DTGeometry/interface/DTLayer.h"
 #include "Geometry/DTGeometry/interface/DTTopology.h"
 
-#include <CondFormats/DTObjects/interface/DTTtrig.h>
-#include <CondFormats/DataRecord/interface/DTTtrigRcd.h>
-
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -36,7 +34,9 @@ using namespace edm;
 using namespace std;
 
 
-DTDeadChannelTest::DTDeadChannelTest(const edm::ParameterSet& ps){
+DTDeadChannelTest::DTDeadChannelTest(const edm::ParameterSet& ps) :
+  conditions(DTConditionsSnapshot::TTrig), layerDiffHistos(DTConditionsSnapshot::nLayers,(MonitorElement*)0),
+  badChannelCollector(ps,"DTDeadChannelTest","deadChannel"), bookingPolicy(ps,"DTDeadChannelTest") {
  
   edm::LogVerbatim ("deadChannel") << "[DTDeadChannelTest]: Constructor";
 
@@ -46,6 +46,8 @@ DTDeadChannelTest::DTDeadChannelTest(const edm::ParameterSet& ps){
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 1);
 
+  occupancyDiffTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("OccupancyDiffTestName","OccupancyDiffInRange"));
+
 }
 
 DTDeadChannelTest::~DTDeadChannelTest(){
@@ -61,6 +63,8 @@ void DTDeadChannelTest::beginJob(){
 
   nevents = 0;
 
+  badChannelCollector.bookHistos(dbe,"DT/Tests/DTDeadChannel");
+
 }
 
 void DTDeadChannelTest::beginRun(Run const& run, EventSetup const& context) {
@@ -70,6 +74,17 @@ void DTDeadChannelTest::beginRun(Run const& run, EventSetup const& context) {
   // Get the geometry
   context.get<MuonGeometryRecord>().get(muonGeom);
 
+  // Input names are built once for all the LS
+  noiseHistoNames.clear();
+  inTimeHistoNames.clear();
+  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
+  for (; ch_it != ch_end; ++ch_it) {
+    DTChamberId chID = (*ch_it)->id();
+    noiseHistoNames.push_back(getMEName("OccupancyNoise_perCh", chID));
+    inTimeHistoNames.push_back(getMEName("OccupancyInTimeHits_perCh", chID));
+  }
+
 }
 
 
@@ -94,6 +109,7 @@ void DTDeadChannelTest::analyze(const edm::Event& e, const edm::EventSetup& cont
 
 
 void DTDeadChannelTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTDeadChannelTest", DTClientPerformance::EndLumi);
   
   // counts number of updats (online mode) or number of events (standalone mode)
   //nevents++;
@@ -114,72 +130,71 @@ void DTDeadChannelTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, Event
   edm::LogVerbatim ("deadChannel") <<"[DTDeadChannelTest]: "<<nLumiSegs<<" updates";
 
 
+  conditions.update(context,*muonGeom);
+
   vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
   vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
 
   edm::LogVerbatim ("deadChannel") << "[DTDeadChannelTest]: Occupancy tests results";
 
+  // tMax default value
+  const float tMax = 450.0;
+
   // Loop over the chambers
-  for (; ch_it != ch_end; ++ch_it) {
-    DTChamberId chID = (*ch_it)->id();
+  for (int iCh=0; ch_it != ch_end; ++ch_it, ++iCh) {
     vector<const DTSuperLayer*>::const_iterator sl_it = (*ch_it)->superLayers().begin(); 
     vector<const DTSuperLayer*>::const_iterator sl_end = (*ch_it)->superLayers().end();
 
-    stringstream wheel; wheel << chID.wheel();
-    stringstream station; station << chID.station();
-    stringstream sector; sector << chID.sector();
-    
-    context.get<DTTtrigRcd>().get(tTrigMap);
-
-    string HistoName = "W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str(); 
-
     // Get the ME produced by DigiTask Source
-    MonitorElement * noise_histo = dbe->get(getMEName("OccupancyNoise_perCh", chID));	
-    MonitorElement * hitInTime_histo = dbe->get(getMEName("OccupancyInTimeHits_perCh", chID));
+    MonitorElement * noise_histo = dbe->get(noiseHistoNames[iCh]);	
+    MonitorElement * hitInTime_histo = dbe->get(inTimeHistoNames[iCh]);
 
     // ME -> TH2F
     if(noise_histo && hitInTime_histo) {	  
       TH2F * noise_histo_root = noise_histo->getTH2F();
       TH2F * hitInTime_histo_root = hitInTime_histo->getTH2F();
 
+      // the layer MEs are booked once the chamber has digis (or up front with eagerBooking)
+      bool hasData = noise_histo_root->GetEntries() != 0 || hitInTime_histo_root->GetEntries() != 0;
+      const float * noiseBins = noise_histo_root->GetArray();
+      const float * inTimeBins = hitInTime_histo_root->GetArray();
+      const int noiseStride = noise_histo_root->GetNbinsX()+2;
+      const int inTimeStride = hitInTime_histo_root->GetNbinsX()+2;
+
       // Loop over the SuperLayers
       for(; sl_it != sl_end; ++sl_it) {
 	DTSuperLayerId slID = (*sl_it)->id();
 	vector<const DTLayer*>::const_iterator l_it = (*sl_it)->layers().begin();
 	vector<const DTLayer*>::const_iterator l_end = (*sl_it)->layers().end();
 	    
-        // ttrig and rms are counts
-	float tTrig, tTrigRMS, kFactor;
-	tTrigMap->get(slID, tTrig, tTrigRMS, kFactor, DTTimeUnits::counts);
+        // ttrig is in counts
+	const float tTrig = conditions.tTrig(slID);
       
+	int entry=-1;
+	if(slID.superlayer() == 1) entry=0;
+	if(slID.superlayer() == 2) entry=4;
+	if(slID.superlayer() == 3) entry=8;
+
 	// Loop over the layers
 	for(; l_it != l_end; ++l_it) {
 	  DTLayerId lID = (*l_it)->id();
 
-	  //Parameters to fill histos
-	  stringstream superLayer; superLayer << slID.superlayer();
-	  stringstream layer; layer << lID.layer();
-	  string HistoNameTest = "W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str() +  "_SL" + superLayer.str() +  "_L" + layer.str();
+	  const int firstWire = (*l_it)->specificTopology().firstChannel();
+	  const int lastWire = (*l_it)->specificTopology().lastChannel();
 
-	  const int firstWire = muonGeom->layer(lID)->specificTopology().firstChannel();
-	  const int lastWire = muonGeom->layer(lID)->specificTopology().lastChannel();
+	  MonitorElement *& diffHisto = layerDiffHistos[DTConditionsSnapshot::layerIndex(lID)];
+	  if (diffHisto == 0) {
+	    if (!bookingPolicy.materialize(lID.rawId(), hasData)) continue;
+	    diffHisto = bookHistos(lID, firstWire, lastWire);
+	  }
 
-	  int entry=-1;
-	  if(slID.superlayer() == 1) entry=0;
-	  if(slID.superlayer() == 2) entry=4;
-	  if(slID.superlayer() == 3) entry=8;
+	  // One pass over the layer row of the two TH2F
 	  int YBinNumber = entry+lID.layer();
-	      
-
-	  // Loop over the TH2F bin and fill the ME to be used for the Quality Test
-	  for(int bin=firstWire; bin <= lastWire; bin++) {
-	    if (OccupancyDiffHistos.find(HistoNameTest) == OccupancyDiffHistos.end()) bookHistos(lID, firstWire, lastWire);
-	    // tMax default value
-	    float tMax = 450.0;
-
-	    float difference = (hitInTime_histo_root->GetBinContent(bin, YBinNumber) / tMax) 
-			       - (noise_histo_root->GetBinContent(bin, YBinNumber) / tTrig);
-	    OccupancyDiffHistos.find(HistoNameTest)->second->setBinContent(bin, difference);
+	  const float * noiseRow = noiseBins + noiseStride*YBinNumber;
+	  const float * inTimeRow = inTimeBins + inTimeStride*YBinNumber;
+	  for(int wire=firstWire; wire <= lastWire; wire++) {
+	    float difference = (inTimeRow[wire] / tMax) - (noiseRow[wire] / tTrig);
+	    diffHisto->setBinContent(wire-firstWire+1, difference);
 	  }
 	} // loop on layers
       } // loop on superlayers
@@ -187,21 +202,15 @@ void DTDeadChannelTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, Event
   } // loop on chambers
 
   // Occupancy Difference test 
-  string OccupancyDiffCriterionName = parameters.getUntrackedParameter<string>("OccupancyDiffTestName","OccupancyDiffInRange"); 
-  for(map<string, MonitorElement*>::const_iterator hOccDiff = OccupancyDiffHistos.begin();
-      hOccDiff != OccupancyDiffHistos.end();
-      hOccDiff++) {
-    const QReport * theOccupancyDiffQReport = (*hOccDiff).second->getQReport(OccupancyDiffCriterionName);
-    if(theOccupancyDiffQReport) {
-      vector<dqm::me_util::Channel> badChannels = theOccupancyDiffQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	edm::LogError ("deadChannel") << "Layer : "<<(*hOccDiff).first<<" Bad occupancy difference channels: "<<(*channel).getBin()<<" Contents : "<<(*channel).getContents();
-      }
-      // FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-      // edm::LogWarning("deadChannel")<< "-------- Layer : "<<(*hOccDiff).first<<"  "<<theOccupancyDiffQReport->getMessage()<<" ------- "<<theOccupancyDiffQReport->getStatus(); 
-    }
+  badChannelCollector.beginCollection(nLumiSegs);
+  vector<DTLayer*>::const_iterator l_it = muonGeom->layers().begin();
+  vector<DTLayer*>::const_iterator l_end = muonGeom->layers().end();
+  for(; l_it != l_end; ++l_it) {
+    DTLayerId lID = (*l_it)->id();
+    MonitorElement * diffHisto = layerDiffHistos[DTConditionsSnapshot::layerIndex(lID)];
+    if(diffHisto) badChannelCollector.collect(diffHisto,occupancyDiffTest,lID.rawId());
   }
+  badChannelCollector.endCollection();
 
 }
 
@@ -209,6 +218,7 @@ void DTDeadChannelTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, Event
 void DTDeadChannelTest::endJob(){
 
   edm::LogVerbatim ("deadChannel") << "[DTDeadChannelTest] endjob called!";
+  bookingPolicy.report();
 
   dbe->rmdir("DT/Tests/DTDeadChannel");
 
@@ -237,7 +247,7 @@ string DTDeadChannelTest::getMEName(string histoTag, const DTChamberId & chId) {
 }
 
 
-void DTDeadChannelTest::bookHistos(const DTLayerId & lId, int firstWire, int lastWire) {
+MonitorElement* DTDeadChannelTest::bookHistos(const DTLayerId & lId, int firstWire, int lastWire) {
 
   stringstream wheel; wheel << lId.superlayerId().wheel();
   stringstream station; station << lId.superlayerId().station();	
@@ -252,6 +262,11 @@ void DTDeadChannelTest::bookHistos(const DTLayerId & lId, int firstWire, int las
 			   "/Station" + station.str() +
 			   "/Sector" + sector.str());
 
-  OccupancyDiffHistos[HistoName] = dbe->book1D(OccupancyDiffHistoName.c_str(),OccupancyDiffHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5);
+  MonitorElement* me = bookingPolicy.booked(dbe->book1D(OccupancyDiffHistoName.c_str(),OccupancyDiffHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5));
+  OccupancyDiffHistos[HistoName] = me;
+
+  return me;
 
 }
+
+
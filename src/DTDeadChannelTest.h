@@ -26,6 +26,10 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+#include "DQM/DTMonitorClient/src/DTBookingPolicy.h"
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
+
 
 #include <memory>
 #include <iostream>
@@ -38,7 +42,6 @@ class DTGeometry;
 class DTChamberId;
 class DTSuperLayerId;
 class DTLayerId;
-class DTTtrig;
 
 class DTDeadChannelTest: public edm::EDAnalyzer{
 
@@ -65,7 +68,7 @@ protected:
   void endJob();
 
   /// book the new ME
-  void bookHistos(const DTLayerId & ch, int firstWire, int lastWire);
+  MonitorElement* bookHistos(const DTLayerId & ch, int firstWire, int lastWire);
 
   /// Get the ME name
   std::string getMEName(std::string histoTag, const DTChamberId & chId);
@@ -79,6 +82,7 @@ protected:
 
 
 
+
 private:
 
   int nevents;
@@ -90,9 +94,17 @@ private:
 
   edm::ParameterSet parameters;
   edm::ESHandle<DTGeometry> muonGeom;
-  edm::ESHandle<DTTtrig> tTrigMap;
 
   std::map< std::string , MonitorElement* > OccupancyDiffHistos;
+
+  DTConditionsSnapshot conditions;
+  std::vector<MonitorElement*> layerDiffHistos; // OccupancyDiff MEs by DTConditionsSnapshot::layerIndex
+  std::vector<std::string> noiseHistoNames;     // input names, same order as the geometry chambers
+  std::vector<std::string> inTimeHistoNames;
+
+  DTBadChannelCollector badChannelCollector;
+  DTBookingPolicy bookingPolicy;
+  int occupancyDiffTest;
   
 };
 
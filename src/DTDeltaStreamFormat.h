@@ -0,0 +1,61 @@
+#ifndef DTDeltaStreamFormat_H
+#define DTDeltaStreamFormat_H
+
+/** \file
+ *  Binary format of the per LS delta log of the client results written by
+ *  DTDeltaStreamWriter and read back by test/dtDeltaStreamReplay.
+ *  All the fields are in host byte order.
+ *
+ *    file header : magic "DTDL" (u32), version (u32)
+ *    blocks      : type (u8) + payload
+ *      Definition: ME id (u16), nBinsX (u16), nBinsY (u16), name length (u16), name
+ *      KeyFrame/Delta: run (u32), LS (u32), # MEs (u16), then for each ME:
+ *                  ME id (u16), # bins (u16), # bins x (bin (u16), value (f32))
+ *    index       : magic "DTDX" (u32), # entries (u32),
+ *                  # entries x (type (u8), run (u32), LS (u32), offset (u64))
+ *    trailer     : index offset (u64), magic "DTDX" (u32)
+ *
+ *  The bins are numbered (binX-1) + (binY-1)*nBinsX: for the wheel summaries
+ *  (sector x station) this is the dense chamber index in the wheel.
+ *  A KeyFrame holds all the non-empty bins and resets the state, a Delta only
+ *  the bins changed since the previous block. Each run starts with a KeyFrame.
+ *  The index is written at the end of the job: without it the file can
+ *  still be read sequentially.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <stdint.h>
+#include <iostream>
+
+namespace DTDeltaStream {
+
+  const uint32_t fileMagic = 0x4C445444;    // "DTDL"
+  const uint32_t indexMagic = 0x58445444;   // "DTDX"
+  const uint32_t version = 1;
+
+  enum BlockType { Definition = 1, KeyFrame = 2, Delta = 3 };
+
+  /// Size of the trailer at the end of the file
+  const int trailerSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+  /// Index entry of a block
+  struct IndexEntry {
+    uint8_t type;
+    uint32_t run;
+    uint32_t lumi;
+    uint64_t offset;
+  };
+
+  /// Write/read a field
+  template <class T> inline void put(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <class T> inline bool get(std::istream& in, T& value) {
+    return in.read(reinterpret_cast<char*>(&value), sizeof(T)).good();
+  }
+
+}
+
+#endif
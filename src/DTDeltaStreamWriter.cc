@@ -0,0 +1,206 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTDeltaStreamWriter.h"
+
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace edm;
+using namespace DTDeltaStream;
+
+
+DTDeltaStreamWriter::DTDeltaStreamWriter(const ParameterSet& pset) :
+  theRun(0), theLumi(0), theBlocksSinceKeyFrame(0), theBinsWritten(0) {
+
+  theFileName = pset.getUntrackedParameter<string>("fileName", "DTClientDeltas.dtdl");
+  // a full copy of the MEs every keyFrameInterval blocks bounds the replay time
+  theKeyFrameInterval = pset.getUntrackedParameter<int>("keyFrameInterval", 100);
+
+  // full DQM paths of the archived MEs (the ME id is the position in the list)
+  vector<string> names = pset.getUntrackedParameter<vector<string> >("monitorElements");
+  if(names.size() > 0xffff) names.resize(0xffff);
+  for(vector<string>::const_iterator name = names.begin(); name != names.end(); ++name) {
+    TrackedME me;
+    me.name = *name;
+    me.defined = false;
+    me.nBinsX = 0;
+    me.nBinsY = 0;
+    theMEs.push_back(me);
+  }
+
+}
+
+
+
+
+DTDeltaStreamWriter::~DTDeltaStreamWriter() {}
+
+
+
+void DTDeltaStreamWriter::beginJob(){
+  // get the DQMStore
+  theDbe = Service<DQMStore>().operator->();
+
+  theFile.open(theFileName.c_str(), ios::out | ios::binary | ios::trunc);
+  if(!theFile) {
+    LogError("DTDQM|DTMonitorClient|DTDeltaStreamWriter")
+      << "Cannot open " << theFileName << ", the client results are not archived";
+    return;
+  }
+  put(theFile, fileMagic);
+  put(theFile, version);
+
+}
+
+
+
+void DTDeltaStreamWriter::analyze(const Event& event, const EventSetup& setup){}
+
+
+
+void DTDeltaStreamWriter::endLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup) {
+
+  update(lumi.run(), lumi.id().luminosityBlock());
+
+}
+
+
+
+void DTDeltaStreamWriter::endRun(const Run& run, const EventSetup& setup) {
+
+  // the end of run results are archived with the last LS
+  update(run.run(), run.run() == theRun ? theLumi : 0);
+
+}
+
+
+
+void DTDeltaStreamWriter::endJob() {
+
+  if(!theFile.is_open()) return;
+
+  uint64_t indexOffset = theFile.tellp();
+  put(theFile, indexMagic);
+  put(theFile, uint32_t(theIndex.size()));
+  for(vector<IndexEntry>::const_iterator entry = theIndex.begin(); entry != theIndex.end(); ++entry) {
+    put(theFile, (*entry).type);
+    put(theFile, (*entry).run);
+    put(theFile, (*entry).lumi);
+    put(theFile, (*entry).offset);
+  }
+  put(theFile, indexOffset);
+  put(theFile, indexMagic);
+  long fileSize = theFile.tellp();
+  theFile.close();
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTDeltaStreamWriter")
+    << "[DTDeltaStreamWriter]: " << theIndex.size() << " blocks, " << theBinsWritten
+    << " bins archived in " << theFileName << " (" << fileSize/1024. << " kB)";
+
+}
+
+
+
+void DTDeltaStreamWriter::update(uint32_t run, uint32_t lumi) {
+
+  if(!theFile.is_open()) return;
+
+  // each run starts from a key frame
+  bool keyFrame = run != theRun || theBlocksSinceKeyFrame >= theKeyFrameInterval;
+  theRun = run;
+  theLumi = lumi;
+
+  ostringstream block(ios::out | ios::binary);
+  uint16_t nMEs = 0;
+  for(unsigned int iME = 0; iME != theMEs.size(); ++iME) {
+    TrackedME& tracked = theMEs[iME];
+    MonitorElement *me = theDbe->get(tracked.name);
+    if(me == 0) continue;
+
+    if(!tracked.defined) {
+      // the binning is fixed at the first update that finds the ME
+      tracked.defined = true;
+      tracked.nBinsX = me->getNbinsX();
+      tracked.nBinsY = max(me->getNbinsY(), 1);
+      if(tracked.nBinsX*tracked.nBinsY > 0xffff) {
+	LogWarning("DTDQM|DTMonitorClient|DTDeltaStreamWriter")
+	  << tracked.name << " has too many bins, not archived";
+	tracked.nBinsX = 0;
+      }
+      tracked.values.assign(tracked.nBinsX*tracked.nBinsY, 0.);
+      addToIndex(Definition, 0, 0);
+      put(theFile, uint8_t(Definition));
+      put(theFile, uint16_t(iME));
+      put(theFile, uint16_t(tracked.nBinsX));
+      put(theFile, uint16_t(tracked.nBinsY));
+      put(theFile, uint16_t(tracked.name.size()));
+      theFile.write(tracked.name.c_str(), tracked.name.size());
+    }
+
+    vector<uint16_t> bins;
+    vector<float> values;
+    for(int binY = 1; binY <= tracked.nBinsY; ++binY) {
+      for(int binX = 1; binX <= tracked.nBinsX; ++binX) {
+	int bin = (binX-1) + (binY-1)*tracked.nBinsX;
+	float value = me->getBinContent(binX, binY);
+	if(keyFrame ? value != 0 : value != tracked.values[bin]) {
+	  bins.push_back(bin);
+	  values.push_back(value);
+	}
+	tracked.values[bin] = value;
+      }
+    }
+    if(bins.empty()) continue;
+
+    put(block, uint16_t(iME));
+    put(block, uint16_t(bins.size()));
+    for(unsigned int iBin = 0; iBin != bins.size(); ++iBin) {
+      put(block, bins[iBin]);
+      put(block, values[iBin]);
+    }
+    theBinsWritten += bins.size();
+    ++nMEs;
+  }
+
+  // an unchanged LS is not written: its state is the one of the previous block
+  if(!keyFrame && nMEs == 0) return;
+
+  BlockType type = keyFrame ? KeyFrame : Delta;
+  addToIndex(type, run, lumi);
+  put(theFile, uint8_t(type));
+  put(theFile, run);
+  put(theFile, lumi);
+  put(theFile, nMEs);
+  string payload = block.str();
+  theFile.write(payload.data(), payload.size());
+  theFile.flush();
+
+  theBlocksSinceKeyFrame = keyFrame ? 0 : theBlocksSinceKeyFrame+1;
+
+}
+
+
+
+void DTDeltaStreamWriter::addToIndex(BlockType type, uint32_t run, uint32_t lumi) {
+
+  IndexEntry entry;
+  entry.type = type;
+  entry.run = run;
+  entry.lumi = lumi;
+  entry.offset = theFile.tellp();
+  theIndex.push_back(entry);
+
+}
@@ -0,0 +1,75 @@
+#ifndef DTMonitorClient_DTDeltaStreamWriter_H
+#define DTMonitorClient_DTDeltaStreamWriter_H
+
+/** \class DTDeltaStreamWriter
+ *  Archives the client results LS by LS: at the end of each LS and run the
+ *  bins of the configured MEs (summaries, per chamber result maps) that
+ *  changed since the previous update are appended to a compact binary
+ *  log (see DTDeltaStreamFormat.h), with periodic key frames and an index
+ *  for random access. test/dtDeltaStreamReplay rebuilds the state at any LS.
+ *  To see the results of all the clients it has to be put at the end of
+ *  the client sequence.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "DQM/DTMonitorClient/src/DTDeltaStreamFormat.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+class DQMStore;
+
+class DTDeltaStreamWriter : public edm::EDAnalyzer {
+public:
+  /// Constructor
+  DTDeltaStreamWriter(const edm::ParameterSet& pset);
+
+  /// Destructor
+  virtual ~DTDeltaStreamWriter();
+
+private:
+  virtual void beginJob();
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
+  virtual void endRun(const edm::Run& run, const edm::EventSetup& setup);
+  virtual void endJob();
+
+  /// Append the changes of the MEs since the last update
+  void update(uint32_t run, uint32_t lumi);
+
+  /// Add a block to the index
+  void addToIndex(DTDeltaStream::BlockType type, uint32_t run, uint32_t lumi);
+
+  /// An archived ME and its last written content
+  struct TrackedME {
+    std::string name;
+    bool defined;
+    int nBinsX;
+    int nBinsY;
+    std::vector<float> values;
+  };
+
+  DQMStore *theDbe;
+
+  std::string theFileName;
+  std::ofstream theFile;
+  int theKeyFrameInterval;
+
+  std::vector<TrackedME> theMEs;
+  std::vector<DTDeltaStream::IndexEntry> theIndex;
+
+  uint32_t theRun;
+  uint32_t theLumi;
+  int theBlocksSinceKeyFrame;
+  long theBinsWritten;
+
+};
+
+
+#endif
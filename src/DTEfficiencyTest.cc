@@ -10,6 +10,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTEfficiencyTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/EventSetup.h>
@@ -33,7 +34,8 @@
 using namespace edm;
 using namespace std;
 
-DTEfficiencyTest::DTEfficiencyTest(const edm::ParameterSet& ps){
+DTEfficiencyTest::DTEfficiencyTest(const edm::ParameterSet& ps) :
+  badChannelCollector(ps,"DTEfficiencyTest","efficiency"), bookingPolicy(ps,"DTEfficiencyTest") {
 
   edm::LogVerbatim ("efficiency") << "[DTEfficiencyTest]: Constructor";
 
@@ -45,6 +47,9 @@ DTEfficiencyTest::DTEfficiencyTest(const edm::ParameterSet& ps){
 
   percentual = parameters.getUntrackedParameter<int>("BadSLpercentual", 10);
 
+  efficiencyTest      = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("EfficiencyTestName","EfficiencyInRange"));
+  unassEfficiencyTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("UnassEfficiencyTestName","UnassEfficiencyInRange"));
+
 }
 
 DTEfficiencyTest::~DTEfficiencyTest(){
@@ -60,6 +65,8 @@ void DTEfficiencyTest::beginJob(){
 
   nevents = 0;
 
+  badChannelCollector.bookHistos(dbe,"DT/Tests/DTEfficiency/SummaryPlot");
+
 }
 
 void DTEfficiencyTest::beginRun(Run const& run, EventSetup const& context) {
@@ -87,6 +94,7 @@ void DTEfficiencyTest::analyze(const edm::Event& e, const edm::EventSetup& conte
 
 
 void DTEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTEfficiencyTest", DTClientPerformance::EndLumi);
   
   // counts number of updats (online mode) or number of events (standalone mode)
   //nevents++;
@@ -188,6 +196,12 @@ void DTEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 	  const int firstWire = muonGeom->layer(lID)->specificTopology().firstChannel();
 	  const int lastWire = muonGeom->layer(lID)->specificTopology().lastChannel();
 
+	  // the layer MEs are booked once the layer has segments (or up front with eagerBooking)
+	  if (EfficiencyHistos.find(lID) == EfficiencyHistos.end()) {
+	    if (!bookingPolicy.materialize(lID.rawId(), recSegmOccupancy_histo_root->GetEntries() != 0)) continue;
+	    bookHistos(lID, firstWire, lastWire);
+	  }
+
 	  // Loop over the TH1F bin and fill the ME to be used for the Quality Test
 	  for(int bin=firstWire; bin <= lastWire; bin++) {
 	    if((recSegmOccupancy_histo_root->GetBinContent(bin))!=0) {
@@ -214,23 +228,14 @@ void DTEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 
   // Efficiency test 
   //cout<<"[DTEfficiencyTest]: Efficiency Tests results"<<endl;
-  string EfficiencyCriterionName = parameters.getUntrackedParameter<string>("EfficiencyTestName","EfficiencyInRange"); 
+  badChannelCollector.beginCollection(nLumiSegs);
   for(map<DTLayerId, MonitorElement*>::const_iterator hEff = EfficiencyHistos.begin();
       hEff != EfficiencyHistos.end();
       hEff++) {
-    const QReport * theEfficiencyQReport = (*hEff).second->getQReport(EfficiencyCriterionName);
-    double counter=0;
-    if(theEfficiencyQReport) {
-      vector<dqm::me_util::Channel> badChannels = theEfficiencyQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	edm::LogError ("efficiency") <<"LayerID : "<<getMEName("hEffOccupancy",(*hEff).first)<< " Bad efficiency channels: "<<(*channel).getBin()<<"  Contents : "<<(*channel).getContents();
-	counter++;
-      }
+    double counter = badChannelCollector.collect((*hEff).second,efficiencyTest,(*hEff).first.rawId()).size();
+    if(badChannelCollector.foundQReport()) {
       LayerBadCells[(*hEff).first].push_back(counter);
       LayerBadCells[(*hEff).first].push_back(muonGeom->layer((*hEff).first)->specificTopology().channels());
-      // FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-      // edm::LogWarning ("efficiency") << "-------- "<<theEfficiencyQReport->getMessage()<<" ------- "<<theEfficiencyQReport->getStatus();
     }
   }
 
@@ -238,25 +243,16 @@ void DTEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 	
   // UnassEfficiency test 
   //cout<<"[DTEfficiencyTest]: UnassEfficiency Tests results"<<endl;
-  string UnassEfficiencyCriterionName = parameters.getUntrackedParameter<string>("UnassEfficiencyTestName","UnassEfficiencyInRange"); 
   for(map<DTLayerId, MonitorElement*>::const_iterator hUnassEff = UnassEfficiencyHistos.begin();
       hUnassEff != UnassEfficiencyHistos.end();
       hUnassEff++) {
-    const QReport * theUnassEfficiencyQReport = (*hUnassEff).second->getQReport(UnassEfficiencyCriterionName);
-    double counter=0;
-    if(theUnassEfficiencyQReport) {
-      vector<dqm::me_util::Channel> badChannels = theUnassEfficiencyQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	edm::LogError ("efficiency") << "Bad unassEfficiency channels: "<<(*channel).getBin()<<" "<<(*channel).getContents();
-	counter++;
-      }
+    double counter = badChannelCollector.collect((*hUnassEff).second,unassEfficiencyTest,(*hUnassEff).first.rawId()).size();
+    if(badChannelCollector.foundQReport()) {
       LayerUnassBadCells[(*hUnassEff).first].push_back(counter);
       LayerUnassBadCells[(*hUnassEff).first].push_back(double(muonGeom->layer((*hUnassEff).first)->specificTopology().channels()));
-      // FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-      // edm::LogWarning ("efficiency") << theUnassEfficiencyQReport->getMessage()<<" ------- "<<theUnassEfficiencyQReport->getStatus();
     }
   }
+  badChannelCollector.endCollection();
 
   
   vector<DTChamber*>::const_iterator ch2_it = muonGeom->chambers().begin();
@@ -353,6 +349,7 @@ void DTEfficiencyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 void DTEfficiencyTest::endJob(){
 
   edm::LogVerbatim ("efficiency") << "[DTEfficiencyTest] endjob called!";
+  bookingPolicy.report();
 
   dbe->rmdir("DT/Tests/DTEfficiency");
 
@@ -402,8 +399,8 @@ void DTEfficiencyTest::bookHistos(const DTLayerId & lId, int firstWire, int last
 			   "/Station" + station.str() +
 			   "/Sector" + sector.str());
 
-  EfficiencyHistos[lId] = dbe->book1D(EfficiencyHistoName.c_str(),EfficiencyHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5);
-  UnassEfficiencyHistos[lId] = dbe->book1D(UnassEfficiencyHistoName.c_str(),UnassEfficiencyHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5);
+  EfficiencyHistos[lId] = bookingPolicy.booked(dbe->book1D(EfficiencyHistoName.c_str(),EfficiencyHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5));
+  UnassEfficiencyHistos[lId] = bookingPolicy.booked(dbe->book1D(UnassEfficiencyHistoName.c_str(),UnassEfficiencyHistoName.c_str(),lastWire-firstWire+1, firstWire-0.5, lastWire+0.5));
 
 }
 
@@ -26,6 +26,9 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+#include "DQM/DTMonitorClient/src/DTBookingPolicy.h"
+
 
 #include <memory>
 #include <iostream>
@@ -96,6 +99,11 @@ private:
   std::map< DTLayerId , MonitorElement* > EfficiencyHistos;
   std::map< DTLayerId , MonitorElement* > UnassEfficiencyHistos;
 
+  DTBadChannelCollector badChannelCollector;
+  DTBookingPolicy bookingPolicy;
+  int efficiencyTest;
+  int unassEfficiencyTest;
+
   // wheel summary histograms  
   std::map< int, MonitorElement* > wheelHistos;  
   std::map< int, MonitorElement* > wheelUnassHistos;
@@ -0,0 +1,98 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+using namespace std;
+
+
+DTEventCounters::DTEventCounters() : theRun(-1), theLumi(-1) {
+
+  for(int stream = 0; stream != nStreams; ++stream) {
+    theFound[stream] = false;
+    theEvents[stream] = 0;
+    theEventsInLS[stream] = 0;
+  }
+
+}
+
+
+DTEventCounters& DTEventCounters::instance() {
+
+  static DTEventCounters counters;
+  return counters;
+
+}
+
+
+const DTEventCounters& DTEventCounters::get(DQMStore* dbe, int run, int lumi) {
+
+  DTEventCounters& counters = instance();
+
+  // after the end of run read the values are final for all the LS of the run
+  if(run != counters.theRun || (lumi != counters.theLumi && counters.theLumi != endOfRun)) {
+    counters.read(dbe, run, lumi);
+  }
+
+  return counters;
+
+}
+
+
+const DTEventCounters& DTEventCounters::refresh(DQMStore* dbe, int run) {
+
+  DTEventCounters& counters = instance();
+  counters.read(dbe, run, endOfRun);
+  return counters;
+
+}
+
+
+const string& DTEventCounters::meName(Stream stream) {
+
+  static const string names[nStreams] = { "DT/EventInfo/Counters/nProcessedEventsDigi",
+					  "DT/EventInfo/Counters/nProcessedEventsNoise",
+					  "DT/EventInfo/Counters/nProcessedEventsSegment",
+					  "DT/EventInfo/Counters/nProcessedEventsTrigger",
+					  "DT/EventInfo/processedEvents" };
+  return names[stream];
+
+}
+
+
+void DTEventCounters::read(DQMStore* dbe, int run, int lumi) {
+
+  // the counters restart with the run
+  bool newRun = (run != theRun);
+  // a new read of the same LS keeps the counts of the previous LS as reference
+  bool sameLumi = !newRun && lumi == theLumi;
+
+  for(int stream = 0; stream != nStreams; ++stream) {
+    int prevEvents = newRun ? 0 : theEvents[stream] - (sameLumi ? theEventsInLS[stream] : 0);
+    MonitorElement* me = dbe->get(meName(Stream(stream)));
+    theFound[stream] = (me != 0);
+    if(me) {
+      // the source counters are float MEs, processedEvents is an int ME
+      theEvents[stream] = (stream == Processed) ? me->getIntValue() : int(me->getFloatValue());
+    } else {
+      theEvents[stream] = prevEvents;
+    }
+    theEventsInLS[stream] = theEvents[stream] - prevEvents;
+  }
+
+  theRun = run;
+  theLumi = lumi;
+
+  LogTrace("DTDQM|DTMonitorClient|DTEventCounters") << "[DTEventCounters]: run " << run << " LS " << lumi
+						    << " processed events: " << theEvents[Processed]
+						    << " (" << theEventsInLS[Processed] << " in LS)";
+
+}
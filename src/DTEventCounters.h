@@ -0,0 +1,71 @@
+#ifndef DTEventCounters_H
+#define DTEventCounters_H
+
+/** \class DTEventCounters
+ *  Per LS accounting of the events processed by the DT DQM sources.
+ *  The counters in DT/EventInfo are read from the DQMStore once per
+ *  (run, LS) and shared by all the clients in the job: the first client
+ *  asking for a new LS triggers the read, the others get the cached values.
+ *  Both the cumulative counts and the counts since the previous LS are
+ *  available for each stream. At end of run the counters can be updated
+ *  after the last LS (e.g. in harvesting), so the end of run clients call
+ *  refresh: the values read then are used for the rest of the run.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <string>
+
+class DQMStore;
+
+class DTEventCounters {
+
+public:
+
+  /// The event counters filled by the sources
+  enum Stream { Digi = 0, Noise, Segment, Trigger, Processed, nStreams };
+
+  /// Get the counters for the given run and LS (read them if not yet done)
+  static const DTEventCounters& get(DQMStore* dbe, int run, int lumi);
+
+  /// Read again the counters at end of run
+  static const DTEventCounters& refresh(DQMStore* dbe, int run);
+
+  /// Name of the ME holding the counter of a stream
+  static const std::string& meName(Stream stream);
+
+  /// True if the counter ME of the stream was found
+  bool found(Stream stream) const { return theFound[stream]; };
+
+  /// Cumulative # of events of the stream
+  int events(Stream stream) const { return theEvents[stream]; };
+
+  /// # of events of the stream since the previous LS
+  int eventsInLS(Stream stream) const { return theEventsInLS[stream]; };
+
+  /// Run and LS of the last read
+  int run() const { return theRun; };
+  int lumi() const { return theLumi; };
+
+private:
+
+  DTEventCounters();
+
+  static DTEventCounters& instance();
+
+  /// Key of the read done at end of run
+  static const int endOfRun = -2;
+
+  void read(DQMStore* dbe, int run, int lumi);
+
+  int theRun;
+  int theLumi;
+
+  bool theFound[nStreams];
+  int theEvents[nStreams];
+  int theEventsInLS[nStreams];
+
+};
+
+#endif
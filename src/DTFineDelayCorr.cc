@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTFineDelayCorr.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -42,7 +43,9 @@ using namespace std;
 #include <vector>
 #include <map>
 
-DTFineDelayCorr::DTFineDelayCorr(const ParameterSet& ps) {
+DTFineDelayCorr::DTFineDelayCorr(const ParameterSet& ps) :
+  worstPhaseMap(DTConditionsSnapshot::TPGParameters),
+  calibRecorder(ps,"DTFineDelayCorr") {
 
   setConfig(ps,"DTFineDelayCorr");  // sets parameter values and name used in log file 
   baseFolderDCC = "DT/90-LocalTriggerSynch/";
@@ -68,6 +71,8 @@ void DTFineDelayCorr::beginJob(){
   oldDelaysInputFile = parameters.getParameter<string>("oldDelaysInputFile"),
   // Write new delays to file or to Db
   writeDB = parameters.getParameter<bool>("writeDB");
+  // Write the new delays file in binary format
+  binaryOutput = parameters.getUntrackedParameter<bool>("binaryOutput",false);
   // Output File Name
   outputFileName = parameters.getParameter<string>("outputFile");
   // Choose to use Hist Mean or Gaussian Fit Mean
@@ -75,41 +80,24 @@ void DTFineDelayCorr::beginJob(){
   // Require Minimum Number Of Entries in the t0Mean Histogram
   minEntries =  parameters.getUntrackedParameter<int>("minEntries",5);
 
+  // Old delays are read once (text or binary file)
+  if(!readOldFromDb) oldDelays.read(oldDelaysInputFile);
+
 }
 
 void DTFineDelayCorr::beginRun(const Run& run, const EventSetup& evSU){
 
   DTLocalTriggerBaseTest::beginRun(run,evSU);
   evSU.get< DTConfigManagerRcd >().get(dtConfig);
-  evSU.get< DTTPGParametersRcd >().get(worstPhaseMap);
+  worstPhaseMap.update(evSU,*muonGeom);
 
 }
 
 void DTFineDelayCorr::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTFineDelayCorr", DTClientPerformance::Diagnostic);
+
   int coarseDelay = -999;
   float oldFineDelay = -999;
-  if(!readOldFromDb) { // read old delays from txt file
-    // **  Open and read old delays input file  ** 
-    ifstream oldDelaysFile(oldDelaysInputFile.c_str());
-    string line;
-
-    while (getline(oldDelaysFile, line)) {
-      if( line == "" || line[0] == '#' ) continue; 
-      stringstream linestr;
-      int wheelKey,sectorKey, stationKey;      
-      linestr << line;
-      
-      linestr >> wheelKey
-	      >> sectorKey
-	      >> stationKey
-	      >> coarseDelay
-	      >> oldFineDelay;
-      
-      pair<int,float> oldDelays = make_pair(coarseDelay,oldFineDelay);
-      DTChamberId oldDelayKey = DTChamberId(wheelKey,stationKey,sectorKey);
-      oldDelayMap.insert(make_pair(oldDelayKey,oldDelays));
-    }
-  }
 
   //  ** Loop over the chambers ** 
   vector<DTChamber*>::const_iterator chambIt  = muonGeom->chambers().begin();
@@ -117,12 +105,8 @@ void DTFineDelayCorr::runClientDiagnostic() {
   for (; chambIt!=chambEnd; ++chambIt) { 
     DTChamberId chId = (*chambIt)->id();
     uint32_t indexCh = chId.rawId();
-    int wheel = chId.wheel();
-    int sector = chId.sector();
-    int station = chId.station();
     
     // ** Compute corrected values and write them to file or database **
-    vector<float> newDelays;
 
     // **  Retrieve Delays Loaded in MiniCrates ** 
     if(readOldFromDb) {    // read from db 
@@ -132,9 +116,13 @@ void DTFineDelayCorr::runClientDiagnostic() {
       coarseDelay = int(delay/25.);
       oldFineDelay = delay - coarseDelay * 25.;
     }
-    else {                 // read from map created from txt file
-      coarseDelay = oldDelayMap[chId].first;
-      oldFineDelay = oldDelayMap[chId].second;
+    else {                 // read from the table loaded from file
+      if (!oldDelays.found(chId)) {
+	LogWarning("DTDQM|DTMonitorClient|DTFineDelayCorr") << "[DTFineDelayCorr]: chamber " << chId
+							     << " not in the old delays file, delays taken as 0";
+      }
+      coarseDelay = oldDelays.coarse(chId);
+      oldFineDelay = oldDelays.fine(chId);
     }
 
     // ** Retrieve t0Mean histograms **
@@ -153,9 +141,7 @@ void DTFineDelayCorr::runClientDiagnostic() {
       }
       
       // ** Retrieve Worst Phase values **
-      int wpCoarseDelay;     
-      float wpFineDelay;
-      worstPhaseMap->get(chId, wpCoarseDelay,  wpFineDelay, DTTimeUnits::ns);
+      float wpFineDelay = worstPhaseMap.tpgFineDelay(chId);
 //       cout << "wpFineDelay, oldFineDelay, mean: " << wpFineDelay << " " 
 // 	   << oldFineDelay << " " << mean << endl;
       float bpFineDelay = (wpFineDelay < 12.5)? (wpFineDelay + 12.5) : (wpFineDelay - 12.5);  // Best Phase: half BX far from the worst phase 
@@ -164,6 +150,7 @@ void DTFineDelayCorr::runClientDiagnostic() {
       int bxDiff = (int) (diffFineDelays / 25);
       coarseDelay += bxDiff;
       newFineDelay = fmodf(diffFineDelays, 25);
+      calibRecorder.set(indexCh, DTCalibHistory::FineDelay, coarseDelay*25. + newFineDelay);
 //       cout << "diffFineDelays, newFineDelay, bxDiff, coarseDelay: " << diffFineDelays 
 // 	   << " "<< newFineDelay << " " << bxDiff << " " << coarseDelay << endl;
     }
@@ -172,18 +159,17 @@ void DTFineDelayCorr::runClientDiagnostic() {
 			     << indexCh << endl;
     }
 
-    newDelays.push_back(wheel);
-    newDelays.push_back(sector);
-    newDelays.push_back(station);
-    newDelays.push_back(coarseDelay);
-    newDelays.push_back(newFineDelay);    
-    pair< DTChamberId,  vector<float> > chDelays;
-    chDelays.first = chId; 
-    chDelays.second = newDelays;
-    delayMap.insert(chDelays);
+    newDelays.set(chId,coarseDelay,newFineDelay);
    }
 }
 
+void DTFineDelayCorr::endRun(const Run& run, const EventSetup& evSU){
+
+  DTLocalTriggerBaseTest::endRun(run,evSU);
+  calibRecorder.commit(run.run());
+
+}
+
 void DTFineDelayCorr::endJob(){
 
   DTLocalTriggerBaseTest::endJob();
@@ -191,16 +177,10 @@ void DTFineDelayCorr::endJob(){
    if (writeDB) {
      // to be added if needed
    }
+   else if (binaryOutput) { // write binary file
+     newDelays.writeBinary(outputFileName);
+   }
    else { // write txt file
-     // ** Open output file **
-     ofstream outFile(outputFileName.c_str());
-     for(map< DTChamberId,  vector<float> >::const_iterator iter = delayMap.begin();
-	 iter != delayMap.end() ; iter++) {
-       // writing
-       ostream_iterator<float> oit(outFile, " ");    
-       copy((*iter).second.begin(), (*iter).second.end(), oit);
-       outFile << endl;
-     }   
-     outFile.close();
+     newDelays.writeText(outputFileName);
    }
 }
@@ -12,15 +12,15 @@
  */
 
 #include "DQM/DTMonitorClient/src/DTLocalTriggerBaseTest.h"
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
+#include "DQM/DTMonitorClient/src/DTFineDelayTable.h"
+#include "DQM/DTMonitorClient/src/DTCalibRecorder.h"
 #include "FWCore/Framework/interface/ESHandle.h"
 // Geometry
 #include "Geometry/DTGeometry/interface/DTGeometry.h"
 // L1Trigger
 #include "L1TriggerConfig/DTTPGConfig/interface/DTConfigManager.h"
 #include "L1TriggerConfig/DTTPGConfig/interface/DTConfigManagerRcd.h"
-// DB & Calib
-#include <CondFormats/DTObjects/interface/DTTPGParameters.h>
-#include <CondFormats/DataRecord/interface/DTTPGParametersRcd.h>
 
 #include <map>
 #include <vector>
@@ -42,6 +42,9 @@ protected:
   /// Begin Run
   void beginRun(const edm::Run& run, const edm::EventSetup& evSU);
 
+  /// End Run: add the new delays to the calibration history
+  void endRun(const edm::Run& run, const edm::EventSetup& evSU);
+
   /// End Job
   void endJob();
  
@@ -59,17 +62,21 @@ protected:
   std::string trSource;
   bool readOldFromDb;
   bool writeDB;
+  bool binaryOutput;
   bool gaussMean;
   int minEntries;
   int nEvents;
   edm::ESHandle< DTConfigManager > dtConfig;
-  edm::ESHandle< DTTPGParameters > worstPhaseMap;
+  DTConditionsSnapshot worstPhaseMap;
+
+// The old delays by chamber (read once from the input file)
+  DTFineDelayTable oldDelays;
 
-// The map between the Chamber and the old delays
-  std::map< DTChamberId, std::pair<int,float> > oldDelayMap;
+// The new delays by chamber
+  DTFineDelayTable newDelays;
 
-// The map between the Chamber and the new delays
-  std::map< DTChamberId, std::vector<float> > delayMap;
+// History of the new delays by chamber
+  DTCalibRecorder calibRecorder;
 
 };
 
@@ -0,0 +1,241 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTFineDelayTable.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace {
+
+  const char binaryMagic[4] = { 'D', 'T', 'F', 'D' };
+  const uint32_t binaryVersion = 1;
+
+  struct BinaryRecord {
+    int32_t wheel;
+    int32_t sector;
+    int32_t station;
+    int32_t coarse;
+    float fine;
+  };
+
+  const size_t headerSize = 4 + 2*sizeof(uint32_t);
+
+}
+
+
+DTFineDelayTable::DTFineDelayTable() :
+  theFound(nChambers,false), theCoarse(nChambers,0), theFine(nChambers,0.) {}
+
+
+DTFineDelayTable::~DTFineDelayTable() {}
+
+
+void DTFineDelayTable::clear() {
+
+  theFound.assign(nChambers,false);
+  theCoarse.assign(nChambers,0);
+  theFine.assign(nChambers,0.);
+
+}
+
+
+void DTFineDelayTable::set(const DTChamberId& chId, int coarse, float fine) {
+
+  set(chId.wheel(),chId.sector(),chId.station(),coarse,fine);
+
+}
+
+
+bool DTFineDelayTable::set(int wheel, int sector, int station, int coarse, float fine) {
+
+  if (wheel < -2 || wheel > 2 || station < 1 || station > 4 || sector < 1 || sector > 14) return false;
+  int iCh = ((wheel+2)*4 + station-1)*14 + sector-1;
+  theFound[iCh]  = true;
+  theCoarse[iCh] = coarse;
+  theFine[iCh]   = fine;
+  return true;
+
+}
+
+
+bool DTFineDelayTable::read(const string& fileName) {
+
+  FILE* file = fopen(fileName.c_str(),"rb");
+  if (!file) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't open " << fileName;
+    return false;
+  }
+  char magic[4];
+  bool isBinary = fread(magic,1,4,file) == 4 && memcmp(magic,binaryMagic,4) == 0;
+  fclose(file);
+
+  return isBinary ? readBinary(fileName) : readText(fileName);
+
+}
+
+
+bool DTFineDelayTable::readText(const string& fileName) {
+
+  FILE* file = fopen(fileName.c_str(),"rb");
+  if (!file) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't open " << fileName;
+    return false;
+  }
+
+  // slurp the file and parse it in place
+  string buffer;
+  char chunk[65536];
+  size_t nRead;
+  while ((nRead = fread(chunk,1,sizeof(chunk),file)) > 0) buffer.append(chunk,nRead);
+  fclose(file);
+
+  const char* pos = buffer.c_str();
+  const char* end = pos + buffer.size();
+  int nBad = 0;
+  while (pos < end) {
+    const char* eol = static_cast<const char*>(memchr(pos,'\n',end-pos));
+    if (!eol) eol = end;
+    // blank and comment lines may be indented
+    const char* first = pos;
+    while (first != eol && isspace(static_cast<unsigned char>(*first))) ++first;
+    if (first != eol && *first != '#') {
+      // fields: wheel sector station coarse fine
+      string line(pos,eol-pos);
+      const char* field = line.c_str();
+      char* next;
+      long wheel   = strtol(field,&next,10); bool ok = next != field; field = next;
+      long sector  = strtol(field,&next,10); ok = ok && next != field; field = next;
+      long station = strtol(field,&next,10); ok = ok && next != field; field = next;
+      long coarse  = strtol(field,&next,10); ok = ok && next != field; field = next;
+      double fine  = strtod(field,&next);    ok = ok && next != field;
+      if (!ok || !set(wheel,sector,station,coarse,fine)) nBad++;
+    }
+    pos = eol + 1;
+  }
+
+  if (nBad) edm::LogWarning("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: " << nBad
+								      << " invalid lines in " << fileName;
+  return true;
+
+}
+
+
+bool DTFineDelayTable::readBinary(const string& fileName) {
+
+  int fd = open(fileName.c_str(),O_RDONLY);
+  if (fd < 0) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't open " << fileName;
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd,&fileStat) != 0 || size_t(fileStat.st_size) < headerSize) {
+    close(fd);
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: " << fileName << " is too short";
+    return false;
+  }
+  size_t size = fileStat.st_size;
+  void* map = mmap(0,size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't map " << fileName;
+    return false;
+  }
+
+  const char* data = static_cast<const char*>(map);
+  uint32_t version, nRecords;
+  memcpy(&version,data+4,sizeof(uint32_t));
+  memcpy(&nRecords,data+4+sizeof(uint32_t),sizeof(uint32_t));
+  bool ok = memcmp(data,binaryMagic,4) == 0 && version == binaryVersion &&
+    size >= headerSize + size_t(nRecords)*sizeof(BinaryRecord);
+
+  if (ok) {
+    const char* rec = data + headerSize;
+    for (uint32_t iRec = 0; iRec < nRecords; ++iRec, rec += sizeof(BinaryRecord)) {
+      BinaryRecord record;
+      memcpy(&record,rec,sizeof(BinaryRecord));
+      set(record.wheel,record.sector,record.station,record.coarse,record.fine);
+    }
+  } else {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: " << fileName
+							     << " is not a valid binary delay table";
+  }
+
+  munmap(map,size);
+  return ok;
+
+}
+
+
+bool DTFineDelayTable::writeText(const string& fileName) const {
+
+  ostringstream buffer;
+  for (int wheel = -2; wheel <= 2; ++wheel) {
+    for (int station = 1; station <= 4; ++station) {
+      for (int sector = 1; sector <= 14; ++sector) {
+	int iCh = ((wheel+2)*4 + station-1)*14 + sector-1;
+	if (!theFound[iCh]) continue;
+	buffer << wheel << " " << sector << " " << station << " "
+	       << theCoarse[iCh] << " " << theFine[iCh] << " \n";
+      }
+    }
+  }
+
+  FILE* file = fopen(fileName.c_str(),"w");
+  if (!file) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't open " << fileName;
+    return false;
+  }
+  const string& text = buffer.str();
+  bool ok = fwrite(text.data(),1,text.size(),file) == text.size();
+  return (fclose(file) == 0) && ok;
+
+}
+
+
+bool DTFineDelayTable::writeBinary(const string& fileName) const {
+
+  vector<BinaryRecord> records;
+  records.reserve(nChambers);
+  for (int wheel = -2; wheel <= 2; ++wheel) {
+    for (int station = 1; station <= 4; ++station) {
+      for (int sector = 1; sector <= 14; ++sector) {
+	int iCh = ((wheel+2)*4 + station-1)*14 + sector-1;
+	if (!theFound[iCh]) continue;
+	BinaryRecord record = { wheel, sector, station, theCoarse[iCh], theFine[iCh] };
+	records.push_back(record);
+      }
+    }
+  }
+
+  uint32_t nRecords = records.size();
+  string buffer(binaryMagic,4);
+  buffer.append(reinterpret_cast<const char*>(&binaryVersion),sizeof(uint32_t));
+  buffer.append(reinterpret_cast<const char*>(&nRecords),sizeof(uint32_t));
+  if (nRecords) buffer.append(reinterpret_cast<const char*>(&records[0]),nRecords*sizeof(BinaryRecord));
+
+  FILE* file = fopen(fileName.c_str(),"wb");
+  if (!file) {
+    edm::LogError("DTDQM|DTMonitorClient|DTFineDelayTable") << "[DTFineDelayTable]: can't open " << fileName;
+    return false;
+  }
+  bool ok = fwrite(buffer.data(),1,buffer.size(),file) == buffer.size();
+  return (fclose(file) == 0) && ok;
+
+}
@@ -0,0 +1,77 @@
+#ifndef DTFineDelayTable_H
+#define DTFineDelayTable_H
+
+/** \class DTFineDelayTable
+ *  Dense table of the MiniCrate delays (coarse delay in BX, fine delay in ns),
+ *  indexed by chamber.
+ *
+ *  Two file formats are supported:
+ *  - text: one line per chamber "wheel sector station coarse fine",
+ *    blank lines and lines whose first non blank character is '#' are skipped
+ *  - binary: 4 char magic "DTFD", uint32 version, uint32 # of records,
+ *    then per record int32 wheel, int32 sector, int32 station,
+ *    int32 coarse, float fine (native byte order)
+ *  read() recognizes the format from the magic, binary files are mmapped.
+ *  Files are written with a single buffered write.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DataFormats/MuonDetId/interface/DTChamberId.h"
+
+#include <string>
+#include <vector>
+
+class DTFineDelayTable {
+
+public:
+
+  /// Constructor
+  DTFineDelayTable();
+
+  /// Destructor
+  virtual ~DTFineDelayTable();
+
+  /// Remove all the entries
+  void clear();
+
+  /// Set the delays of a chamber
+  void set(const DTChamberId& chId, int coarse, float fine);
+
+  /// True if the chamber is in the table
+  bool found(const DTChamberId& chId) const { return theFound[index(chId)]; };
+
+  /// Delays of a chamber (0 if not in the table)
+  int coarse(const DTChamberId& chId) const { return theCoarse[index(chId)]; };
+  float fine(const DTChamberId& chId) const { return theFine[index(chId)]; };
+
+  /// Read a text or binary file, return false on failure
+  bool read(const std::string& fileName);
+
+  /// Read a text file
+  bool readText(const std::string& fileName);
+
+  /// Read a binary file (mmapped)
+  bool readBinary(const std::string& fileName);
+
+  /// Write the table (ordered by wheel, station, sector)
+  bool writeText(const std::string& fileName) const;
+  bool writeBinary(const std::string& fileName) const;
+
+private:
+
+  static int index(const DTChamberId& chId) {
+    return ((chId.wheel()+2)*4 + chId.station()-1)*14 + chId.sector()-1;
+  };
+  static const int nChambers = 5*4*14;
+
+  bool set(int wheel, int sector, int station, int coarse, float fine);
+
+  std::vector<bool> theFound;
+  std::vector<int> theCoarse;
+  std::vector<float> theFine;
+
+};
+
+#endif
@@ -9,6 +9,10 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTLocalTriggerBaseTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
+#include "DQM/DTMonitorClient/src/DTBookingTable.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -32,6 +36,33 @@
 using namespace edm;
 using namespace std;
 
+namespace {
+
+  const char* const* stations = DTBookingTable::stationLabels;
+
+  // sector MEs: the first spec whose tag is contained in the histo tag is used
+  const DTHistoSpec sectorSpecs[] = {
+    { "BXDistribPhi",   25, -4.5, 20.5, 4, 0.5, 4.5, 0, 0, stations, 4, 0, 0 },
+    { "QualDistribPhi",  7, -0.5,  6.5, 4, 0.5, 4.5, DTBookingTable::qualityLabels, 7, stations, 4, 0, 0 },
+    { "Phi",             4,  0.5,  4.5, 0, 0.,  0.,  stations, 4, 0, 0, 0, 0 },
+    { "TkvsTrig",        4,  0.5,  4.5, 0, 0.,  0.,  stations, 4, 0, 0, 0, 0 },
+    { "Theta",           3,  0.5,  3.5, 0, 0.,  0.,  stations, 3, 0, 0, 0, 0 }
+  };
+  const DTBookingTable sectorTable(sectorSpecs, sizeof(sectorSpecs)/sizeof(DTHistoSpec));
+
+  // wheel MEs
+  const DTHistoSpec wheelSpecs[] = {
+    { "Phi",     12, 1., 13., 4, 1., 5., 0, 0, stations, 4, "Sector", 0 },
+    { "Summary", 12, 1., 13., 4, 1., 5., 0, 0, stations, 4, "Sector", 0 },
+    { "Theta",   12, 1., 13., 3, 1., 4., 0, 0, stations, 3, "Sector", 0 }
+  };
+  const DTBookingTable wheelTable(wheelSpecs, sizeof(wheelSpecs)/sizeof(DTHistoSpec));
+
+  // CMS summaries
+  const DTHistoSpec cmsSpec = { "", 12, 1., 13., 5, -2., 3., 0, 0, 0, 0, "Sector", "Wheel" };
+
+}
+
 
 DTLocalTriggerBaseTest::~DTLocalTriggerBaseTest(){
 
@@ -44,6 +75,7 @@ void DTLocalTriggerBaseTest::beginJob(){
   LogVerbatim(category()) << "[" << testName << "Test]: BeginJob";
   nevents = 0;
   nLumiSegs = 0;
+  lumiNumber = 0;
   
 }
 
@@ -58,8 +90,9 @@ void DTLocalTriggerBaseTest::beginLuminosityBlock(LuminosityBlock const& lumiSeg
 
   LogTrace(category()) <<"[" << testName << "Test]: Begin of LS transition";
 
-  // Get the run number
+  // Get the run and LS numbers
   run = lumiSeg.run();
+  lumiNumber = lumiSeg.id().luminosityBlock();
 
 }
 
@@ -73,6 +106,7 @@ void DTLocalTriggerBaseTest::analyze(const edm::Event& e, const edm::EventSetup&
 
 
 void DTLocalTriggerBaseTest::endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& context) {
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::EndLumi);
   
   if (!runOnline) return;
 
@@ -80,9 +114,11 @@ void DTLocalTriggerBaseTest::endLuminosityBlock(edm::LuminosityBlock const& lumi
 
   // counts number of lumiSegs and prescale
   nLumiSegs++;
-  if ( nLumiSegs%prescaleFactor != 0 ) return;
+  DTClientScheduler& scheduler = DTClientScheduler::instance();
+  if ( !scheduler.runInLS(schedulerSlot, lumiSeg.run(), lumiSeg.id().luminosityBlock(), nLumiSegs) ) return;
 
   LogVerbatim("DTDQM|DTMonitorClient|DTLocalTriggerTest") <<"[" << testName << "Test]: "<<nLumiSegs<<" updates";  
+  DTClientScheduler::Execution execution(schedulerSlot);
   runClientDiagnostic();
 
 }
@@ -91,17 +127,26 @@ void DTLocalTriggerBaseTest::endLuminosityBlock(edm::LuminosityBlock const& lumi
 void DTLocalTriggerBaseTest::endJob(){
   
     LogTrace(category()) << "[" << testName << "Test] endJob called!";
+    bookingPolicy.report();
 
 }
 
 
 void DTLocalTriggerBaseTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::EndRun);
   
   LogTrace(category()) << "[" << testName << "Test] endRun called!";
 
+  // the event counters used by the summaries are final only now
+  DTEventCounters::refresh(dbe, run.run());
+
   if (!runOnline) {
     LogVerbatim(category()) << "[" << testName << "Test] Client called in offline mode, performing client operations";
     runClientDiagnostic();
+  } else if (DTClientScheduler::instance().pending(schedulerSlot)) {
+    LogVerbatim(category()) << "[" << testName << "Test] Statistics of the last LS not analyzed yet, performing client operations";
+    DTClientScheduler::Execution execution(schedulerSlot);
+    runClientDiagnostic();
   }
 
 }
@@ -124,33 +169,58 @@ void DTLocalTriggerBaseTest::setConfig(const edm::ParameterSet& ps, string name)
     trigSources = ps.getUntrackedParameter<vector<string> >("trigSources");
   }
 
+  sources.clear();
+  vector<string>::const_iterator iTr   = trigSources.begin();
+  vector<string>::const_iterator trEnd = trigSources.end();
+  for (; iTr != trEnd; ++iTr){
+    vector<string>::const_iterator iHw   = hwSources.begin();
+    vector<string>::const_iterator hwEnd = hwSources.end();
+    for (; iHw != hwEnd; ++iHw){
+      sources.push_back(TrigHwSource((*iTr),(*iHw)));
+    }
+  }
+
   parameters = ps;
   nevents = 0;
   dbe = edm::Service<DQMStore>().operator->();
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 1);
+  schedulerSlot = DTClientScheduler::instance().registerClient(name + "Test", DTEventCounters::Trigger, prescaleFactor);
+  bookingPolicy.configure(ps, name + "Test");
 
 }
 
 
 string DTLocalTriggerBaseTest::fullName (string htype) {
 
-  return hwSource + "_" + htype + trigSource;
+  return fullName(htype,TrigHwSource(trigSource,hwSource));
+
+}
+
+string DTLocalTriggerBaseTest::fullName (string htype, const TrigHwSource& src) {
+
+  return src.hw + "_" + htype + src.trig;
 
 }
 
 string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, const DTChamberId & chambid) {
+
+  return getMEName(histoTag,subfolder,chambid,TrigHwSource(trigSource,hwSource));
+
+}
+
+string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, const DTChamberId & chambid, const TrigHwSource& src) {
  
   stringstream wheel; wheel << chambid.wheel();
   stringstream station; station << chambid.station();
   stringstream sector; sector << chambid.sector();
 
-  string folderName = topFolder(hwSource=="DCC") + "Wheel" +  wheel.str() +
+  string folderName = topFolder(src.isDCC()) + "Wheel" +  wheel.str() +
     "/Sector" + sector.str() + "/Station" + station.str() + "/" ; 
   if (subfolder!="") { folderName += subfolder + "/"; }
 
   string histoname = sourceFolder + folderName 
-    + fullName(histoTag) 
+    + fullName(histoTag,src) 
     + "_W" + wheel.str()  
     + "_Sec" + sector.str()
     + "_St" + station.str();
@@ -161,19 +231,93 @@ string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, cons
 
 string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, int wh) {
 
+  return getMEName(histoTag,subfolder,wh,TrigHwSource(trigSource,hwSource));
+
+}
+
+string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, int wh, const TrigHwSource& src) {
+
   stringstream wheel; wheel << wh;
 
-  string folderName =  topFolder(hwSource=="DCC") + "Wheel" + wheel.str() + "/";
+  string folderName =  topFolder(src.isDCC()) + "Wheel" + wheel.str() + "/";
   if (subfolder!="") { folderName += subfolder + "/"; }  
 
   string histoname = sourceFolder + folderName 
-    + fullName(histoTag) + "_W" + wheel.str();
+    + fullName(histoTag,src) + "_W" + wheel.str();
   
   return histoname;
   
 }
 
 
+int DTLocalTriggerBaseTest::addChamberInput(string histoTag, string subfolder, string hwFilter) {
+
+  ChamberInput input;
+  input.histoTag  = histoTag;
+  input.subfolder = subfolder;
+
+  vector<TrigHwSource>::const_iterator srcIt  = sources.begin();
+  vector<TrigHwSource>::const_iterator srcEnd = sources.end();
+  for (; srcIt != srcEnd; ++srcIt) {
+    bool use = hwFilter=="";
+    string::size_type begin = 0;
+    while (!use && begin <= hwFilter.size()) {
+      string::size_type end = hwFilter.find('|',begin);
+      if (end == string::npos) end = hwFilter.size();
+      use = hwFilter.compare(begin,end-begin,srcIt->hw) == 0;
+      begin = end+1;
+    }
+    input.useSource.push_back(use);
+  }
+
+  chamberInputs.push_back(input);
+  return chamberInputs.size()-1;
+
+}
+
+
+void DTLocalTriggerBaseTest::sweepChambers() {
+
+  int nSources = sources.size();
+  int nInputs  = chamberInputs.size();
+  ChamberInputs inputs(nSources,vector<MonitorElement*>(nInputs,static_cast<MonitorElement*>(0)));
+
+  vector<DTChamber*>::const_iterator chambIt  = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator chambEnd = muonGeom->chambers().end();
+  for (; chambIt!=chambEnd; ++chambIt) { 
+
+    DTChamberId chId = (*chambIt)->id();
+
+    // Chamber dependent parts of the names are resolved once for all the sources
+    stringstream wheel; wheel << chId.wheel();
+    stringstream station; station << chId.station();
+    stringstream sector; sector << chId.sector();
+    string chambFolder = "Wheel" + wheel.str() + "/Sector" + sector.str() + "/Station" + station.str() + "/";
+    string chambTag    = "_W" + wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
+
+    for (int iSrc=0; iSrc<nSources; ++iSrc) {
+      const TrigHwSource& src = sources[iSrc];
+      string folderName = sourceFolder + topFolder(src.isDCC()) + chambFolder;
+      for (int iIn=0; iIn<nInputs; ++iIn) {
+	const ChamberInput& input = chamberInputs[iIn];
+	if (!input.useSource[iSrc]) {
+	  inputs[iSrc][iIn] = 0;
+	  continue;
+	}
+	string histoname = folderName;
+	if (input.subfolder!="") { histoname += input.subfolder + "/"; }
+	histoname += src.hw + "_" + input.histoTag + src.trig + chambTag;
+	inputs[iSrc][iIn] = dbe->get(histoname);
+      }
+    }
+
+    runChamberDiagnostic(chId,inputs);
+
+  }
+
+}
+
+
 // void DTLocalTriggerBaseTest::setLabelPh(MonitorElement* me){
 
 //   for (int i=0; i<48; ++i){
@@ -198,92 +342,75 @@ string DTLocalTriggerBaseTest::getMEName(string histoTag, string subfolder, int
 
 
 void DTLocalTriggerBaseTest::bookSectorHistos(int wheel,int sector,string hTag,string folder) {
+
+  bookSectorHistos(TrigHwSource(trigSource,hwSource),wheel,sector,hTag,folder);
+
+}
+
+void DTLocalTriggerBaseTest::bookSectorHistos(const TrigHwSource& src,int wheel,int sector,string hTag,string folder) {
   
+  const DTHistoSpec* spec = sectorTable.find(hTag);
+  if (spec == 0) return;
+
   stringstream wh; wh << wheel;
   stringstream sc; sc << sector;
   int sectorid = (wheel+3) + (sector-1)*5;
-  bool isDCC = hwSource=="DCC" ;
-  string basedir = topFolder(isDCC)+"Wheel"+wh.str()+"/Sector"+sc.str()+"/";
-  if (folder!="") {
-    basedir += folder +"/";
+  bool isDCC = src.isDCC();
+  string basedir;
+  if (folder=="") {
+    // the sector folders are built once
+    int folderKey = isDCC ? sectorid+100 : sectorid;
+    map<int,string>::const_iterator folderIt = sectorFolders.find(folderKey);
+    if (folderIt == sectorFolders.end()) {
+      folderIt = sectorFolders.insert(make_pair(folderKey,topFolder(isDCC)+"Wheel"+wh.str()+"/Sector"+sc.str()+"/")).first;
+    }
+    basedir = (*folderIt).second;
+  } else {
+    basedir = topFolder(isDCC)+"Wheel"+wh.str()+"/Sector"+sc.str()+"/"+folder+"/";
   }
   dbe->setCurrentFolder(basedir);
 
-  string fullTag = fullName(hTag);
+  string fullTag = fullName(hTag,src);
   string hname    = fullTag + "_W" + wh.str()+"_Sec" +sc.str();
   LogTrace(category()) << "[" << testName << "Test]: booking " << basedir << hname;
-  if (hTag.find("BXDistribPhi") != string::npos){    
-    MonitorElement* me = dbe->book2D(hname.c_str(),hname.c_str(),25,-4.5,20.5,4,0.5,4.5);
-    me->setBinLabel(1,"MB1",2);
-    me->setBinLabel(2,"MB2",2);
-    me->setBinLabel(3,"MB3",2);
-    me->setBinLabel(4,"MB4",2);
-    secME[sectorid][fullTag] = me;
-    return;
-  }
-  else if (hTag.find("QualDistribPhi") != string::npos){    
-    MonitorElement* me = dbe->book2D(hname.c_str(),hname.c_str(),7,-0.5,6.5,4,0.5,4.5);
-    me->setBinLabel(1,"MB1",2);
-    me->setBinLabel(2,"MB2",2);
-    me->setBinLabel(3,"MB3",2);
-    me->setBinLabel(4,"MB4",2);
-    me->setBinLabel(1,"LI",1);
-    me->setBinLabel(2,"LO",1);
-    me->setBinLabel(3,"HI",1);
-    me->setBinLabel(4,"HO",1);
-    me->setBinLabel(5,"LL",1);
-    me->setBinLabel(6,"HL",1);
-    me->setBinLabel(7,"HH",1);
-    secME[sectorid][fullTag] = me;
-    return;
-  }
-  else if (hTag.find("Phi") != string::npos || 
-      hTag.find("TkvsTrig") != string::npos ){    
-    MonitorElement* me = dbe->book1D(hname.c_str(),hname.c_str(),4,0.5,4.5);
-    me->setBinLabel(1,"MB1",1);
-    me->setBinLabel(2,"MB2",1);
-    me->setBinLabel(3,"MB3",1);
-    me->setBinLabel(4,"MB4",1);
-    secME[sectorid][fullTag] = me;
-    return;
-  }
-  
-  if (hTag.find("Theta") != string::npos){
-    MonitorElement* me =dbe->book1D(hname.c_str(),hname.c_str(),3,0.5,3.5);
-    me->setBinLabel(1,"MB1",1);
-    me->setBinLabel(2,"MB2",1);
-    me->setBinLabel(3,"MB3",1);
-    secME[sectorid][fullTag] = me;
-    return;
-  }
+  secME[sectorid][fullTag] = bookingPolicy.booked(DTBookingTable::book(dbe,*spec,hname,hname));
   
 }
 
 void DTLocalTriggerBaseTest::bookCmsHistos(string hTag, string folder, bool isGlb) {
 
-  bool isDCC = hwSource == "DCC"; 
+  bookCmsHistos(TrigHwSource(trigSource,hwSource),hTag,folder,isGlb);
+
+}
+
+void DTLocalTriggerBaseTest::bookCmsHistos(const TrigHwSource& src, string hTag, string folder, bool isGlb) {
+
+  bool isDCC = src.isDCC(); 
   string basedir = topFolder(isDCC);
   if (folder != "") {
     basedir += folder +"/" ;
   }
   dbe->setCurrentFolder(basedir);
 
-  string hname = isGlb ? hTag : fullName(hTag);
+  string hname = isGlb ? hTag : fullName(hTag,src);
   LogTrace(category()) << "[" << testName << "Test]: booking " << basedir << hname;
 
 
-  MonitorElement* me = dbe->book2D(hname.c_str(),hname.c_str(),12,1,13,5,-2,3);
-  me->setAxisTitle("Sector",1);
-  me->setAxisTitle("Wheel",2);
-  cmsME[hname] = me;
+  cmsME[hname] = DTBookingTable::book(dbe,cmsSpec,hname,hname);
 
 }
 
 void DTLocalTriggerBaseTest::bookWheelHistos(int wheel,string hTag,string folder) {
+
+  bookWheelHistos(TrigHwSource(trigSource,hwSource),wheel,hTag,folder);
+
+}
+
+void DTLocalTriggerBaseTest::bookWheelHistos(const TrigHwSource& src,int wheel,string hTag,string folder) {
   
   stringstream wh; wh << wheel;
   string basedir;  
-  bool isDCC = hwSource=="DCC" ;  
+  bool isDCC = src.isDCC();  
   if (hTag.find("Summary") != string::npos) {
     basedir = topFolder(isDCC);   //Book summary histo outside wheel directories
   } else {
@@ -295,37 +422,14 @@ void DTLocalTriggerBaseTest::bookWheelHistos(int wheel,string hTag,string folder
   }
   dbe->setCurrentFolder(basedir);
 
-  string fullTag = fullName(hTag);
+  string fullTag = fullName(hTag,src);
   string hname    = fullTag+ "_W" + wh.str();
 
   LogTrace(category()) << "[" << testName << "Test]: booking "<< basedir << hname;
   
-  if (hTag.find("Phi")!= string::npos ||
-      hTag.find("Summary") != string::npos ){    
-    MonitorElement* me = dbe->book2D(hname.c_str(),hname.c_str(),12,1,13,4,1,5);
-
-//     setLabelPh(me);
-    me->setBinLabel(1,"MB1",2);
-    me->setBinLabel(2,"MB2",2);
-    me->setBinLabel(3,"MB3",2);
-    me->setBinLabel(4,"MB4",2);
-    me->setAxisTitle("Sector",1);
-    
-    whME[wheel][fullTag] = me;
-    return;
-  }
-  
-  if (hTag.find("Theta") != string::npos){
-    MonitorElement* me =dbe->book2D(hname.c_str(),hname.c_str(),12,1,13,3,1,4);
-
-//     setLabelTh(me);
-    me->setBinLabel(1,"MB1",2);
-    me->setBinLabel(2,"MB2",2);
-    me->setBinLabel(3,"MB3",2);
-    me->setAxisTitle("Sector",1);
-
-    whME[wheel][fullTag] = me;
-    return;
+  const DTHistoSpec* spec = wheelTable.find(hTag);
+  if (spec != 0) {
+    whME[wheel][fullTag] = DTBookingTable::book(dbe,*spec,hname,hname);
   }
   
 }
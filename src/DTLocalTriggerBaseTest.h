@@ -26,9 +26,12 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBookingPolicy.h"
+
 #include <boost/cstdint.hpp>
 #include <string>
 #include <map>
+#include <vector>
 
 class DTChamberId;
 class DTGeometry;
@@ -40,6 +43,18 @@ class DTLocalTriggerBaseTest: public edm::EDAnalyzer{
 
 public:
 
+  /// Trigger/hardware source combination analyzed by the client
+  class TrigHwSource {
+  public:
+    TrigHwSource(std::string trigSrc, std::string hwSrc) : trig(trigSrc), hw(hwSrc) {};
+    inline bool isDCC() const { return hw=="DCC"; };
+    std::string trig;
+    std::string hw;
+  };
+
+  /// Chamber input MEs for every trig/hw source combination ([source][input])
+  typedef std::vector<std::vector<MonitorElement*> > ChamberInputs;
+
   /// Constructor
   DTLocalTriggerBaseTest() {};
   
@@ -72,15 +87,33 @@ protected:
   /// Perform client analysis
   virtual void runClientDiagnostic() = 0;
 
+  /// Perform client analysis of a chamber for all the trig/hw source combinations (called by sweepChambers)
+  virtual void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs) {};
+
+  /// Register a chamber input ME for sweepChambers (hwFilter is a '|' separated list of hw sources, empty means all)
+  int addChamberInput(std::string histoTag, std::string subfolder, std::string hwFilter="");
+
+  /// Loop once over the chambers handing the inputs for all the trig/hw source combinations to runChamberDiagnostic
+  void sweepChambers();
+
   /// Book the new MEs (for each sector)
   void bookSectorHistos( int wheel, int sector, std::string hTag, std::string folder="" );
 
+  /// Book the new MEs (for each sector) for a given trig/hw source
+  void bookSectorHistos( const TrigHwSource& src, int wheel, int sector, std::string hTag, std::string folder="" );
+
   /// Book the new MEs (for each wheel)
   void bookWheelHistos( int wheel, std::string hTag, std::string folder="" );
 
+  /// Book the new MEs (for each wheel) for a given trig/hw source
+  void bookWheelHistos( const TrigHwSource& src, int wheel, std::string hTag, std::string folder="" );
+
   /// Book the new MEs (CMS summary)
   void bookCmsHistos( std::string hTag, std::string folder="" , bool isGlb = false);
 
+  /// Book the new MEs (CMS summary) for a given trig/hw source
+  void bookCmsHistos( const TrigHwSource& src, std::string hTag, std::string folder="" , bool isGlb = false);
+
   /// Calculate phi range for histograms
   std::pair<float,float> phiRange(const DTChamberId& id);
 
@@ -99,11 +132,20 @@ protected:
   /// Create fullname from histo partial name
   std::string fullName(std::string htype);
 
+  /// Create fullname from histo partial name for a given trig/hw source
+  std::string fullName(std::string htype, const TrigHwSource& src);
+
   /// Get the ME name (by chamber)
   std::string getMEName(std::string histoTag, std::string subfolder, const DTChamberId& chambid);
 
+  /// Get the ME name (by chamber) for a given trig/hw source
+  std::string getMEName(std::string histoTag, std::string subfolder, const DTChamberId& chambid, const TrigHwSource& src);
+
  /// Get the ME name (by wheel)
   std::string getMEName(std::string histoTag, std::string subfolder, int wh);
+
+ /// Get the ME name (by wheel) for a given trig/hw source
+  std::string getMEName(std::string histoTag, std::string subfolder, int wh, const TrigHwSource& src);
   
   /// Get top folder name
   inline std::string & topFolder(bool isDCC) { return isDCC ? baseFolderDCC : baseFolderDDU; } ;
@@ -116,10 +158,13 @@ protected:
   int nevents;
   unsigned int nLumiSegs;
   int prescaleFactor;
+  int schedulerSlot;
   int run;
+  int lumiNumber;
   std::string testName;
   std::vector<std::string> trigSources;
   std::vector<std::string> hwSources;
+  std::vector<TrigHwSource> sources;
 
   DQMStore* dbe;
   std::string sourceFolder;
@@ -133,6 +178,19 @@ protected:
   std::map<int,std::map<std::string,MonitorElement*> > secME;
   std::map<int,std::map<std::string,MonitorElement*> > whME;
   std::map<std::string,MonitorElement*> cmsME;
+  DTBookingPolicy bookingPolicy;
+  std::map<int,std::string> sectorFolders;
+
+ private:
+
+  /// Chamber input registered for sweepChambers
+  struct ChamberInput {
+    std::string histoTag;
+    std::string subfolder;
+    std::vector<bool> useSource;
+  };
+
+  std::vector<ChamberInput> chamberInputs;
 
 };
 
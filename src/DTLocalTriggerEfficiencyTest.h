@@ -14,6 +14,7 @@
 
 
 #include "DQM/DTMonitorClient/src/DTLocalTriggerBaseTest.h"
+#include "DQM/DTMonitorClient/src/DTTrigEfficiencyKernel.h"
 
 
 class DTTrigGeomUtils;
@@ -31,13 +32,11 @@ public:
 protected:
 
   /// Book the new MEs (for each chamber)
-  void bookChambHistos(DTChamberId chambId, std::string htype );
+  void bookChambHistos(const TrigHwSource& src, DTChamberId chambId, std::string htype );
 
-  /// Compute efficiency plots
-  void makeEfficiencyME(TH1D* numerator, TH1D* denominator, MonitorElement* result);
-
-  /// Compute 2D efficiency plots
-  void makeEfficiencyME2D(TH2F* numerator, TH2F* denominator, MonitorElement* result);
+  /// Compute 2D efficiency plots and their angle/position projections in a single sweep
+  void makeEfficiencyME(TH2F* numerator, TH2F* denominator, MonitorElement* result2D,
+			MonitorElement* resultAngle, MonitorElement* resultPos);
 
   /// BeginRun
   void beginRun(const edm::Run& r, const edm::EventSetup& c);
@@ -45,12 +44,18 @@ protected:
   /// DQM Client Diagnostic
   void runClientDiagnostic();
 
+  /// DQM Client Diagnostic (per chamber, all the trig/hw sources)
+  void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs);
+
 
 
  private:
 
   std::map<uint32_t,std::map<std::string,MonitorElement*> > chambME;
   DTTrigGeomUtils *trigGeomUtils;
+  DTTrigEfficiencyKernel effKernel;
+  int posvsAngleInput, posvsAngleTrigInput, posvsAngleTrigHHHLInput;
+  int thetaPosvsAngleInput, thetaPosvsAngleTrigInput, thetaPosvsAngleTrigHInput;
 
 };
 
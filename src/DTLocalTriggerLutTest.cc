@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTLocalTriggerLutTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -44,6 +45,11 @@ DTLocalTriggerLutTest::DTLocalTriggerLutTest(const edm::ParameterSet& ps){
   thresholdPhibRMS  = ps.getUntrackedParameter<double>("thresholdPhibRMS",.8);
   doCorrStudy       = ps.getUntrackedParameter<bool>("doCorrelationStudy",false);
 
+  phiTkvsTrigInput  = addChamberInput("PhitkvsPhitrig","Segment");
+  phibTkvsTrigInput = addChamberInput("PhibtkvsPhibtrig","Segment");
+  phiResidualInput  = addChamberInput("PhiResidual","Segment");
+  phibResidualInput = addChamberInput("PhibResidual","Segment");
+
 
 }
 
@@ -54,7 +60,8 @@ DTLocalTriggerLutTest::~DTLocalTriggerLutTest(){
 
 
 void DTLocalTriggerLutTest::beginJob(){
-  
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::Booking);
+
   DTLocalTriggerBaseTest::beginJob();
 
   vector<string>::const_iterator iTr   = trigSources.begin();
@@ -113,210 +120,210 @@ void DTLocalTriggerLutTest::beginRun(const edm::Run& r, const edm::EventSetup& c
 
 
 void DTLocalTriggerLutTest::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTLocalTriggerLutTest", DTClientPerformance::Diagnostic);
 
-  // Loop over Trig & Hw sources
-  for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
-    trigSource = (*iTr);
-    for (vector<string>::const_iterator iHw = hwSources.begin(); iHw != hwSources.end(); ++iHw){
-      hwSource = (*iHw);
-      vector<DTChamber*>::const_iterator chIt = muonGeom->chambers().begin();
-      vector<DTChamber*>::const_iterator chEnd = muonGeom->chambers().end();
-      for (; chIt != chEnd; ++chIt) {
-	DTChamberId chId((*chIt)->id());
-	int wh   = chId.wheel();
-	int sect = chId.sector();
-	int stat = chId.station();
-
-
-	if (doCorrStudy) {
-	  // Perform Correlation Plots analysis (DCC + segment Phi)
-	  TH2F * TrackPhitkvsPhitrig   = getHisto<TH2F>(dbe->get(getMEName("PhitkvsPhitrig","Segment", chId)));
-	
-	  if (TrackPhitkvsPhitrig && TrackPhitkvsPhitrig->GetEntries()>10) {
-	    
-	    // Fill client histos
-	    if( whME[wh].find(fullName("PhiTkvsTrigCorr")) == whME[wh].end() ){
-	      bookWheelHistos(wh,"PhiTkvsTrigSlope");  
-	      bookWheelHistos(wh,"PhiTkvsTrigIntercept");  
-	      bookWheelHistos(wh,"PhiTkvsTrigCorr");  
-	    }
-	    
-	    TProfile* PhitkvsPhitrigProf = TrackPhitkvsPhitrig->ProfileX();
-	    double phiInt   = 0;
-	    double phiSlope = 0;
-	    double phiCorr  = 0;
-	    try {
-	      PhitkvsPhitrigProf->Fit("pol1","CQO");
-	      TF1 *ffPhi= PhitkvsPhitrigProf->GetFunction("pol1");
-	      if (ffPhi) {
-		phiInt   = ffPhi->GetParameter(0);
-		phiSlope = ffPhi->GetParameter(1);
-		phiCorr  = TrackPhitkvsPhitrig->GetCorrelationFactor();
-	      }
-	    } catch (cms::Exception& iException) {
-	      edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhitkvsPhitrig for Wheel " << wh 
-					<<" Sector " << sect << " Station " << stat;
-	    }
-	    
-	    std::map<std::string,MonitorElement*> &innerME = whME[wh];
-	    fillWhPlot(innerME.find(fullName("PhiTkvsTrigSlope"))->second,sect,stat,phiSlope-1);
-	    fillWhPlot(innerME.find(fullName("PhiTkvsTrigIntercept"))->second,sect,stat,phiInt);
-	    fillWhPlot(innerME.find(fullName("PhiTkvsTrigCorr"))->second,sect,stat,phiCorr,false);
-	    
+  // Single chamber sweep for all the Trig & Hw sources
+  sweepChambers();
+
+  // Barrel Summary Plots
+  vector<TrigHwSource>::const_iterator srcIt  = sources.begin();
+  vector<TrigHwSource>::const_iterator srcEnd = sources.end();
+  for (; srcIt != srcEnd; ++srcIt){
+    const TrigHwSource& src = (*srcIt);
+    for (int wh=-2; wh<=2; ++wh){
+      std::map<std::string,MonitorElement*> *innerME = &(whME[wh]);
+
+      TH2F* phiWhSummary   = getHisto<TH2F>(innerME->find(fullName("PhiLutSummary",src))->second);
+      TH2F* phibWhSummary  = getHisto<TH2F>(innerME->find(fullName("PhibLutSummary",src))->second);
+      for (int sect=1; sect<=12; ++sect){
+	int phiErr     = 0;
+	int phibErr    = 0;
+	int phiNoData  = 0;
+	int phibNoData = 0;
+	for (int stat=1; stat<=4; ++stat){
+	  switch (static_cast<int>(phiWhSummary->GetBinContent(sect,stat))) {
+	  case 1:
+	    phiNoData++;
+	  case 2:
+	  case 3:
+	    phiErr++;
 	  }
-	
-	  // Perform Correlation Plots analysis (DCC + segment Phib)
-	  TH2F * TrackPhibtkvsPhibtrig = getHisto<TH2F>(dbe->get(getMEName("PhibtkvsPhibtrig","Segment", chId)));
-	  
-	  if (stat != 3 && TrackPhibtkvsPhibtrig && TrackPhibtkvsPhibtrig->GetEntries()>10) {// station 3 has no meaningful MB3 phi bending information
-	  
-	    // Fill client histos
-	    if( whME[wh].find(fullName("PhibTkvsTrigCorr")) == whME[wh].end() ){
-	      bookWheelHistos(wh,"PhibTkvsTrigSlope");  
-	      bookWheelHistos(wh,"PhibTkvsTrigIntercept");  
-	      bookWheelHistos(wh,"PhibTkvsTrigCorr");  
-	    }
-	    
-	    TProfile* PhibtkvsPhibtrigProf = TrackPhibtkvsPhibtrig->ProfileX(); 
-	    double phibInt  = 0;
-	    double phibSlope = 0;
-	    double phibCorr  = 0;
-	    try {
-	      PhibtkvsPhibtrigProf->Fit("pol1","CQO");
-	      TF1 *ffPhib= PhibtkvsPhibtrigProf->GetFunction("pol1");
-	      if (ffPhib) {
-		phibInt   = ffPhib->GetParameter(0);
-		phibSlope = ffPhib->GetParameter(1);
-		phibCorr  = TrackPhibtkvsPhibtrig->GetCorrelationFactor();
-	      }
-	    } catch (cms::Exception& iException) {
-	      edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhibtkvsPhibtrig for Wheel " << wh 
-					<<" Sector " << sect << " Station " << stat;
-	    }
-	    
-	    std::map<std::string,MonitorElement*> &innerME = whME[wh];
-	    fillWhPlot(innerME.find(fullName("PhibTkvsTrigSlope"))->second,sect,stat,phibSlope-1);
-	    fillWhPlot(innerME.find(fullName("PhibTkvsTrigIntercept"))->second,sect,stat,phibInt);
-	    fillWhPlot(innerME.find(fullName("PhibTkvsTrigCorr"))->second,sect,stat,phibCorr,false);
-	    
+	  switch (static_cast<int>(phibWhSummary->GetBinContent(sect,stat))) {
+	  case 1:
+	    phibNoData++;
+	  case 2:
+	  case 3:
+	    phibErr++;
 	  }
+	}
+	if (phiNoData == 4)  phiErr  = 5;
+	if (phibNoData == 3) phibErr = 5;  // MB3 has no phib information
+	cmsME.find(fullName("PhiLutSummary",src))->second->setBinContent(sect,wh+3,phiErr);
+	cmsME.find(fullName("PhibLutSummary",src))->second->setBinContent(sect,wh+3,phibErr);
+      }
+    }
+  }
+
+}
+
+void DTLocalTriggerLutTest::runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs) {
+
+  int wh   = chId.wheel();
+  int sect = chId.sector();
+  int stat = chId.station();
+  int nSources = sources.size();
 
+  for (int iSrc=0; iSrc<nSources; ++iSrc) {
+    const TrigHwSource& src = sources[iSrc];
+    const vector<MonitorElement*>& srcInputs = inputs[iSrc];
+
+    if (doCorrStudy) {
+      // Perform Correlation Plots analysis (DCC + segment Phi)
+      TH2F * TrackPhitkvsPhitrig   = getHisto<TH2F>(srcInputs[phiTkvsTrigInput]);
+
+      if (TrackPhitkvsPhitrig && TrackPhitkvsPhitrig->GetEntries()>10) {
+
+	// Fill client histos
+	if( whME[wh].find(fullName("PhiTkvsTrigCorr",src)) == whME[wh].end() ){
+	  bookWheelHistos(src,wh,"PhiTkvsTrigSlope");  
+	  bookWheelHistos(src,wh,"PhiTkvsTrigIntercept");  
+	  bookWheelHistos(src,wh,"PhiTkvsTrigCorr");  
 	}
-	
-	// Make Phi Residual Summary
-	TH1F * PhiResidual = getHisto<TH1F>(dbe->get(getMEName("PhiResidual","Segment", chId)));
-	int phiSummary = 1;
-	
-	if (PhiResidual && PhiResidual->GetEffectiveEntries()>10) {
-	  
-	  // Fill client histos
-	  if( whME[wh].find(fullName("PhiResidualMean")) == whME[wh].end() ){
-	    bookWheelHistos(wh,"PhiResidualMean");  
-	    bookWheelHistos(wh,"PhiResidualRMS");  
-	  }
-	  
-	  double peak = PhiResidual->GetBinCenter(PhiResidual->GetMaximumBin());
-	  double phiMean = 0;
-	  double phiRMS  = 0;
-	  try {
-	    PhiResidual->Fit("gaus","CQO","",peak-5,peak+5);
-	    TF1 *ffPhi = PhiResidual->GetFunction("gaus");
-	    if ( ffPhi ) {
-	      phiMean = ffPhi->GetParameter(1);
-	      phiRMS  = ffPhi->GetParameter(2);
-	    }
-	  } catch (cms::Exception& iException) {
-	    edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhiResidual for Wheel " << wh 
-				      <<" Sector " << sect << " Station " << stat;
+
+	TProfile* PhitkvsPhitrigProf = TrackPhitkvsPhitrig->ProfileX();
+	double phiInt   = 0;
+	double phiSlope = 0;
+	double phiCorr  = 0;
+	try {
+	  PhitkvsPhitrigProf->Fit("pol1","CQO");
+	  TF1 *ffPhi= PhitkvsPhitrigProf->GetFunction("pol1");
+	  if (ffPhi) {
+	    phiInt   = ffPhi->GetParameter(0);
+	    phiSlope = ffPhi->GetParameter(1);
+	    phiCorr  = TrackPhitkvsPhitrig->GetCorrelationFactor();
 	  }
-	  
-	  std::map<std::string,MonitorElement*> &innerME = whME[wh];
-	  fillWhPlot(innerME.find(fullName("PhiResidualMean"))->second,sect,stat,phiMean);
-	  fillWhPlot(innerME.find(fullName("PhiResidualRMS"))->second,sect,stat,phiRMS);
-	  
-	  phiSummary = performLutTest(phiMean,phiRMS,thresholdPhiMean,thresholdPhiRMS);
-	  
+	} catch (cms::Exception& iException) {
+	  edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhitkvsPhitrig for Wheel " << wh 
+				    <<" Sector " << sect << " Station " << stat;
 	}
-	fillWhPlot(whME[wh].find(fullName("PhiLutSummary"))->second,sect,stat,phiSummary);
-	
-	// Make Phib Residual Summary
-	TH1F * PhibResidual = getHisto<TH1F>(dbe->get(getMEName("PhibResidual","Segment", chId)));
-	int phibSummary = stat==3 ? 0 : 1; // station 3 has no meaningful MB3 phi bending information
-	
-	if (stat != 3 && PhibResidual && PhibResidual->GetEffectiveEntries()>10) {// station 3 has no meaningful MB3 phi bending information
-	  
-	  // Fill client histos
-	  if( whME[wh].find(fullName("PhibResidualMean")) == whME[wh].end() ){
-	    bookWheelHistos(wh,"PhibResidualMean");  
-	    bookWheelHistos(wh,"PhibResidualRMS");  
-	  }
-	  
-	  double peak = PhibResidual->GetBinCenter(PhibResidual->GetMaximumBin());
-	  double phibMean = 0;
-	  double phibRMS  = 0;
-	  try {
-	    PhibResidual->Fit("gaus","CQO","",peak-5,peak+5);
-	    TF1 *ffPhib = PhibResidual->GetFunction("gaus");
-	    if ( ffPhib ) {
-	      phibMean = ffPhib->GetParameter(1);
-	      phibRMS  = ffPhib->GetParameter(2);
-	    }
-	  } catch (cms::Exception& iException) {
-	    edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhibResidual for Wheel " << wh 
-				      <<" Sector " << sect << " Station " << stat;
+
+	std::map<std::string,MonitorElement*> &innerME = whME[wh];
+	fillWhPlot(innerME.find(fullName("PhiTkvsTrigSlope",src))->second,sect,stat,phiSlope-1);
+	fillWhPlot(innerME.find(fullName("PhiTkvsTrigIntercept",src))->second,sect,stat,phiInt);
+	fillWhPlot(innerME.find(fullName("PhiTkvsTrigCorr",src))->second,sect,stat,phiCorr,false);
+
+      }
+
+      // Perform Correlation Plots analysis (DCC + segment Phib)
+      TH2F * TrackPhibtkvsPhibtrig = getHisto<TH2F>(srcInputs[phibTkvsTrigInput]);
+
+      if (stat != 3 && TrackPhibtkvsPhibtrig && TrackPhibtkvsPhibtrig->GetEntries()>10) {// station 3 has no meaningful MB3 phi bending information
+
+	// Fill client histos
+	if( whME[wh].find(fullName("PhibTkvsTrigCorr",src)) == whME[wh].end() ){
+	  bookWheelHistos(src,wh,"PhibTkvsTrigSlope");  
+	  bookWheelHistos(src,wh,"PhibTkvsTrigIntercept");  
+	  bookWheelHistos(src,wh,"PhibTkvsTrigCorr");  
+	}
+
+	TProfile* PhibtkvsPhibtrigProf = TrackPhibtkvsPhibtrig->ProfileX(); 
+	double phibInt  = 0;
+	double phibSlope = 0;
+	double phibCorr  = 0;
+	try {
+	  PhibtkvsPhibtrigProf->Fit("pol1","CQO");
+	  TF1 *ffPhib= PhibtkvsPhibtrigProf->GetFunction("pol1");
+	  if (ffPhib) {
+	    phibInt   = ffPhib->GetParameter(0);
+	    phibSlope = ffPhib->GetParameter(1);
+	    phibCorr  = TrackPhibtkvsPhibtrig->GetCorrelationFactor();
 	  }
-	  
-	  std::map<std::string,MonitorElement*> &innerME = whME[wh];
-	  fillWhPlot(innerME.find(fullName("PhibResidualMean"))->second,sect,stat,phibMean);
-	  fillWhPlot(innerME.find(fullName("PhibResidualRMS"))->second,sect,stat,phibRMS);
-	  
-	  phibSummary = performLutTest(phibMean,phibRMS,thresholdPhibMean,thresholdPhibRMS);
-	  
+	} catch (cms::Exception& iException) {
+	  edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhibtkvsPhibtrig for Wheel " << wh 
+				    <<" Sector " << sect << " Station " << stat;
 	}
-	fillWhPlot(whME[wh].find(fullName("PhibLutSummary"))->second,sect,stat,phibSummary);
-	
+
+	std::map<std::string,MonitorElement*> &innerME = whME[wh];
+	fillWhPlot(innerME.find(fullName("PhibTkvsTrigSlope",src))->second,sect,stat,phibSlope-1);
+	fillWhPlot(innerME.find(fullName("PhibTkvsTrigIntercept",src))->second,sect,stat,phibInt);
+	fillWhPlot(innerME.find(fullName("PhibTkvsTrigCorr",src))->second,sect,stat,phibCorr,false);
+
       }
+
     }
-  }
-  
-  // Barrel Summary Plots
-  for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
-    trigSource = (*iTr);
-    for (vector<string>::const_iterator iHw = hwSources.begin(); iHw != hwSources.end(); ++iHw){
-      hwSource = (*iHw);  
-      for (int wh=-2; wh<=2; ++wh){
-	std::map<std::string,MonitorElement*> *innerME = &(whME[wh]);
-	
-	TH2F* phiWhSummary   = getHisto<TH2F>(innerME->find(fullName("PhiLutSummary"))->second);
-	TH2F* phibWhSummary  = getHisto<TH2F>(innerME->find(fullName("PhibLutSummary"))->second);
-	for (int sect=1; sect<=12; ++sect){
-	  int phiErr     = 0;
-	  int phibErr    = 0;
-	  int phiNoData  = 0;
-	  int phibNoData = 0;
-	  for (int stat=1; stat<=4; ++stat){
-	    switch (static_cast<int>(phiWhSummary->GetBinContent(sect,stat))) {
-	    case 1:
-	      phiNoData++;
-	    case 2:
-	    case 3:
-	      phiErr++;
-	    }
-	    switch (static_cast<int>(phibWhSummary->GetBinContent(sect,stat))) {
-	    case 1:
-	      phibNoData++;
-	    case 2:
-	    case 3:
-	      phibErr++;
-	    }
-	  }
-	  if (phiNoData == 4)  phiErr  = 5;
-	  if (phibNoData == 3) phibErr = 5;  // MB3 has no phib information
-	  cmsME.find(fullName("PhiLutSummary"))->second->setBinContent(sect,wh+3,phiErr);
-	  cmsME.find(fullName("PhibLutSummary"))->second->setBinContent(sect,wh+3,phibErr);
+
+    // Make Phi Residual Summary
+    TH1F * PhiResidual = getHisto<TH1F>(srcInputs[phiResidualInput]);
+    int phiSummary = 1;
+
+    if (PhiResidual && PhiResidual->GetEffectiveEntries()>10) {
+
+      // Fill client histos
+      if( whME[wh].find(fullName("PhiResidualMean",src)) == whME[wh].end() ){
+	bookWheelHistos(src,wh,"PhiResidualMean");  
+	bookWheelHistos(src,wh,"PhiResidualRMS");  
+      }
+
+      double peak = PhiResidual->GetBinCenter(PhiResidual->GetMaximumBin());
+      double phiMean = 0;
+      double phiRMS  = 0;
+      try {
+	PhiResidual->Fit("gaus","CQO","",peak-5,peak+5);
+	TF1 *ffPhi = PhiResidual->GetFunction("gaus");
+	if ( ffPhi ) {
+	  phiMean = ffPhi->GetParameter(1);
+	  phiRMS  = ffPhi->GetParameter(2);
 	}
+      } catch (cms::Exception& iException) {
+	edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhiResidual for Wheel " << wh 
+				  <<" Sector " << sect << " Station " << stat;
       }
+
+      std::map<std::string,MonitorElement*> &innerME = whME[wh];
+      fillWhPlot(innerME.find(fullName("PhiResidualMean",src))->second,sect,stat,phiMean);
+      fillWhPlot(innerME.find(fullName("PhiResidualRMS",src))->second,sect,stat,phiRMS);
+
+      phiSummary = performLutTest(phiMean,phiRMS,thresholdPhiMean,thresholdPhiRMS);
+
+    }
+    fillWhPlot(whME[wh].find(fullName("PhiLutSummary",src))->second,sect,stat,phiSummary);
+
+    // Make Phib Residual Summary
+    TH1F * PhibResidual = getHisto<TH1F>(srcInputs[phibResidualInput]);
+    int phibSummary = stat==3 ? 0 : 1; // station 3 has no meaningful MB3 phi bending information
+
+    if (stat != 3 && PhibResidual && PhibResidual->GetEffectiveEntries()>10) {// station 3 has no meaningful MB3 phi bending information
+
+      // Fill client histos
+      if( whME[wh].find(fullName("PhibResidualMean",src)) == whME[wh].end() ){
+	bookWheelHistos(src,wh,"PhibResidualMean");  
+	bookWheelHistos(src,wh,"PhibResidualRMS");  
+      }
+
+      double peak = PhibResidual->GetBinCenter(PhibResidual->GetMaximumBin());
+      double phibMean = 0;
+      double phibRMS  = 0;
+      try {
+	PhibResidual->Fit("gaus","CQO","",peak-5,peak+5);
+	TF1 *ffPhib = PhibResidual->GetFunction("gaus");
+	if ( ffPhib ) {
+	  phibMean = ffPhib->GetParameter(1);
+	  phibRMS  = ffPhib->GetParameter(2);
+	}
+      } catch (cms::Exception& iException) {
+	edm::LogError(category()) << "[" << testName << "Test]: Error fitting PhibResidual for Wheel " << wh 
+				  <<" Sector " << sect << " Station " << stat;
+      }
+
+      std::map<std::string,MonitorElement*> &innerME = whME[wh];
+      fillWhPlot(innerME.find(fullName("PhibResidualMean",src))->second,sect,stat,phibMean);
+      fillWhPlot(innerME.find(fullName("PhibResidualRMS",src))->second,sect,stat,phibRMS);
+
+      phibSummary = performLutTest(phibMean,phibRMS,thresholdPhibMean,thresholdPhibRMS);
+
     }
+    fillWhPlot(whME[wh].find(fullName("PhibLutSummary",src))->second,sect,stat,phibSummary);
+
   }
 
 }
@@ -39,6 +39,9 @@ protected:
   /// Run client analysis
   void runClientDiagnostic();
 
+  /// Run client analysis (per chamber, all the trig/hw sources)
+  void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs);
+
  private:
 
   /// Perform Lut Test logical operations
@@ -50,6 +53,8 @@ protected:
   double thresholdPhiMean, thresholdPhibMean;
   double thresholdPhiRMS, thresholdPhibRMS;
   bool doCorrStudy;
+  int phiTkvsTrigInput, phibTkvsTrigInput;
+  int phiResidualInput, phibResidualInput;
 
 };
 
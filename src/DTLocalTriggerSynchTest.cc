@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTLocalTriggerSynchTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -41,7 +42,8 @@ using namespace edm;
 using namespace std;
 
 
-DTLocalTriggerSynchTest::DTLocalTriggerSynchTest(const edm::ParameterSet& ps) {
+DTLocalTriggerSynchTest::DTLocalTriggerSynchTest(const edm::ParameterSet& ps) :
+  wPhaseMap(DTConditionsSnapshot::TPGParameters) {
 
   setConfig(ps,"DTLocalTriggerSynch");
   baseFolderDCC = "DT/90-LocalTriggerSynch/";
@@ -66,9 +68,13 @@ void DTLocalTriggerSynchTest::beginJob(){
   nBXHigh       = parameters.getParameter<int>("nBXHigh");
   minEntries    = parameters.getParameter<int>("minEntries");
 
+  numInput = addChamberInput(numHistoTag,"");
+  denInput = addChamberInput(denHistoTag,"");
+
 }
 
 void DTLocalTriggerSynchTest::beginRun(const Run& run, const EventSetup& c) {
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::Booking);
 
   DTLocalTriggerBaseTest::beginRun(run,c);
 
@@ -87,7 +93,8 @@ void DTLocalTriggerSynchTest::beginRun(const Run& run, const EventSetup& c) {
 	std::vector<DTChamber*>::const_iterator chambEnd = muonGeom->chambers().end();
 	for (; chambIt!=chambEnd; ++chambIt) { 
 	  DTChamberId chId = ((*chambIt)->id());
-	  bookChambHistos(chId,ratioHistoTag);
+	  // chamber MEs are booked on data unless eagerBooking is set
+	  if (bookingPolicy.materialize(chId.rawId(),false)) bookChambHistos(chId,ratioHistoTag);
 	}
       }
     }
@@ -96,9 +103,7 @@ void DTLocalTriggerSynchTest::beginRun(const Run& run, const EventSetup& c) {
   LogVerbatim(category()) << "[" << testName << "Test]: beginRun" << endl;
 
   if (parameters.getParameter<bool>("fineParamDiff")) {
-    ESHandle<DTTPGParameters> wPhaseHandle;
-    c.get<DTTPGParametersRcd>().get(wPhaseHandle);
-    wPhaseMap = (*wPhaseHandle);
+    wPhaseMap.update(c,*muonGeom);
   }
 
 }
@@ -106,49 +111,56 @@ void DTLocalTriggerSynchTest::beginRun(const Run& run, const EventSetup& c) {
 
 
 void DTLocalTriggerSynchTest::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTLocalTriggerSynchTest", DTClientPerformance::Diagnostic);
 
-  // Loop over Trig & Hw sources
-  for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
-    trigSource = (*iTr);
-    for (vector<string>::const_iterator iHw = hwSources.begin(); iHw != hwSources.end(); ++iHw){
-      hwSource = (*iHw);
-      std::vector<DTChamber*>::const_iterator chambIt  = muonGeom->chambers().begin();
-      std::vector<DTChamber*>::const_iterator chambEnd = muonGeom->chambers().end();
-      for (; chambIt!=chambEnd; ++chambIt) { 
-	DTChamberId chId = (*chambIt)->id();
-	uint32_t indexCh = chId.rawId();
+  // Single chamber sweep for all the Trig & Hw sources
+  sweepChambers();
 
-	// Perform peak finding
-	TH1F *numH     = getHisto<TH1F>(dbe->get(getMEName(numHistoTag,"", chId)));
-	TH1F *denH     = getHisto<TH1F>(dbe->get(getMEName(denHistoTag,"", chId)));
-	    
-	if (numH && denH && numH->GetEntries()>minEntries && denH->GetEntries()>minEntries) {	      
-	  std::map<std::string,MonitorElement*> innerME = chambME[indexCh];
-	  MonitorElement* ratioH = innerME.find(fullName(ratioHistoTag))->second;
-	  makeRatioME(numH,denH,ratioH);
-	  try {
-	    getHisto<TH1F>(ratioH)->Fit("pol8","CQO");
-	  } catch (cms::Exception& iException) {
-	    edm::LogPrint(category()) << "[" << testName 
-				     << "Test]: Error fitting " 
-				     << ratioH->getName() << " returned 0" << endl;
-	  }
-	} else { 
-	  if (!numH || !denH) {
-	    LogPrint(category()) << "[" << testName 
-				<< "Test]: At least one of the required Histograms was not found for chamber " 
-				<< chId << ". Peaks not computed" << endl;
-	  } else {
-	    LogPrint(category()) << "[" << testName 
-				<< "Test]: Number of plots entries for " 
-				<< chId << " is less than minEntries=" 
-				<< minEntries <<".  Peaks not computed" << endl;
-	  }
-	}
+}
+
+void DTLocalTriggerSynchTest::runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs) {
 
+  uint32_t indexCh = chId.rawId();
+  int nSources = sources.size();
+
+  for (int iSrc=0; iSrc<nSources; ++iSrc) {
+    const TrigHwSource& src = sources[iSrc];
+
+    // Perform peak finding
+    TH1F *numH     = getHisto<TH1F>(inputs[iSrc][numInput]);
+    TH1F *denH     = getHisto<TH1F>(inputs[iSrc][denInput]);
+	    
+    if (numH && denH && numH->GetEntries()>minEntries && denH->GetEntries()>minEntries) {	      
+      std::map<std::string,MonitorElement*> &innerME = chambME[indexCh];
+      if (innerME.find(fullName(ratioHistoTag,src)) == innerME.end()) {
+	bookingPolicy.materialize(indexCh,true);
+	trigSource = src.trig;
+	hwSource = src.hw;
+	bookChambHistos(chId,ratioHistoTag);
+      }
+      MonitorElement* ratioH = innerME.find(fullName(ratioHistoTag,src))->second;
+      makeRatioME(numH,denH,ratioH);
+      try {
+	getHisto<TH1F>(ratioH)->Fit("pol8","CQO");
+      } catch (cms::Exception& iException) {
+	edm::LogPrint(category()) << "[" << testName 
+				  << "Test]: Error fitting " 
+				  << ratioH->getName() << " returned 0" << endl;
+      }
+    } else { 
+      if (!numH || !denH) {
+	LogPrint(category()) << "[" << testName 
+			     << "Test]: At least one of the required Histograms was not found for chamber " 
+			     << chId << ". Peaks not computed" << endl;
+      } else {
+	LogPrint(category()) << "[" << testName 
+			     << "Test]: Number of plots entries for " 
+			     << chId << " is less than minEntries=" 
+			     << minEntries <<".  Peaks not computed" << endl;
       }
     }
-  }	
+
+  }
 
 }
 
@@ -175,7 +187,7 @@ void DTLocalTriggerSynchTest::endJob(){
 
 
 	TH1F *ratioH     = getHisto<TH1F>(dbe->get(getMEName(ratioHistoTag,"", chId)));    
-	if (ratioH->GetEntries()>minEntries) {	      
+	if (ratioH && ratioH->GetEntries()>minEntries) {	      
 	  TF1 *fitF=ratioH->GetFunction("pol8");
 	  if (fitF) { fineDelay=fitF->GetMaximumX(0,bxTime); }
 	} else {
@@ -185,9 +197,8 @@ void DTLocalTriggerSynchTest::endJob(){
 	}
 
 	if (fineDiff || coarseDiff) {
-	  float wFine;
-	  int wCoarse;
-	  wPhaseMap.get(chId,wCoarse,wFine,DTTimeUnits::ns);
+	  float wFine = wPhaseMap.tpgFineDelay(chId);
+	  int wCoarse = wPhaseMap.tpgCoarseDelay(chId);
 	  if (fineDiff)   { fineDelay = wFine - fineDelay; }
 	  if (coarseDiff) { coarseDelay = wCoarse - coarseDelay; }
 	} 
@@ -270,6 +281,6 @@ void DTLocalTriggerSynchTest::bookChambHistos(DTChamberId chambId, string htype,
   float max = rangeInBX ? bxTime : nBXHigh*bxTime;
   int nbins = static_cast<int>(ceil( rangeInBX ? bxTime : (nBXHigh-nBXLow)*bxTime));
 
-  chambME[indexChId][fullType] = dbe->book1D(HistoName.c_str(),"All/HH ratio vs Muon Arrival Time",nbins,min,max);
+  chambME[indexChId][fullType] = bookingPolicy.booked(dbe->book1D(HistoName.c_str(),"All/HH ratio vs Muon Arrival Time",nbins,min,max));
 
 }
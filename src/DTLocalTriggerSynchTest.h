@@ -14,6 +14,7 @@
 
 
 #include "DQM/DTMonitorClient/src/DTLocalTriggerBaseTest.h"
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
 #include "CondFormats/DTObjects/interface/DTTPGParameters.h"
 
 class DTTrigGeomUtils;
@@ -51,6 +52,9 @@ protected:
   /// DQM Client Diagnostic
   void runClientDiagnostic();
 
+  /// DQM Client Diagnostic (per chamber, all the trig/hw sources)
+  void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs);
+
  private:
 
   std::map<uint32_t,std::map<std::string,MonitorElement*> > chambME;
@@ -62,8 +66,10 @@ protected:
   int nBXLow;
   int nBXHigh;
   int minEntries;
+  int numInput;
+  int denInput;
   bool writeDB;
-  DTTPGParameters wPhaseMap;
+  DTConditionsSnapshot wPhaseMap;
 
 };
 
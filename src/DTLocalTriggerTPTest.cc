@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTLocalTriggerTPTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -48,7 +49,8 @@ DTLocalTriggerTPTest::~DTLocalTriggerTPTest(){
 }
 
 void DTLocalTriggerTPTest::beginJob(){
-  
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::Booking);
+
   DTLocalTriggerBaseTest::beginJob();
 
 
@@ -84,6 +86,7 @@ void DTLocalTriggerTPTest::beginRun(const edm::Run& r, const edm::EventSetup& c)
 
 
 void DTLocalTriggerTPTest::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTLocalTriggerTPTest", DTClientPerformance::Diagnostic);
 
   // Loop over Trig & Hw sources
   for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
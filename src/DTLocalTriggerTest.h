@@ -38,11 +38,17 @@ protected:
   /// Run client analysis
   void runClientDiagnostic();
 
+  /// Run client analysis (per chamber, all the trig/hw sources)
+  void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs);
+
   void fillGlobalSummary();
 
  private:
 
   int nMinEvts;
+  int dduVsDccInput;
+  int bxVsQualInput, bestQualInput, flag1stVsQualInput;
+  int thetaBxVsQualInput, thetaBestQualInput, thetaPosVsBxInput;
 
   
   
@@ -9,6 +9,8 @@
 
 
 #include <DQM/DTMonitorClient/src/DTNoiseAnalysisTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
 
 // Framework
 #include "FWCore/ServiceRegistry/interface/Service.h"
@@ -27,6 +29,11 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include "TH1F.h"
+#include "TH2F.h"
+
+#include <boost/bind.hpp>
+
 #include <iostream>
 #include <sstream>
 
@@ -36,7 +43,7 @@ using namespace edm;
 using namespace std;
 
 
-DTNoiseAnalysisTest::DTNoiseAnalysisTest(const edm::ParameterSet& ps){
+DTNoiseAnalysisTest::DTNoiseAnalysisTest(const edm::ParameterSet& ps) : asyncTask("DTNoiseAnalysisTest") {
   LogTrace("DTDQM|DTMonitorClient|DTNoiseAnalysisTest") << "[DTNoiseAnalysisTest]: Constructor";
 
   dbe = edm::Service<DQMStore>().operator->();
@@ -50,11 +57,25 @@ DTNoiseAnalysisTest::DTNoiseAnalysisTest(const edm::ParameterSet& ps){
   maxSynchNoiseRate =  ps.getUntrackedParameter<double>("maxSynchNoiseRate", 0.001);
   nMinEvts  = ps.getUntrackedParameter<int>("nEventsCert", 5000);
 
+  // run the wire scan of each LS in the background, the summaries are published at the next LS
+  asyncMode = ps.getUntrackedParameter<bool>("asyncMode", false);
+  snapshotPending = false;
+
 }
 
 
 DTNoiseAnalysisTest::~DTNoiseAnalysisTest(){
   LogTrace("DTDQM|DTMonitorClient|DTNoiseAnalysisTest") << "DTNoiseAnalysisTest: analyzed " << nevents << " events";
+
+  asyncTask.wait();
+  for(map<uint32_t, TH2F*>::iterator copy = snapshotCopies.begin();
+      copy != snapshotCopies.end(); ++copy) {
+    delete copy->second;
+  }
+  for(map<int, TH1F*>::iterator histo = scanNoiseHistos.begin();
+      histo != scanNoiseHistos.end(); ++histo) {
+    delete histo->second;
+  }
 }
 
 
@@ -91,86 +112,21 @@ void DTNoiseAnalysisTest::analyze(const edm::Event& e, const edm::EventSetup& co
 }
 
 void DTNoiseAnalysisTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTNoiseAnalysisTest", DTClientPerformance::EndLumi);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTNoiseAnalysisTest")
     <<"[DTNoiseAnalysisTest]: End of LS transition, performing the DQM client operation";
 
-  // Reset the summary plots
-  for(map<int, MonitorElement* >::iterator plot =  noiseHistos.begin();
-      plot != noiseHistos.end(); ++plot) {
-    (*plot).second->Reset();
-  }
-
-  for(map<int,  MonitorElement* >::iterator plot = noisyCellHistos.begin();
-      plot != noisyCellHistos.end(); ++plot) {
-    (*plot).second->Reset();
-  }
-
-  summaryNoiseHisto->Reset();
-
-
-
-  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
-  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
-
-  LogTrace ("DTDQM|DTMonitorClient|DTNoiseAnalysisTest")
-    <<"[DTNoiseAnalysisTest]: Fill the summary histos";
-
-  for (; ch_it != ch_end; ++ch_it) { // loop over chambers
-    DTChamberId chID = (*ch_it)->id();
-
-    MonitorElement * histo = dbe->get(getMEName(chID));
-
-    if(histo) { // check the pointer
-
-      TH2F * histo_root = histo->getTH2F();
-
-      for(int sl = 1; sl != 4; ++sl) { // loop over SLs
-        // skip theta SL in MB4 chambers
-        if(chID.station() == 4 && sl == 2) continue;
-
-        int binYlow = ((sl-1)*4)+1;
-
-        for(int layer = 1; layer <= 4; ++layer) { // loop over layers
-
-          // Get the layer ID
-          DTLayerId layID(chID,sl,layer);
-
-          int nWires = muonGeom->layer(layID)->specificTopology().channels();
-          int firstWire = muonGeom->layer(layID)->specificTopology().firstChannel();
-
-          int binY = binYlow+(layer-1);
-
-          for(int wire = firstWire; wire != (nWires+firstWire); wire++){ // loop over wires
-
-            double noise = histo_root->GetBinContent(wire, binY);
-            // fill the histos
-            noiseHistos[chID.wheel()]->Fill(noise);
-            noiseHistos[3]->Fill(noise);
-            int sector = chID.sector();
-            if(noise>noisyCellDef) {
-              if(sector == 13) {
-                sector = 4;
-              } else if(sector == 14) {
-                sector = 10;
-              }
-              noisyCellHistos[chID.wheel()]->Fill(sector,chID.station());
-              summaryNoiseHisto->Fill(sector,chID.wheel());
-            }
-          }
-        }
-      }
-    }
-  }
-
-  if(detailedAnalysis) {
-    threshChannelsHisto->Reset();
-    TH1F * histo = noiseHistos[3]->getTH1F();
-    for(int step = 0; step != 15; step++) {
-      int threshBin = step + 1;
-      int minBin = 26 + step*5;
-      int nNoisyCh = histo->Integral(minBin,101);
-      threshChannelsHisto->setBinContent(threshBin,nNoisyCh);
-    }
+  if(asyncMode) {
+    // publish the wire scan of the previous LS, then hand this one to the background task
+    asyncTask.wait();
+    publishNoise();
+    takeSnapshot();
+    asyncTask.start(boost::bind(&DTNoiseAnalysisTest::runWireScan, this));
+  } else {
+    takeSnapshot();
+    runWireScan();
+    publishNoise();
   }
 
   // build the summary of synch noise
@@ -211,24 +167,182 @@ void DTNoiseAnalysisTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, Eve
 
   }
 
-  string nEvtsName = "DT/EventInfo/Counters/nProcessedEventsNoise";
-  MonitorElement * meProcEvts = dbe->get(nEvtsName);
+  const DTEventCounters& counters = DTEventCounters::get(dbe, lumiSeg.run(), lumiSeg.id().luminosityBlock());
 
-  if (meProcEvts) {
-    int nProcEvts = meProcEvts->getFloatValue();
+  if (counters.found(DTEventCounters::Noise)) {
+    int nProcEvts = counters.events(DTEventCounters::Noise);
     glbSummarySynchNoiseHisto->setEntries(nProcEvts < nMinEvts ? 10. : nProcEvts);
     summarySynchNoiseHisto->setEntries(nProcEvts < nMinEvts ? 10. : nProcEvts);
   } else {
     glbSummarySynchNoiseHisto->setEntries(nMinEvts +1);
     summarySynchNoiseHisto->setEntries(nMinEvts + 1);
     LogVerbatim ("DTDQM|DTMonitorClient|DTnoiseAnalysisTest") << "[DTNoiseAnalysisTest] ME: "
-      <<  nEvtsName << " not found!" << endl;
+      <<  DTEventCounters::meName(DTEventCounters::Noise) << " not found!" << endl;
   }
 
 
 }	       
 
 
+void DTNoiseAnalysisTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTNoiseAnalysisTest", DTClientPerformance::EndRun);
+
+  asyncTask.wait();
+  publishNoise();
+
+}
+
+
+void DTNoiseAnalysisTest::endJob() {
+
+  LogTrace("DTDQM|DTMonitorClient|DTNoiseAnalysisTest") <<"[DTNoiseAnalysisTest]: EndJob";
+
+  asyncTask.wait();
+  if(asyncMode) asyncTask.report();
+
+}
+
+
+void DTNoiseAnalysisTest::takeSnapshot() {
+
+  snapshots.clear();
+
+  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
+
+  for (; ch_it != ch_end; ++ch_it) { // loop over chambers
+    DTChamberId chID = (*ch_it)->id();
+
+    MonitorElement * histo = dbe->get(getMEName(chID));
+
+    if(histo) { // check the pointer
+      TH2F * histo_root = histo->getTH2F();
+      if(asyncMode) {
+	// the copies are booked once and refilled at each LS
+	TH2F*& copy = snapshotCopies[chID.rawId()];
+	if(copy == 0) {
+	  copy = (TH2F*) histo_root->Clone();
+	  copy->SetDirectory(0);
+	}
+	copy->Reset();
+	copy->Add(histo_root);
+	histo_root = copy;
+      }
+      snapshots.push_back(make_pair(chID, histo_root));
+    }
+  }
+
+  snapshotPending = true;
+
+}
+
+
+void DTNoiseAnalysisTest::runWireScan() {
+
+  for(map<int, TH1F*>::iterator plot = scanNoiseHistos.begin();
+      plot != scanNoiseHistos.end(); ++plot) {
+    (*plot).second->Reset();
+  }
+  for(int wh = 0; wh != 5; ++wh) {
+    for(int sect = 0; sect != 12; ++sect) {
+      for(int sta = 0; sta != 4; ++sta) {
+	scanNoisyCells[wh][sect][sta] = 0;
+      }
+    }
+  }
+
+  for(vector<pair<DTChamberId, TH2F*> >::const_iterator snapshot = snapshots.begin();
+      snapshot != snapshots.end(); ++snapshot) { // loop over chambers
+    const DTChamberId& chID = snapshot->first;
+    TH2F * histo_root = snapshot->second;
+
+    for(int sl = 1; sl != 4; ++sl) { // loop over SLs
+      // skip theta SL in MB4 chambers
+      if(chID.station() == 4 && sl == 2) continue;
+
+      int binYlow = ((sl-1)*4)+1;
+
+      for(int layer = 1; layer <= 4; ++layer) { // loop over layers
+
+	// Get the layer ID
+	DTLayerId layID(chID,sl,layer);
+
+	int nWires = muonGeom->layer(layID)->specificTopology().channels();
+	int firstWire = muonGeom->layer(layID)->specificTopology().firstChannel();
+
+	int binY = binYlow+(layer-1);
+
+	for(int wire = firstWire; wire != (nWires+firstWire); wire++){ // loop over wires
+
+	  double noise = histo_root->GetBinContent(wire, binY);
+	  // fill the histos
+	  scanNoiseHistos[chID.wheel()]->Fill(noise);
+	  scanNoiseHistos[3]->Fill(noise);
+	  int sector = chID.sector();
+	  if(noise>noisyCellDef) {
+	    if(sector == 13) {
+	      sector = 4;
+	    } else if(sector == 14) {
+	      sector = 10;
+	    }
+	    scanNoisyCells[chID.wheel()+2][sector-1][chID.station()-1]++;
+	  }
+	}
+      }
+    }
+  }
+
+}
+
+
+void DTNoiseAnalysisTest::publishNoise() {
+
+  if(!snapshotPending) return;
+  snapshotPending = false;
+
+  LogTrace ("DTDQM|DTMonitorClient|DTNoiseAnalysisTest")
+    <<"[DTNoiseAnalysisTest]: Fill the summary histos";
+
+  // Reset the summary plots
+  for(map<int, MonitorElement* >::iterator plot =  noiseHistos.begin();
+      plot != noiseHistos.end(); ++plot) {
+    (*plot).second->Reset();
+    (*plot).second->getTH1F()->Add(scanNoiseHistos[(*plot).first]);
+  }
+
+  for(map<int,  MonitorElement* >::iterator plot = noisyCellHistos.begin();
+      plot != noisyCellHistos.end(); ++plot) {
+    (*plot).second->Reset();
+  }
+
+  summaryNoiseHisto->Reset();
+
+  for(int wh = -2; wh <= 2; ++wh) {
+    for(int sect = 1; sect <= 12; ++sect) {
+      for(int sta = 1; sta <= 4; ++sta) {
+	// one fill per noisy cell, as the entries count the noisy cells
+	for(int cell = 0; cell != scanNoisyCells[wh+2][sect-1][sta-1]; ++cell) {
+	  noisyCellHistos[wh]->Fill(sect,sta);
+	  summaryNoiseHisto->Fill(sect,wh);
+	}
+      }
+    }
+  }
+
+  if(detailedAnalysis) {
+    threshChannelsHisto->Reset();
+    TH1F * histo = noiseHistos[3]->getTH1F();
+    for(int step = 0; step != 15; step++) {
+      int threshBin = step + 1;
+      int minBin = 26 + step*5;
+      int nNoisyCh = histo->Integral(minBin,101);
+      threshChannelsHisto->setBinContent(threshBin,nNoisyCh);
+    }
+  }
+
+}
+
+
 string DTNoiseAnalysisTest::getMEName(const DTChamberId & chID) {
 
   stringstream wheel; wheel << chID.wheel();	
@@ -267,6 +381,14 @@ void DTNoiseAnalysisTest::bookHistos() {
   noiseHistos[3]->setAxisTitle("rate (Hz)",1);
   noiseHistos[3]->setAxisTitle("entries",2);
 
+  // private copies filled by the wire scan
+  for(map<int, MonitorElement* >::iterator plot =  noiseHistos.begin();
+      plot != noiseHistos.end(); ++plot) {
+    TH1F * histo = (TH1F*) (*plot).second->getTH1F()->Clone();
+    histo->SetDirectory(0);
+    scanNoiseHistos[(*plot).first] = histo;
+  }
+
 
   for(int wh=-2; wh<=2; wh++){
     stringstream wheel; wheel << wh;
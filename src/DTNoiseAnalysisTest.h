@@ -16,20 +16,25 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include <FWCore/Framework/interface/EDAnalyzer.h>
 #include <FWCore/Framework/interface/ESHandle.h>
+#include <DataFormats/MuonDetId/interface/DTChamberId.h>
+#include "DQM/DTMonitorClient/src/DTAsyncClientTask.h"
 
 
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
 
 
 
 
 class DTGeometry;
-class DTChamberId;
 class DTSuperLayerId;
 class DQMStore;
 class MonitorElement;
+class TH1F;
+class TH2F;
 
 class DTNoiseAnalysisTest: public edm::EDAnalyzer{
 
@@ -60,6 +65,12 @@ protected:
   /// DQM Client Diagnostic
   void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& c);
 
+  /// EndRun: publish the results of the LS in flight
+  void endRun(edm::Run const& run, edm::EventSetup const& context);
+
+  /// Endjob
+  void endJob();
+
 
 private:
 
@@ -67,6 +78,15 @@ private:
   std::string getMEName(const DTChamberId & chID);
   std::string getSynchNoiseMEName(int wheelId) const;
 
+  /// Collect the noise rate histos of the LS: copies in async mode, the ME histos otherwise
+  void takeSnapshot();
+
+  /// Scan the wires of the snapshot (in the background in async mode)
+  void runWireScan();
+
+  /// Fill the noise summaries with the result of the last wire scan
+  void publishNoise();
+
 
   int nevents;
   int nMinEvts;
@@ -90,6 +110,16 @@ private:
   bool doSynchNoise;
   bool detailedAnalysis;
   double maxSynchNoiseRate;
+
+  // Asynchronous mode: the wire scan of a LS runs while the framework goes on
+  bool asyncMode;
+  DTAsyncClientTask asyncTask;
+  std::vector<std::pair<DTChamberId, TH2F*> > snapshots;
+  std::map<uint32_t, TH2F*> snapshotCopies;
+  bool snapshotPending;
+  // result of the wire scan, copied to the MEs by publishNoise
+  std::map<int, TH1F*> scanNoiseHistos;
+  int scanNoisyCells[5][12][4];
 };
 
 #endif
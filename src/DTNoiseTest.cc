@@ -10,6 +10,7 @@
  */
 
 #include "DQM/DTMonitorClient/src/DTNoiseTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/EventSetup.h>
@@ -35,7 +36,9 @@ using namespace std;
 
 
 
-DTNoiseTest::DTNoiseTest(const edm::ParameterSet& ps){
+DTNoiseTest::DTNoiseTest(const edm::ParameterSet& ps) :
+  conditions(DTConditionsSnapshot::TTrig | DTConditionsSnapshot::StatusFlag),
+  badChannelCollector(ps,"DTNoiseTest","tTrigCalibration",false), bookingPolicy(ps,"DTNoiseTest") {
 
   edm::LogVerbatim ("noise") <<"[DTNoiseTest]: Constructor";  
 
@@ -46,6 +49,8 @@ DTNoiseTest::DTNoiseTest(const edm::ParameterSet& ps){
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 1);
 
+  meanTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("meanTestName","NoiseMeanInRange"));
+
 }
 
 
@@ -64,6 +69,8 @@ void DTNoiseTest::beginJob(){
 
   updates = 0;
 
+  badChannelCollector.bookHistos(dbe,"DT/Tests/Noise");
+
 }
 
 
@@ -97,6 +104,7 @@ void DTNoiseTest::analyze(const edm::Event& e, const edm::EventSetup& context){
 
 
 void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTNoiseTest", DTClientPerformance::EndLumi);
 
   // counts number of updats (online mode) or number of events (standalone mode)
   //updates++;
@@ -117,11 +125,8 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
 
   edm::LogVerbatim ("noise") <<"[DTNoiseTest]: "<<nLumiSegs<<" updates";
 
-  ESHandle<DTStatusFlag> statusMap;
-  context.get<DTStatusFlagRcd>().get(statusMap);
-  
-  context.get<DTTtrigRcd>().get(tTrigMap);
-  float tTrig, tTrigRMS, kFactor;
+  // tTrig and status flags are read only if their IOV changed
+  conditions.update(context,*muonGeom);
 
   string histoTag;
   // loop over chambers
@@ -151,7 +156,7 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
 	const DTSuperLayerId & slID = (*sl_it)->id();
 	    
         // ttrig and rms are counts
-	tTrigMap->get(slID, tTrig, tTrigRMS, kFactor, DTTimeUnits::counts);
+	float tTrig = conditions.tTrig(slID);
 	if (tTrig==0) tTrig=1;
 	const double ns_s = 1e9*(32/25);
 	normalization = ns_s/float(tTrig*nevents);
@@ -183,25 +188,20 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
 	}
 	    
 	if (nOfChannels) noiseStatistics = average/nOfChannels;
-	histoTag = "NoiseAverage";
-
-	if (histos[histoTag].find((*ch_it)->id().rawId()) == histos[histoTag].end()) bookHistos((*ch_it)->id(),string("NoiseAverage"), histoTag );
-	histos[histoTag].find((*ch_it)->id().rawId())->second->setBinContent(slID.superLayer(),noiseStatistics); 
-
 	for ( vector<DTWireId>::const_iterator nb_it = theNoisyChannels.begin();
 	      nb_it != theNoisyChannels.end(); ++nb_it) {
 	      
-	  bool isNoisy = false;
-	  bool isFEMasked = false;
-	  bool isTDCMasked = false;
-	  bool isTrigMask = false;
-	  bool isDead = false;
-	  bool isNohv = false;
-	  statusMap->cellStatus((*nb_it), isNoisy, isFEMasked, isTDCMasked, isTrigMask, isDead, isNohv);
-	    	      
-	  if (!isNoisy) newNoiseChannels++;
+	  if (!(conditions.cellStatus(*nb_it) & DTConditionsSnapshot::Noisy)) newNoiseChannels++;
 	}
 	theNoisyChannels.clear();
+
+	// the chamber MEs are booked once the chamber has data or new noisy channels (or up front with eagerBooking)
+	if (!bookingPolicy.materialize(ch.rawId(), nevents != 0, newNoiseChannels != 0)) continue;
+
+	histoTag = "NoiseAverage";
+	if (histos[histoTag].find((*ch_it)->id().rawId()) == histos[histoTag].end()) bookHistos((*ch_it)->id(),string("NoiseAverage"), histoTag );
+	histos[histoTag].find((*ch_it)->id().rawId())->second->setBinContent(slID.superLayer(),noiseStatistics); 
+
 	histoTag = "NewNoisyChannels";
 	if (histos[histoTag].find((*ch_it)->id().rawId()) == histos[histoTag].end()) bookHistos((*ch_it)->id(),string("NewNoisyChannels"), histoTag );
 	histos[histoTag].find((*ch_it)->id().rawId())->second->setBinContent(slID.superLayer(), newNoiseChannels);   
@@ -223,6 +223,7 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
 	  int nWires = muonGeom->layer(lID)->specificTopology().channels();
 	  double MeanNumerator=0, MeanDenominator=0;
 	  histoTag = "MeanDigiPerEvent";
+	  if (!bookingPolicy.materialize(lID.rawId(), noiseHistoPerEvent->GetEntries() != 0)) continue;
 	  for (int w=1; w<=nWires; w++){
 	    for(int numDigi=1; numDigi<=10; numDigi++){
 	      MeanNumerator+=(noiseHistoPerEvent->GetBinContent(w,numDigi)*(numDigi-1));
@@ -239,21 +240,13 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
   
   // Noise Mean test 
   histoTag = "MeanDigiPerEvent";
-  string MeanCriterionName = parameters.getUntrackedParameter<string>("meanTestName","NoiseMeanInRange");
+  badChannelCollector.beginCollection(nLumiSegs);
   for(map<uint32_t, MonitorElement*>::const_iterator hMean = histos[histoTag].begin();
       hMean != histos[histoTag].end();
       hMean++) {
-    const QReport * theMeanQReport = (*hMean).second->getQReport(MeanCriterionName);
-    if(theMeanQReport) {
-      vector<dqm::me_util::Channel> badChannels = theMeanQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	   channel != badChannels.end(); channel++) {
-	LogVerbatim ("tTrigCalibration")<<"LayerId : "<<(*hMean).first<<" Bad mean channels: "<<(*channel).getBin()<<"  Contents : "<<(*channel).getContents();
-	// FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-	// LogVerbatim ("tTrigCalibration") << "-------- LayerId : "<<(*hMean).first<<"  "<<theMeanQReport->getMessage()<<" ------- "<<theMeanQReport->getStatus(); 
-      }
-    }
+    badChannelCollector.collect((*hMean).second,meanTest,(*hMean).first);
   }
+  badChannelCollector.endCollection();
   
 }
 
@@ -262,6 +255,7 @@ void DTNoiseTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup
 void DTNoiseTest::endJob(){
 
   edm::LogVerbatim ("noise") <<"[DTNoiseTest] endjob called!";
+  bookingPolicy.report();
   
   //if ( parameters.getUntrackedParameter<bool>("writeHisto", true) ) 
   //  dbe->save(parameters.getUntrackedParameter<string>("outputFile", "DTNoiseTest.root"));
@@ -334,10 +328,10 @@ void DTNoiseTest::bookHistos(const DTChamberId & ch, string folder, string histo
   string histoName =  histoTag + "W" + wheel.str() + "_St" + station.str() + "_Sec" + sector.str(); 
  
   if (folder == "NoiseAverage")
-  (histos[histoTag])[ch.rawId()] = dbe->book1D(histoName.c_str(),histoName.c_str(),3,0,3);
+  (histos[histoTag])[ch.rawId()] = bookingPolicy.booked(dbe->book1D(histoName.c_str(),histoName.c_str(),3,0,3));
  
   if ( folder == "NewNoisyChannels")
-  (histos[histoTag])[ch.rawId()] = dbe->book1D(histoName.c_str(),histoName.c_str(),3,0,3);
+  (histos[histoTag])[ch.rawId()] = bookingPolicy.booked(dbe->book1D(histoName.c_str(),histoName.c_str(),3,0,3));
   
 }
 
@@ -357,6 +351,6 @@ void DTNoiseTest::bookHistos(const DTLayerId & lId, int nWires, string folder, s
 			"/Station" + station.str() +
 			"/Sector" + sector.str());
 
-  (histos[histoTag])[lId.rawId()] = dbe->book1D(histoName.c_str(),histoName.c_str(),nWires,0,nWires);
+  (histos[histoTag])[lId.rawId()] = bookingPolicy.booked(dbe->book1D(histoName.c_str(),histoName.c_str(),nWires,0,nWires));
 
 }
@@ -29,12 +29,9 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
-#include <CondFormats/DTObjects/interface/DTTtrig.h>
-#include <CondFormats/DataRecord/interface/DTTtrigRcd.h>
-
-#include <CondFormats/DataRecord/interface/DTStatusFlagRcd.h>
-#include <CondFormats/DTObjects/interface/DTStatusFlag.h>
-
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+#include "DQM/DTMonitorClient/src/DTBookingPolicy.h"
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
 
 #include <memory>
 #include <iostream>
@@ -103,7 +100,7 @@ private:
   
   edm::ParameterSet parameters;
   edm::ESHandle<DTGeometry> muonGeom;
-  edm::ESHandle<DTTtrig> tTrigMap;
+  DTConditionsSnapshot conditions;
 
   // the collection of noisy channels
   //std::map< uint32_t, std::vector<DTWireId> > theNoisyChannels;
@@ -114,6 +111,10 @@ private:
   //std::map<  uint32_t , MonitorElement* > histos;
   std::map<std::string, std::map<uint32_t, MonitorElement*> > histos;
 
+  DTBadChannelCollector badChannelCollector;
+  DTBookingPolicy bookingPolicy;
+  int meanTest;
+
 };
 
 #endif
@@ -10,7 +10,10 @@
 
 
 #include <DQM/DTMonitorClient/src/DTOccupancyTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 #include <DQM/DTMonitorClient/src/DTOccupancyClusterBuilder.h>
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
+#include "DQM/DTMonitorClient/src/DTBookingTable.h"
 
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Framework/interface/LuminosityBlock.h"
@@ -24,13 +27,21 @@
 
 #include "TMath.h"
 
+#include <boost/bind.hpp>
+
 using namespace edm;
 using namespace std;
 
+namespace {
+  // wheel and global summaries
+  const DTHistoSpec wheelSummarySpec = { "", 12, 1., 13., 4, 1., 5., 0, 0, DTBookingTable::stationLabels, 4, "sector", 0 };
+  const DTHistoSpec glbSummarySpec   = { "", 12, 1., 13., 5, -2., 3., 0, 0, 0, 0, "sector", "wheel" };
+}
+
 
 
 
-DTOccupancyTest::DTOccupancyTest(const edm::ParameterSet& ps){
+DTOccupancyTest::DTOccupancyTest(const edm::ParameterSet& ps) : asyncTask("DTOccupancyTest") {
   LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest]: Constructor";
 
   // Get the DQM service
@@ -52,6 +63,15 @@ DTOccupancyTest::DTOccupancyTest(const edm::ParameterSet& ps){
   runOnInTimeOccupancies = ps.getUntrackedParameter<bool>("runOnInTimeOccupancies", false);
   nMinEvts  = ps.getUntrackedParameter<int>("nEventsCert", 5000);
 
+  // run the test of each LS in the background, the summaries are published at the next LS
+  asyncMode = ps.getUntrackedParameter<bool>("asyncMode", false);
+  if(asyncMode && writeRootFile) {
+    LogWarning("DTDQM|DTMonitorClient|DTOccupancyTest")
+      << "[DTOccupancyTest]: the ntuple can not be filled in asyncMode, writeRootFile ignored";
+    writeRootFile = false;
+  }
+  snapshotPending = false;
+
 }
 
 
@@ -60,6 +80,11 @@ DTOccupancyTest::DTOccupancyTest(const edm::ParameterSet& ps){
 DTOccupancyTest::~DTOccupancyTest(){
   LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << " destructor called" << endl;
 
+  asyncTask.wait();
+  for(map<uint32_t, TH2F*>::iterator copy = snapshotCopies.begin();
+      copy != snapshotCopies.end(); ++copy) {
+    delete copy->second;
+  }
 
 }
 
@@ -67,6 +92,7 @@ DTOccupancyTest::~DTOccupancyTest(){
 
 
 void DTOccupancyTest::beginJob(){
+  DTClientPerformance::Timer timer("DTOccupancyTest", DTClientPerformance::Booking);
   LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest]: BeginJob";
 
   // Event counter
@@ -84,14 +110,10 @@ void DTOccupancyTest::beginJob(){
     title = "Test Pulse Occupancy Summary";
   }
   //   - global summary with alarms
-  summaryHisto = dbe->book2D("OccupancySummary",title.c_str(),12,1,13,5,-2,3);
-  summaryHisto->setAxisTitle("sector",1);
-  summaryHisto->setAxisTitle("wheel",2);
+  summaryHisto = DTBookingTable::book(dbe,glbSummarySpec,"OccupancySummary",title);
   
   //   - global summary with percentages
-  glbSummaryHisto = dbe->book2D("OccupancyGlbSummary",title.c_str(),12,1,13,5,-2,3);
-  glbSummaryHisto->setAxisTitle("sector",1);
-  glbSummaryHisto->setAxisTitle("wheel",2);
+  glbSummaryHisto = DTBookingTable::book(dbe,glbSummarySpec,"OccupancyGlbSummary",title);
 
 
   // assign the name of the input histogram
@@ -139,15 +161,39 @@ void DTOccupancyTest::analyze(const Event& e, const EventSetup& context) {
 
 
 void DTOccupancyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTOccupancyTest", DTClientPerformance::EndLumi);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest")
     <<"[DTOccupancyTest]: End of LS transition, performing the DQM client operation";
   lsCounter++;
 
+  if(asyncMode) {
+    // publish the results of the previous LS, then hand this one to the background task
+    asyncTask.wait();
+    publishResults();
+    takeSnapshot(lumiSeg);
+    asyncTask.start(boost::bind(&DTOccupancyTest::runTests, this));
+  } else {
+    takeSnapshot(lumiSeg);
+    runTests();
+    publishResults();
+  }
 
+}
 
-  // Reset the global summary
-  summaryHisto->Reset();
-  glbSummaryHisto->Reset();
+
+void DTOccupancyTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTOccupancyTest", DTClientPerformance::EndRun);
+
+  asyncTask.wait();
+  publishResults();
+
+}
+
+
+void DTOccupancyTest::takeSnapshot(LuminosityBlock const& lumiSeg) {
+
+  snapshots.clear();
 
   // Get all the DT chambers
   vector<DTChamber*> chambers = muonGeom->chambers();
@@ -158,56 +204,109 @@ void DTOccupancyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSe
 
     MonitorElement * chamberOccupancyHisto = dbe->get(getMEName(nameMonitoredHisto, chId));	
 
-    // Run the tests on the plot for the various granularities
     if(chamberOccupancyHisto != 0) {
-      // Get the 2D histo
-      TH2F* histo = chamberOccupancyHisto->getTH2F();
-      float chamberPercentage = 1.;
-      int result = runOccupancyTest(histo, chId, chamberPercentage);
-      int sector = chId.sector();
-
-      if(sector == 13) {
-	sector = 4;
-	float resultSect4 = wheelHistos[chId.wheel()]->getBinContent(sector, chId.station());
-	if(resultSect4 > result) {
-	  result = (int)resultSect4;
-	}
-      } else if(sector == 14) {
-	sector = 10;
-	float resultSect10 = wheelHistos[chId.wheel()]->getBinContent(sector, chId.station());
-	if(resultSect10 > result) {
-	  result = (int)resultSect10;
+      ChamberSnapshot snapshot;
+      snapshot.chId = chId;
+      snapshot.me = chamberOccupancyHisto;
+      snapshot.histo = chamberOccupancyHisto->getTH2F();
+      snapshot.result = 0;
+      snapshot.chamberPercentage = 1.;
+      if(asyncMode) {
+	// the copies are booked once and refilled at each LS
+	TH2F*& copy = snapshotCopies[chId.rawId()];
+	if(copy == 0) {
+	  copy = (TH2F*) snapshot.histo->Clone();
+	  copy->SetDirectory(0);
 	}
+	copy->Reset();
+	copy->Add(snapshot.histo);
+	snapshot.histo = copy;
       }
-      
-      // the 2 MB4 of Sect 4 and 10 count as half a chamber
-      if((sector == 4 || sector == 10) && chId.station() == 4) 
-	chamberPercentage = chamberPercentage/2.;
-
-      wheelHistos[chId.wheel()]->setBinContent(sector, chId.station(),result);
-      if(result > summaryHisto->getBinContent(sector, chId.wheel()+3)) {
-	summaryHisto->setBinContent(sector, chId.wheel()+3, result);
-      }
-      glbSummaryHisto->Fill(sector, chId.wheel(), chamberPercentage*1./4.);
+      snapshots.push_back(snapshot);
     } else {
       LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest] ME: "
 				      << getMEName(nameMonitoredHisto, chId) << " not found!" << endl;
     }
+  }
 
+  const DTEventCounters& counters = DTEventCounters::get(dbe, lumiSeg.run(), lumiSeg.id().luminosityBlock());
+  snapshotCountersFound = counters.found(DTEventCounters::Digi);
+  snapshotEvents = counters.events(DTEventCounters::Digi);
+  snapshotPending = true;
+
+}
+
+
+void DTOccupancyTest::runTests() {
+
+  // Run the tests on the plot for the various granularities
+  for(vector<ChamberSnapshot>::iterator snapshot = snapshots.begin();
+      snapshot != snapshots.end(); ++snapshot) {
+    snapshot->result = runOccupancyTest(snapshot->histo, snapshot->chId, snapshot->chamberPercentage);
   }
 
-  string nEvtsName = "DT/EventInfo/Counters/nProcessedEventsDigi";
-  MonitorElement * meProcEvts = dbe->get(nEvtsName);
+}
+
+
+void DTOccupancyTest::publishResults() {
+
+  if(!snapshotPending) return;
+  snapshotPending = false;
+
+  // Reset the global summary
+  summaryHisto->Reset();
+  glbSummaryHisto->Reset();
+
+  for(vector<ChamberSnapshot>::const_iterator snapshot = snapshots.begin();
+      snapshot != snapshots.end(); ++snapshot) {
+    DTChamberId chId = snapshot->chId;
+    int result = snapshot->result;
+    float chamberPercentage = snapshot->chamberPercentage;
+    int sector = chId.sector();
+
+    // copy the alert bits set by the test to the ME (used by render plugins)
+    if(asyncMode) {
+      TH2F* histo = snapshot->me->getTH2F();
+      int alertBin = snapshot->histo->GetNbinsX() + 1;
+      for(int binY = 1; binY <= snapshot->histo->GetNbinsY(); ++binY) {
+	histo->SetBinContent(alertBin, binY, snapshot->histo->GetBinContent(alertBin, binY));
+      }
+    }
+
+    if(sector == 13) {
+      sector = 4;
+      float resultSect4 = wheelHistos[chId.wheel()]->getBinContent(sector, chId.station());
+      if(resultSect4 > result) {
+	result = (int)resultSect4;
+      }
+    } else if(sector == 14) {
+      sector = 10;
+      float resultSect10 = wheelHistos[chId.wheel()]->getBinContent(sector, chId.station());
+      if(resultSect10 > result) {
+	result = (int)resultSect10;
+      }
+    }
+      
+    // the 2 MB4 of Sect 4 and 10 count as half a chamber
+    if((sector == 4 || sector == 10) && chId.station() == 4) 
+      chamberPercentage = chamberPercentage/2.;
+
+    wheelHistos[chId.wheel()]->setBinContent(sector, chId.station(),result);
+    if(result > summaryHisto->getBinContent(sector, chId.wheel()+3)) {
+      summaryHisto->setBinContent(sector, chId.wheel()+3, result);
+    }
+    glbSummaryHisto->Fill(sector, chId.wheel(), chamberPercentage*1./4.);
+  }
 
-  if (meProcEvts) {
-    int nProcEvts = meProcEvts->getFloatValue();
+  if (snapshotCountersFound) {
+    int nProcEvts = snapshotEvents;
     glbSummaryHisto->setEntries(nProcEvts < nMinEvts ? 10. : nProcEvts);
     summaryHisto->setEntries(nProcEvts < nMinEvts ? 10. : nProcEvts);
   } else {
     glbSummaryHisto->setEntries(nMinEvts +1);
     summaryHisto->setEntries(nMinEvts + 1);
     LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest] ME: "
-		       <<  nEvtsName << " not found!" << endl;
+		       <<  DTEventCounters::meName(DTEventCounters::Digi) << " not found!" << endl;
   }
 
   // Fill the global summary
@@ -222,6 +321,8 @@ void DTOccupancyTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSe
 void DTOccupancyTest::endJob(){
 
   LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest] endjob called!";
+  asyncTask.wait();
+  if(asyncMode) asyncTask.report();
   if(writeRootFile) {
     rootFile->cd();
     ntuple->Write();
@@ -252,12 +353,7 @@ void DTOccupancyTest::bookHistos(const int wheelId, string folder, string histoT
   if(tpMode) {
     histoTitle = "TP Occupancy summary WHEEL: "+wheel.str();
   }
-  wheelHistos[wheelId] = dbe->book2D(histoName,histoTitle,12,1,13,4,1,5);
-  wheelHistos[wheelId]->setBinLabel(1,"MB1",2);
-  wheelHistos[wheelId]->setBinLabel(2,"MB2",2);
-  wheelHistos[wheelId]->setBinLabel(3,"MB3",2);
-  wheelHistos[wheelId]->setBinLabel(4,"MB4",2);
-  wheelHistos[wheelId]->setAxisTitle("sector",1);
+  wheelHistos[wheelId] = DTBookingTable::book(dbe,wheelSummarySpec,histoName,histoTitle);
 }
 
 
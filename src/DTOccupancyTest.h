@@ -18,12 +18,14 @@
 #include <FWCore/Framework/interface/ESHandle.h>
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include <DataFormats/MuonDetId/interface/DTLayerId.h>
+#include "DQM/DTMonitorClient/src/DTAsyncClientTask.h"
 
 #include "TH2F.h"
 
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
 
 class DTGeometry;
 class DTChamberId;
@@ -58,6 +60,9 @@ protected:
   /// DQM Client Diagnostic
   void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& context);
 
+  /// EndRun: publish the results of the LS in flight
+  void endRun(edm::Run const& run, edm::EventSetup const& context);
+
 
   /// Analyze
   void analyze(const edm::Event& event, const edm::EventSetup& context);
@@ -75,6 +80,24 @@ private:
 
   std::string topFolder() const;
 
+  /// Collect the occupancy histos of the LS: copies in async mode, the ME histos otherwise
+  void takeSnapshot(edm::LuminosityBlock const& lumiSeg);
+
+  /// Run the occupancy test on the snapshot (in the background in async mode)
+  void runTests();
+
+  /// Fill the summaries with the results of the last snapshot
+  void publishResults();
+
+  /// The occupancy histo of a chamber and the result of its test
+  struct ChamberSnapshot {
+    DTChamberId chId;
+    MonitorElement* me;
+    TH2F* histo;
+    int result;
+    float chamberPercentage;
+  };
+
   int nevents;
 
   DQMStore* dbe;
@@ -101,6 +124,15 @@ private:
   bool runOnInTimeOccupancies;
   std::string nameMonitoredHisto;
 
+  // Asynchronous mode: the test of a LS runs while the framework goes on
+  bool asyncMode;
+  DTAsyncClientTask asyncTask;
+  std::vector<ChamberSnapshot> snapshots;
+  std::map<uint32_t, TH2F*> snapshotCopies;
+  bool snapshotPending;
+  bool snapshotCountersFound;
+  int snapshotEvents;
+
 };
 
 #endif
@@ -8,6 +8,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTOfflineSummaryClients.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/Event.h>
@@ -33,6 +34,12 @@ DTOfflineSummaryClients::DTOfflineSummaryClients(const ParameterSet& ps) : neven
   
   dbe = Service<DQMStore>().operator->();
 
+  for(int wheel = -2; wheel != 3; ++wheel) {
+    stringstream effName;
+    effName << "DT/05-ChamberEff/EfficiencyMap_All_W" << wheel;
+    theEfficiencyMapNames.push_back(effName.str());
+  }
+
 }
 
 DTOfflineSummaryClients::~DTOfflineSummaryClients(){
@@ -91,6 +98,7 @@ void DTOfflineSummaryClients::analyze(const Event& event, const EventSetup& cont
 
 
 void DTOfflineSummaryClients::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTOfflineSummaryClients", DTClientPerformance::EndLumi);
 
   LogVerbatim("DTDQM|DTMonitorClient|DTOfflineSummaryClients")
     << "[DTOfflineSummaryClients]: End of LS transition" << endl;
@@ -99,25 +107,19 @@ void DTOfflineSummaryClients::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 
 
 void DTOfflineSummaryClients::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTOfflineSummaryClients", DTClientPerformance::EndRun);
 
   LogVerbatim ("DTDQM|DTMonitorClient|DTOfflineSummaryClients") <<"[DTOfflineSummaryClients]: endRun. Performin client operation"; 
 
   
-  // reset the monitor elements
-  summaryReportMap->Reset();
-  summaryReport->Fill(0.);
-  for(int ii = 0; ii != 5; ++ii) {
-    theSummaryContents[ii]->Fill(0.);
-  }
+  // reset the outputs
+  reduction.reset(0.);
 
   // Fill the map using, at the moment, only the information from DT chamber efficiency
   // problems at a granularity smaller than the chamber are ignored
   for(int wheel=-2; wheel<=2; wheel++) { // loop over wheels
     // retrieve the chamber efficiency summary
-    stringstream str;
-    str << "DT/05-ChamberEff/EfficiencyMap_All_W" << wheel;
-    MonitorElement * segmentWheelSummary =  dbe->get(str.str());
-    if(segmentWheelSummary != 0) {
+    if(reduction.loadChamberMap(wheel,dbe->get(theEfficiencyMapNames[wheel+2]))) {
 
       float nFailingChambers = 0.;
 
@@ -128,8 +130,8 @@ void DTOfflineSummaryClients::endRun(Run const& run, EventSetup const& context)
 
 	for(int station = 1; station != 5; ++station) { // loop over stations
 
-	  const double tmpefficiency = segmentWheelSummary->getBinContent(sector, station);
-	  const double tmpvariance = pow(segmentWheelSummary->getBinError(sector, station),2);
+	  const double tmpefficiency = reduction.chamberValue(wheel, sector, station);
+	  const double tmpvariance = pow(reduction.chamberError(wheel, sector, station),2);
 
 	  if(tmpefficiency == 0 || tmpvariance == 0){
 	    nFailingChambers++;
@@ -147,20 +149,24 @@ void DTOfflineSummaryClients::endRun(Run const& run, EventSetup const& context)
 
 	const double eff_result = meaneff/errorsum;
 
-	if(eff_result > 0.7) summaryReportMap->Fill(sector,wheel,1.);
-	else if(eff_result < 0.7 && eff_result > 0.5) summaryReportMap->Fill(sector,wheel,0.6);
-	else if(eff_result < 0.5 && eff_result > 0.3) summaryReportMap->Fill(sector,wheel,0.4);
-	else if(eff_result < 0.3 && eff_result > 0.) summaryReportMap->Fill(sector,wheel,0.15);
+	double& sectorStatus = reduction.sectorStatus(wheel,sector);
+	if(eff_result > 0.7) sectorStatus = 1.;
+	else if(eff_result < 0.7 && eff_result > 0.5) sectorStatus = 0.6;
+	else if(eff_result < 0.5 && eff_result > 0.3) sectorStatus = 0.4;
+	else if(eff_result < 0.3 && eff_result > 0.) sectorStatus = 0.15;
 
       }
-      theSummaryContents[wheel+2]->Fill((48.-nFailingChambers)/48.);
-      summaryReport->Fill(summaryReport->getFloatValue() + theSummaryContents[wheel+2]->getFloatValue()/5.);
+      reduction.wheelStatus(wheel) = (48.-nFailingChambers)/48.;
+      reduction.report() += reduction.wheelStatus(wheel)/5.;
     } else {
       LogWarning("DTDQM|DTMonitorClient|DTOfflineSummaryClients")
-	<< " [DTOfflineSummaryClients] Segment Summary not found with name: " << str.str() << endl;
+	<< " [DTOfflineSummaryClients] Segment Summary not found with name: " << theEfficiencyMapNames[wheel+2] << endl;
     }
   }
 
+  // write each ME once
+  reduction.write(summaryReport,summaryReportMap,theSummaryContents);
+
 }
 
 
@@ -16,6 +16,11 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include <FWCore/Framework/interface/EDAnalyzer.h>
 
+#include "DQM/DTMonitorClient/src/DTSummaryReduction.h"
+
+#include <vector>
+#include <string>
+
 class DQMStore;
 class MonitorElement;
 
@@ -56,6 +61,9 @@ private:
   MonitorElement*  summaryReport;
   MonitorElement*  summaryReportMap;
   std::vector<MonitorElement*>  theSummaryContents;
+  std::vector<std::string>  theEfficiencyMapNames;
+
+  DTSummaryReduction reduction;
 
 };
 
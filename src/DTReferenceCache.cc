@@ -0,0 +1,156 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTReferenceCache.h"
+
+#include <stdio.h>
+
+using namespace std;
+
+namespace {
+  const uint32_t fileMagic = 0x43525444;   // "DTRC"
+  const uint32_t fileVersion = 1;
+}
+
+const int DTReferenceCache::nRows;
+
+
+void DTReferenceCache::reset(const vector<string>& shapeNames, uint32_t run) {
+
+  theRun = run;
+  theShapeNames = shapeNames;
+  theChambers.clear();
+  theChamberSlots.clear();
+  theRows.clear();
+  theValues.clear();
+
+}
+
+
+void DTReferenceCache::addRow(int shape, uint32_t chamber, int row, const float* bins, int nBins) {
+
+  double sum = 0.;
+  for(int iBin = 0; iBin != nBins; ++iBin) sum += bins[iBin];
+  if(sum <= 0. || nBins > 0xffff) return;
+
+  map<uint32_t, int>::const_iterator slot = theChamberSlots.find(chamber);
+  if(slot == theChamberSlots.end()) {
+    slot = theChamberSlots.insert(make_pair(chamber, int(theChambers.size()))).first;
+    theChambers.push_back(chamber);
+    Row empty = { 0, 0, 0, 0. };
+    theRows.resize(theRows.size() + theShapeNames.size()*nRows, empty);
+  }
+
+  Row& newRow = theRows[((*slot).second*theShapeNames.size() + shape)*nRows + row];
+  newRow.offset = theValues.size();
+  newRow.nBins = nBins;
+  newRow.entries = sum;
+  for(int iBin = 0; iBin != nBins; ++iBin) theValues.push_back(bins[iBin]/sum);
+
+}
+
+
+const DTReferenceCache::Row* DTReferenceCache::row(int shape, uint32_t chamber, int row) const {
+
+  map<uint32_t, int>::const_iterator slot = theChamberSlots.find(chamber);
+  if(slot == theChamberSlots.end() || shape < 0 || row < 0 || row >= nRows) return 0;
+  const Row& cached = theRows[((*slot).second*theShapeNames.size() + shape)*nRows + row];
+  return cached.nBins != 0 ? &cached : 0;
+
+}
+
+
+int DTReferenceCache::shapeIndex(const string& shapeName) const {
+
+  for(unsigned int iShape = 0; iShape != theShapeNames.size(); ++iShape) {
+    if(theShapeNames[iShape] == shapeName) return iShape;
+  }
+  return -1;
+
+}
+
+
+int DTReferenceCache::nFilledRows() const {
+
+  int nFilled = 0;
+  for(vector<Row>::const_iterator cached = theRows.begin(); cached != theRows.end(); ++cached) {
+    if((*cached).nBins != 0) ++nFilled;
+  }
+  return nFilled;
+
+}
+
+
+bool DTReferenceCache::write(const string& fileName) const {
+
+  FILE *file = fopen(fileName.c_str(), "wb");
+  if(file == 0) return false;
+
+  uint32_t header[7] = { fileMagic, fileVersion, theRun, uint32_t(theShapeNames.size()),
+			 uint32_t(theChambers.size()), uint32_t(nRows), uint32_t(theValues.size()) };
+  bool good = fwrite(header, sizeof(header), 1, file) == 1;
+  for(vector<string>::const_iterator name = theShapeNames.begin(); name != theShapeNames.end(); ++name) {
+    uint32_t length = (*name).size();
+    good = good && fwrite(&length, sizeof(length), 1, file) == 1 &&
+      fwrite((*name).data(), 1, length, file) == length;
+  }
+  if(!theChambers.empty()) {
+    good = good && fwrite(&theChambers[0], sizeof(uint32_t), theChambers.size(), file) == theChambers.size();
+    good = good && fwrite(&theRows[0], sizeof(Row), theRows.size(), file) == theRows.size();
+  }
+  if(!theValues.empty()) {
+    good = good && fwrite(&theValues[0], sizeof(float), theValues.size(), file) == theValues.size();
+  }
+  return fclose(file) == 0 && good;
+
+}
+
+
+bool DTReferenceCache::read(const string& fileName) {
+
+  FILE *file = fopen(fileName.c_str(), "rb");
+  if(file == 0) return false;
+
+  uint32_t header[7];
+  if(fread(header, sizeof(header), 1, file) != 1 ||
+     header[0] != fileMagic || header[1] != fileVersion || header[5] != uint32_t(nRows)) {
+    fclose(file);
+    return false;
+  }
+
+  vector<string> shapeNames;
+  bool good = true;
+  for(uint32_t iShape = 0; iShape != header[3] && good; ++iShape) {
+    uint32_t length;
+    good = fread(&length, sizeof(length), 1, file) == 1 && length < 1024;
+    if(good) {
+      vector<char> name(length+1, '\0');
+      good = fread(&name[0], 1, length, file) == length;
+      shapeNames.push_back(string(&name[0], length));
+    }
+  }
+  reset(shapeNames, header[2]);
+  theChambers.resize(header[4]);
+  theRows.resize(header[4]*header[3]*nRows);
+  theValues.resize(header[6]);
+  if(good && !theChambers.empty()) {
+    good = fread(&theChambers[0], sizeof(uint32_t), theChambers.size(), file) == theChambers.size() &&
+      fread(&theRows[0], sizeof(Row), theRows.size(), file) == theRows.size();
+  }
+  if(good && !theValues.empty()) {
+    good = fread(&theValues[0], sizeof(float), theValues.size(), file) == theValues.size();
+  }
+  fclose(file);
+
+  for(unsigned int slot = 0; good && slot != theChambers.size(); ++slot) theChamberSlots[theChambers[slot]] = slot;
+  for(vector<Row>::const_iterator cached = theRows.begin(); good && cached != theRows.end(); ++cached) {
+    good = (*cached).nBins == 0 || (*cached).offset + (*cached).nBins <= theValues.size();
+  }
+  if(!good) reset(vector<string>(), 0);
+  return good;
+
+}
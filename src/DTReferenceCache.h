@@ -0,0 +1,76 @@
+#ifndef DTReferenceCache_H
+#define DTReferenceCache_H
+
+/** \class DTReferenceCache
+ *  Normalized per layer shapes (occupancy, noise, efficiency...) of a
+ *  reference run, kept in a single dense array: each (shape, chamber,
+ *  layer) row points to its bins, normalized to unit sum, and keeps the
+ *  entries of the reference. It is written to and read from a local
+ *  binary file with a few bulk reads, so that it loads in milliseconds.
+ *  The rows are numbered (SL-1)*4 + (layer-1).
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+class DTReferenceCache {
+
+public:
+
+  /// Max # of rows (layers) per chamber
+  static const int nRows = 12;
+
+  /// A row of the cache
+  struct Row {
+    uint32_t offset;
+    uint16_t nBins;
+    uint16_t spare;
+    float entries;
+  };
+
+  /// Constructor
+  DTReferenceCache() : theRun(0) {};
+
+  /// Start a new cache with the given shapes
+  void reset(const std::vector<std::string>& shapeNames, uint32_t run);
+
+  /// Add the bins of a row (normalized here; empty rows are not stored)
+  void addRow(int shape, uint32_t chamber, int row, const float* bins, int nBins);
+
+  /// A row of the cache (0 if not in the reference)
+  const Row* row(int shape, uint32_t chamber, int row) const;
+
+  /// The normalized bins of a row
+  const float* bins(const Row& row) const { return &theValues[row.offset]; };
+
+  /// Index of a shape (-1 if not in the cache)
+  int shapeIndex(const std::string& shapeName) const;
+
+  /// Reference run
+  uint32_t run() const { return theRun; };
+
+  /// # of rows filled
+  int nFilledRows() const;
+
+  /// Write/read the cache file
+  bool write(const std::string& fileName) const;
+  bool read(const std::string& fileName);
+
+private:
+
+  uint32_t theRun;
+  std::vector<std::string> theShapeNames;
+  std::vector<uint32_t> theChambers;
+  std::map<uint32_t, int> theChamberSlots;
+  // by (chamber slot, shape, row)
+  std::vector<Row> theRows;
+  std::vector<float> theValues;
+
+};
+
+#endif
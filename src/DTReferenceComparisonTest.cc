@@ -0,0 +1,330 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTReferenceComparisonTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTBookingTable.h"
+
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+
+#include "TH1F.h"
+#include "TH2F.h"
+#include "TMath.h"
+
+#include <sstream>
+#include <math.h>
+
+using namespace edm;
+using namespace std;
+
+namespace {
+  const DTHistoSpec wheelSpec = { "", 12, 1., 13., 4, 1., 5., 0, 0, DTBookingTable::stationLabels, 4, "Sector", 0 };
+
+  void replaceAll(string& text, const string& tag, int value) {
+    stringstream valueStream; valueStream << value;
+    for(string::size_type position = text.find(tag); position != string::npos;
+	position = text.find(tag, position)) {
+      text.replace(position, tag.size(), valueStream.str());
+    }
+  }
+}
+
+
+DTReferenceComparisonTest::DTReferenceComparisonTest(const ParameterSet& ps) {
+
+  LogVerbatim ("DTDQM|DTMonitorClient|DTReferenceComparisonTest") << "[DTReferenceComparisonTest]: Constructor";
+
+  dbe = Service<DQMStore>().operator->();
+
+  prescaleFactor = ps.getUntrackedParameter<int>("diagnosticPrescale", 1);
+  // "chi2" or "KS"
+  useKS = ps.getUntrackedParameter<string>("method", "chi2") == "KS";
+  // local cache file of the reference shapes
+  referenceFile = ps.getUntrackedParameter<string>("referenceFile", "DTReference.dtrc");
+  // write the reference at the end of the run instead of comparing
+  writeReferenceMode = ps.getUntrackedParameter<bool>("writeReference", false);
+
+  vector<ParameterSet> shapePSets = ps.getUntrackedParameter<vector<ParameterSet> >("shapes");
+  for(vector<ParameterSet>::const_iterator shapePSet = shapePSets.begin();
+      shapePSet != shapePSets.end(); ++shapePSet) {
+    Shape shape;
+    shape.name = (*shapePSet).getUntrackedParameter<string>("name");
+    shape.pathTemplate = (*shapePSet).getUntrackedParameter<string>("histoPath");
+    shape.perLayer = shape.pathTemplate.find("{L}") != string::npos;
+    shapes.push_back(shape);
+  }
+
+}
+
+
+DTReferenceComparisonTest::~DTReferenceComparisonTest() {
+
+  LogVerbatim ("DTDQM|DTMonitorClient|DTReferenceComparisonTest") << "[DTReferenceComparisonTest]: analyzed " << nevents << " events";
+
+}
+
+
+void DTReferenceComparisonTest::beginJob() {
+
+  nevents = 0;
+  if(writeReferenceMode) return;
+
+  double startTime = DTClientPerformance::wallTime();
+  if(!reference.read(referenceFile)) {
+    LogError("DTDQM|DTMonitorClient|DTReferenceComparisonTest")
+      << "Cannot read the reference " << referenceFile << ", no comparison";
+  }
+  for(vector<Shape>::const_iterator shape = shapes.begin(); shape != shapes.end(); ++shape) {
+    cacheShapes.push_back(reference.shapeIndex((*shape).name));
+  }
+  LogVerbatim("DTDQM|DTMonitorClient|DTReferenceComparisonTest")
+    << "[DTReferenceComparisonTest]: reference run " << reference.run() << ", "
+    << reference.nFilledRows() << " layer shapes loaded in "
+    << (DTClientPerformance::wallTime()-startTime)*1000. << " ms";
+
+  bookHistos();
+
+}
+
+
+void DTReferenceComparisonTest::beginRun(const Run& run, const EventSetup& setup) {
+
+  setup.get<MuonGeometryRecord>().get(muonGeom);
+  if(!chamberInputs.empty()) return;
+
+  // the ME paths are built once
+  vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
+  vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
+  for (; ch_it != ch_end; ++ch_it) {
+    ChamberInput input;
+    input.chId = (*ch_it)->id();
+    for(vector<Shape>::const_iterator shape = shapes.begin(); shape != shapes.end(); ++shape) {
+      vector<string> paths;
+      if((*shape).perLayer) {
+	for(int sl = 1; sl <= 3; ++sl) {
+	  for(int layer = 1; layer <= 4; ++layer) paths.push_back(mePath(*shape, input.chId, sl, layer));
+	}
+      } else {
+	paths.push_back(mePath(*shape, input.chId, 0, 0));
+      }
+      input.mes.push_back(vector<MonitorElement*>(paths.size(), (MonitorElement*)0));
+      input.paths.push_back(paths);
+    }
+    chamberInputs.push_back(input);
+  }
+
+}
+
+
+void DTReferenceComparisonTest::analyze(const Event& event, const EventSetup& setup) {
+
+  nevents++;
+
+}
+
+
+void DTReferenceComparisonTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& setup) {
+  DTClientPerformance::Timer timer("DTReferenceComparisonTest", DTClientPerformance::EndLumi);
+
+  if(writeReferenceMode || lumiSeg.id().luminosityBlock()%prescaleFactor != 0) return;
+  runComparison();
+
+}
+
+
+void DTReferenceComparisonTest::endRun(Run const& run, EventSetup const& setup) {
+  DTClientPerformance::Timer timer("DTReferenceComparisonTest", DTClientPerformance::EndRun);
+
+  if(writeReferenceMode) writeReference(run.run());
+  else runComparison();
+
+}
+
+
+string DTReferenceComparisonTest::mePath(const Shape& shape, const DTChamberId& chId, int sl, int layer) const {
+
+  string path = shape.pathTemplate;
+  replaceAll(path, "{W}", chId.wheel());
+  replaceAll(path, "{St}", chId.station());
+  replaceAll(path, "{Sec}", chId.sector());
+  replaceAll(path, "{SL}", sl);
+  replaceAll(path, "{L}", layer);
+  return path;
+
+}
+
+
+void DTReferenceComparisonTest::getRows(ChamberInput& input, int shape,
+					vector<pair<int, pair<const float*, int> > >& rows) {
+
+  rows.clear();
+  vector<MonitorElement*>& mes = input.mes[shape];
+  for(unsigned int iME = 0; iME != mes.size(); ++iME) {
+    if(mes[iME] == 0) mes[iME] = dbe->get(input.paths[shape][iME]);
+    if(mes[iME] == 0) continue;
+
+    // the bins are read in place from the histo arrays
+    TObject *histo = mes[iME]->getRootObject();
+    if(shapes[shape].perLayer) {
+      TH1F *histo1D = dynamic_cast<TH1F*>(histo);
+      if(histo1D == 0) continue;
+      rows.push_back(make_pair(int(iME), make_pair(histo1D->GetArray()+1, histo1D->GetNbinsX())));
+    } else {
+      TH2F *histo2D = dynamic_cast<TH2F*>(histo);
+      if(histo2D == 0) continue;
+      int nBinsX = histo2D->GetNbinsX();
+      int nBinsY = min(histo2D->GetNbinsY(), DTReferenceCache::nRows);
+      for(int binY = 1; binY <= nBinsY; ++binY) {
+	rows.push_back(make_pair(binY-1, make_pair(histo2D->GetArray() + binY*(nBinsX+2) + 1, nBinsX)));
+      }
+    }
+  }
+
+}
+
+
+double DTReferenceComparisonTest::compare(const float* bins, int nBins, const DTReferenceCache::Row& referenceRow) const {
+
+  if(nBins != referenceRow.nBins) return -1;
+
+  const float* referenceBins = reference.bins(referenceRow);
+  double entries = 0.;
+  for(int iBin = 0; iBin != nBins; ++iBin) entries += bins[iBin];
+  double referenceEntries = referenceRow.entries;
+  if(entries <= 0.) return -1;
+
+  if(useKS) {
+    // Kolmogorov distance of the cumulative shapes
+    double cumulative = 0.;
+    double referenceCumulative = 0.;
+    double distance = 0.;
+    for(int iBin = 0; iBin != nBins; ++iBin) {
+      cumulative += bins[iBin];
+      referenceCumulative += referenceBins[iBin];
+      distance = max(distance, fabs(cumulative/entries - referenceCumulative));
+    }
+    return TMath::KolmogorovProb(distance*sqrt(entries*referenceEntries/(entries+referenceEntries)));
+  }
+
+  // chi2 of two unweighted histos
+  double chi2 = 0.;
+  int ndf = -1;
+  for(int iBin = 0; iBin != nBins; ++iBin) {
+    double referenceContent = referenceBins[iBin]*referenceEntries;
+    double sum = bins[iBin] + referenceContent;
+    if(sum <= 0.) continue;
+    double difference = referenceEntries*bins[iBin] - entries*referenceContent;
+    chi2 += difference*difference/sum;
+    ++ndf;
+  }
+  if(ndf < 1) return -1;
+  return TMath::Prob(chi2/(entries*referenceEntries), ndf);
+
+}
+
+
+void DTReferenceComparisonTest::runComparison() {
+
+  if(reference.nFilledRows() == 0) return;
+
+  for(unsigned int iShape = 0; iShape != shapes.size(); ++iShape) {
+    for(map<int, MonitorElement*>::const_iterator histo = wheelHistos[iShape].begin();
+	histo != wheelHistos[iShape].end(); ++histo) {
+      for(int sector = 1; sector <= 12; ++sector) {
+	for(int station = 1; station <= 4; ++station) (*histo).second->setBinContent(sector, station, -1.);
+      }
+    }
+  }
+
+  vector<pair<int, pair<const float*, int> > > rows;
+  for(vector<ChamberInput>::iterator input = chamberInputs.begin(); input != chamberInputs.end(); ++input) {
+    const DTChamberId& chId = (*input).chId;
+    int sector = chId.sector();
+    if(sector == 13) sector = 4;
+    else if(sector == 14) sector = 10;
+
+    for(unsigned int iShape = 0; iShape != shapes.size(); ++iShape) {
+      if(cacheShapes[iShape] < 0) continue;
+      getRows(*input, iShape, rows);
+
+      // the chamber gets the lowest probability of its layers
+      double probability = -1.;
+      for(vector<pair<int, pair<const float*, int> > >::const_iterator row = rows.begin(); row != rows.end(); ++row) {
+	const DTReferenceCache::Row *referenceRow = reference.row(cacheShapes[iShape], chId.rawId(), (*row).first);
+	if(referenceRow == 0) continue;
+	double rowProbability = compare((*row).second.first, (*row).second.second, *referenceRow);
+	if(rowProbability >= 0. && (probability < 0. || rowProbability < probability)) probability = rowProbability;
+      }
+      if(probability < 0.) continue;
+
+      MonitorElement *histo = wheelHistos[iShape][chId.wheel()];
+      double current = histo->getBinContent(sector, chId.station());
+      if(current < 0. || probability < current) histo->setBinContent(sector, chId.station(), probability);
+    }
+  }
+
+}
+
+
+void DTReferenceComparisonTest::writeReference(uint32_t run) {
+
+  vector<string> shapeNames;
+  for(vector<Shape>::const_iterator shape = shapes.begin(); shape != shapes.end(); ++shape) {
+    shapeNames.push_back((*shape).name);
+  }
+  reference.reset(shapeNames, run);
+
+  vector<pair<int, pair<const float*, int> > > rows;
+  for(vector<ChamberInput>::iterator input = chamberInputs.begin(); input != chamberInputs.end(); ++input) {
+    for(unsigned int iShape = 0; iShape != shapes.size(); ++iShape) {
+      getRows(*input, iShape, rows);
+      for(vector<pair<int, pair<const float*, int> > >::const_iterator row = rows.begin(); row != rows.end(); ++row) {
+	reference.addRow(iShape, (*input).chId.rawId(), (*row).first, (*row).second.first, (*row).second.second);
+      }
+    }
+  }
+
+  if(reference.write(referenceFile)) {
+    LogVerbatim("DTDQM|DTMonitorClient|DTReferenceComparisonTest")
+      << "[DTReferenceComparisonTest]: " << reference.nFilledRows() << " layer shapes of run " << run
+      << " written to " << referenceFile;
+  } else {
+    LogError("DTDQM|DTMonitorClient|DTReferenceComparisonTest")
+      << "Cannot write the reference " << referenceFile;
+  }
+
+}
+
+
+void DTReferenceComparisonTest::bookHistos() {
+
+  dbe->setCurrentFolder("DT/06-ReferenceComparison");
+  wheelHistos.assign(shapes.size(), map<int, MonitorElement*>());
+  for(unsigned int iShape = 0; iShape != shapes.size(); ++iShape) {
+    if(cacheShapes[iShape] < 0) {
+      LogWarning("DTDQM|DTMonitorClient|DTReferenceComparisonTest")
+	<< "No " << shapes[iShape].name << " shapes in the reference";
+      continue;
+    }
+    for(int wheel = -2; wheel <= 2; ++wheel) {
+      stringstream name; name << shapes[iShape].name << "Compatibility_W" << wheel;
+      stringstream title; title << shapes[iShape].name << " compatibility with run " << reference.run()
+				<< " (Wh " << wheel << ", -1: no data)";
+      wheelHistos[iShape][wheel] = DTBookingTable::book(dbe, wheelSpec, name.str(), title.str());
+    }
+  }
+
+}
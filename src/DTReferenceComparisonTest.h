@@ -0,0 +1,116 @@
+#ifndef DTReferenceComparisonTest_H
+#define DTReferenceComparisonTest_H
+
+/** \class DTReferenceComparisonTest
+ *  Compares the per layer shapes of the current run (all hits, noise and
+ *  segment occupancies...) with those of a reference run. The tests treat
+ *  the bin contents as counts: the compared histos must be unweighted
+ *  occupancies, not rates or efficiencies. The reference shapes are
+ *  read once from a local cache file (see DTReferenceCache), produced by
+ *  this same client running on the reference run with writeReference.
+ *  At each LS every layer is compared with its reference with a chi2 or
+ *  Kolmogorov test; the lowest probability of the layers of a chamber is
+ *  published in a sector x station map per shape and wheel (-1: no data).
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include <FWCore/Framework/interface/EDAnalyzer.h>
+#include <FWCore/Framework/interface/ESHandle.h>
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/MuonDetId/interface/DTChamberId.h"
+#include "DQM/DTMonitorClient/src/DTReferenceCache.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+class DQMStore;
+class MonitorElement;
+class DTGeometry;
+
+class DTReferenceComparisonTest: public edm::EDAnalyzer{
+
+public:
+
+  /// Constructor
+  DTReferenceComparisonTest(const edm::ParameterSet& ps);
+
+  /// Destructor
+  virtual ~DTReferenceComparisonTest();
+
+protected:
+
+  /// BeginJob: load the reference
+  void beginJob();
+
+  /// BeginRun: build the chamber inputs
+  void beginRun(const edm::Run& run, const edm::EventSetup& setup);
+
+  /// Analyze
+  void analyze(const edm::Event& event, const edm::EventSetup& setup);
+
+  /// DQM Client Diagnostic
+  void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& setup);
+
+  /// EndRun: final comparison, or write of the reference
+  void endRun(edm::Run const& run, edm::EventSetup const& setup);
+
+private:
+
+  /// A compared shape
+  struct Shape {
+    std::string name;
+    // ME path with {W} {St} {Sec} (per chamber, layers as Y bins) and optionally {SL} {L} (per layer)
+    std::string pathTemplate;
+    bool perLayer;
+  };
+
+  /// The input MEs of a chamber: one per shape, or one per layer for the per layer shapes
+  struct ChamberInput {
+    DTChamberId chId;
+    std::vector<std::vector<std::string> > paths;
+    std::vector<std::vector<MonitorElement*> > mes;
+  };
+
+  /// ME path of a shape for a chamber/layer
+  std::string mePath(const Shape& shape, const DTChamberId& chId, int sl, int layer) const;
+
+  /// Bins of the rows of a shape of a chamber: (row, bins, # bins)
+  void getRows(ChamberInput& input, int shape,
+	       std::vector<std::pair<int, std::pair<const float*, int> > >& rows);
+
+  /// Compatibility probability of a row with its reference (-1 if no data)
+  double compare(const float* bins, int nBins, const DTReferenceCache::Row& reference) const;
+
+  /// Compare all the chambers and fill the maps
+  void runComparison();
+
+  /// Fill the cache with the current shapes and write it
+  void writeReference(uint32_t run);
+
+  void bookHistos();
+
+  int nevents;
+  int prescaleFactor;
+  bool useKS;
+  bool writeReferenceMode;
+  std::string referenceFile;
+
+  DQMStore* dbe;
+  edm::ESHandle<DTGeometry> muonGeom;
+
+  std::vector<Shape> shapes;
+  std::vector<int> cacheShapes;
+  std::vector<ChamberInput> chamberInputs;
+  DTReferenceCache reference;
+
+  // compatibility maps by shape and wheel
+  std::vector<std::map<int, MonitorElement*> > wheelHistos;
+
+};
+
+#endif
@@ -10,6 +10,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTResolutionAnalysisTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/Event.h>
@@ -35,7 +36,8 @@ using namespace edm;
 using namespace std;
 
 
-DTResolutionAnalysisTest::DTResolutionAnalysisTest(const ParameterSet& ps){
+DTResolutionAnalysisTest::DTResolutionAnalysisTest(const ParameterSet& ps) :
+  calibRecorder(ps,"DTResolutionAnalysisTest") {
 
   LogTrace ("DTDQM|DTMonitorClient|DTResolutionAnalysisTest") << "[DTResolutionAnalysisTest]: Constructor";
 
@@ -158,6 +160,7 @@ void DTResolutionAnalysisTest::bookHistos() {
 }
 
 void DTResolutionAnalysisTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTResolutionAnalysisTest", DTClientPerformance::EndRun);
 
   if (!dbe->dirExists(topHistoFolder)) {
     LogTrace ("DTDQM|DTMonitorClient|DTResolutionAnalysisTest") 
@@ -223,6 +226,8 @@ void DTResolutionAnalysisTest::endRun(Run const& run, EventSetup const& context)
             // get the mean and the sigma of the distribution
             mean = gfit->GetParameter(1); 
             sigma = gfit->GetParameter(2);
+            calibRecorder.set(slID.rawId(), DTCalibHistory::ResidualMean, mean);
+            calibRecorder.set(slID.rawId(), DTCalibHistory::ResidualSigma, sigma);
 
             // fill the distributions
             meanDistr[-2]->Fill(mean);
@@ -298,6 +303,8 @@ void DTResolutionAnalysisTest::endRun(Run const& run, EventSetup const& context)
     } // loop on SLs
   } // Loop on Stations
 
+  calibRecorder.commit(run.run());
+
 }
 
 
@@ -19,6 +19,8 @@
 #include <FWCore/Framework/interface/EDAnalyzer.h>
 #include <FWCore/Framework/interface/ESHandle.h>
 
+#include "DQM/DTMonitorClient/src/DTCalibRecorder.h"
+
 #include <string>
 #include <map>
 
@@ -108,6 +110,9 @@ private:
   // top folder for the histograms in DQMStore
   std::string topHistoFolder;
 
+  // history of the residual mean and sigma per SL
+  DTCalibRecorder calibRecorder;
+
 };
 
 #endif
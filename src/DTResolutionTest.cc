@@ -10,6 +10,8 @@
 
 
 #include <DQM/DTMonitorClient/src/DTResolutionTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
 
 // Framework
 #include <FWCore/Framework/interface/Event.h>
@@ -42,7 +44,7 @@ using namespace edm;
 using namespace std;
 
 
-DTResolutionTest::DTResolutionTest(const edm::ParameterSet& ps){
+DTResolutionTest::DTResolutionTest(const edm::ParameterSet& ps) : badChannelCollector(ps,"DTResolutionTest","resolution") {
 
   edm::LogVerbatim ("resolution") << "[DTResolutionTest]: Constructor";
   parameters = ps;
@@ -52,11 +54,16 @@ DTResolutionTest::DTResolutionTest(const edm::ParameterSet& ps){
      dbe->open(ps.getUntrackedParameter<string>("inputFile", "residuals.root"));
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 1);
+  schedulerSlot = DTClientScheduler::instance().registerClient("DTResolutionTest", DTEventCounters::Segment, prescaleFactor);
 
   percentual = parameters.getUntrackedParameter<int>("BadSLpercentual", 10);
 
   //debug = parameters.getUntrackedParameter<bool>("debug", false);
 
+  meanTest  = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("meanTestName","ResidualsMeanInRange"));
+  sigmaTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("sigmaTestName","ResidualsSigmaInRange"));
+  slopeTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("slopeTestName","ResidualsSlopeInRange"));
+
 }
 
 
@@ -84,6 +91,7 @@ void DTResolutionTest::beginRun(const edm::Run& run, const edm::EventSetup& cont
       chamber != chambers.end(); ++chamber) {
     bookHistos((*chamber)->id());
   }
+  badChannelCollector.bookHistos(dbe,"DT/Tests/DTResolution");
 
 }
 
@@ -107,6 +115,7 @@ void DTResolutionTest::analyze(const edm::Event& e, const edm::EventSetup& conte
 
 
 void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTResolutionTest", DTClientPerformance::EndLumi);
   
   // counts number of updats (online mode) or number of events (standalone mode)
   //nevents++;
@@ -120,8 +129,26 @@ void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
   // counts number of lumiSegs 
   nLumiSegs = lumiSeg.id().luminosityBlock();
 
-  // prescale factor
-  if ( nLumiSegs%prescaleFactor != 0 ) return;
+  // prescale factor or scheduler decision
+  if ( !DTClientScheduler::instance().runInLS(schedulerSlot, lumiSeg.run(), nLumiSegs, nLumiSegs) ) return;
+
+  runClientDiagnostic();
+
+}
+
+
+
+void DTResolutionTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTResolutionTest", DTClientPerformance::EndRun);
+
+  if ( DTClientScheduler::instance().pending(schedulerSlot) ) runClientDiagnostic();
+
+}
+
+
+
+void DTResolutionTest::runClientDiagnostic() {
+  DTClientScheduler::Execution execution(schedulerSlot);
 
   for(map<int, MonitorElement*> ::const_iterator histo = wheelMeanHistos.begin();
       histo != wheelMeanHistos.end();
@@ -277,24 +304,20 @@ void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
     }
   }
 
+  badChannelCollector.beginCollection(nLumiSegs);
+
   // Mean test 
-  string MeanCriterionName = parameters.getUntrackedParameter<string>("meanTestName","ResidualsMeanInRange"); 
   for(map<pair<int,int>, MonitorElement*>::const_iterator hMean = MeanHistos.begin();
       hMean != MeanHistos.end();
       hMean++) {
-    const QReport * theMeanQReport = (*hMean).second->getQReport(MeanCriterionName);
     stringstream wheel; wheel << (*hMean).first.first;
     stringstream sector; sector << (*hMean).first.second;
     // Report the channels failing the test on the mean
-    if(theMeanQReport) { 
-      vector<dqm::me_util::Channel> badChannels = theMeanQReport->getBadChannels();
-      for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
+    const vector<dqm::me_util::Channel>& badChannels =
+      badChannelCollector.collect((*hMean).second,meanTest,DTBadChannelCollector::wheelSectorElement((*hMean).first.first,(*hMean).first.second));
+    if(!badChannels.empty()) {
+      for (vector<dqm::me_util::Channel>::const_iterator channel = badChannels.begin(); 
 	   channel != badChannels.end(); channel++) {
-	edm::LogError("resolution") << "Bad mean channel: wh: " << wheel.str()
-				     << " st: " << stationFromBin((*channel).getBin())
-				     << " sect: " <<sector.str()
-				     << " sl: " << slFromBin((*channel).getBin())
-				     << " mean (cm): " << (*channel).getContents();
 	string HistoName = "W" + wheel.str() + "_Sec" + sector.str();
 	if(parameters.getUntrackedParameter<bool>("meanWrongHisto")){
 	  MeanHistosSetRange.find(HistoName)->second->Fill((*channel).getBin());
@@ -320,29 +343,21 @@ void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 	  }	
 	}
       }
-      // FIXE ME: if the quality test fails this cout return a null pointer
-      //edm::LogWarning ("resolution") << "-------- wheel: "<<wheel.str()<<" sector: "<<sector.str()<<"  "<<theMeanQReport->getMessage()<<" ------- "<<theMeanQReport->getStatus(); 
     }
   }
   
   // Sigma test
   if(parameters.getUntrackedParameter<bool>("sigmaTest")){
-    string SigmaCriterionName = parameters.getUntrackedParameter<string>("sigmaTestName","ResidualsSigmaInRange"); 
     for(map<pair<int,int>, MonitorElement*>::const_iterator hSigma = SigmaHistos.begin();
 	hSigma != SigmaHistos.end();
 	hSigma++) {
-      const QReport * theSigmaQReport = (*hSigma).second->getQReport(SigmaCriterionName);
       stringstream wheel; wheel << (*hSigma).first.first;
       stringstream sector; sector << (*hSigma).first.second;
-      if(theSigmaQReport) {
-	vector<dqm::me_util::Channel> badChannels = theSigmaQReport->getBadChannels();
-	for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
+      const vector<dqm::me_util::Channel>& badChannels =
+        badChannelCollector.collect((*hSigma).second,sigmaTest,DTBadChannelCollector::wheelSectorElement((*hSigma).first.first,(*hSigma).first.second));
+      if(!badChannels.empty()) {
+        for (vector<dqm::me_util::Channel>::const_iterator channel = badChannels.begin(); 
 	     channel != badChannels.end(); channel++) {
-	  edm::LogError("resolution") << "Bad sigma: wh: " << wheel.str()
-				      << " st: " << stationFromBin((*channel).getBin())
-				      << " sect: " <<sector.str()
-				      << " sl: " << slFromBin((*channel).getBin())
-				      << " sigma (cm): " << (*channel).getContents();
 	  string HistoName = "W" + wheel.str() + "_Sec" + sector.str();
 	  SigmaHistosSetRange.find(HistoName)->second->Fill((*channel).getBin());
 	  SigmaHistosSetRange2D.find(HistoName)->second->Fill((*channel).getBin(),(*channel).getContents());
@@ -361,30 +376,22 @@ void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 	    wheelSigmaHistos[3]->Fill((*hSigma).first.second-1,(*hSigma).first.first);
 	  }
 	}
-	// FIXE ME: if the quality test fails this cout return a null pointer
-	//edm::LogWarning ("resolution") << "-------- wheel: "<<wheel.str()<<" sector: "<<sector.str()<<"  "<<theSigmaQReport->getMessage()<<" ------- "<<theSigmaQReport->getStatus();
       }
     }
   }
 
   // Slope test
   if(parameters.getUntrackedParameter<bool>("slopeTest")){
-    string SlopeCriterionName = parameters.getUntrackedParameter<string>("slopeTestName","ResidualsSlopeInRange"); 
     for(map<pair<int,int>, MonitorElement*>::const_iterator hSlope = SlopeHistos.begin();
 	hSlope != SlopeHistos.end();
 	hSlope++) {
-      const QReport * theSlopeQReport = (*hSlope).second->getQReport(SlopeCriterionName);
       stringstream wheel; wheel << (*hSlope).first.first;
       stringstream sector; sector << (*hSlope).first.second;
-      if(theSlopeQReport) {
-	vector<dqm::me_util::Channel> badChannels = theSlopeQReport->getBadChannels();
-	for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
+      const vector<dqm::me_util::Channel>& badChannels =
+        badChannelCollector.collect((*hSlope).second,slopeTest,DTBadChannelCollector::wheelSectorElement((*hSlope).first.first,(*hSlope).first.second));
+      if(!badChannels.empty()) {
+        for (vector<dqm::me_util::Channel>::const_iterator channel = badChannels.begin(); 
 	     channel != badChannels.end(); channel++) {
-	  edm::LogError("resolution") << "Bad slope: wh: " << wheel.str()
-				      << " st: " << stationFromBin((*channel).getBin())
-				      << " sect: " <<sector.str()
-				      << " sl: " << slFromBin((*channel).getBin())
-				      << " slope: " << (*channel).getContents();
 	  string HistoName = "W" + wheel.str() + "_Sec" + sector.str();
 	  SlopeHistosSetRange.find(HistoName)->second->Fill((*channel).getBin());
 	  SlopeHistosSetRange2D.find(HistoName)->second->Fill((*channel).getBin(),(*channel).getContents());
@@ -403,12 +410,12 @@ void DTResolutionTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
 	    wheelSlopeHistos[3]->Fill((*hSlope).first.second-1,(*hSlope).first.first);
 	  }
 	}
-	// FIXE ME: if the quality test fails this cout return a null pointer
-	//edm::LogWarning ("resolution") << "-------- wheel: "<<wheel.str()<<" sector: "<<sector.str()<<"  "<<theSlopeQReport->getMessage()<<" ------- "<<theSlopeQReport->getStatus();
       }
     }
   }
 
+  badChannelCollector.endCollection();
+
 }
 
 
@@ -26,6 +26,8 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+
 
 #include <memory>
 #include <iostream>
@@ -74,6 +76,12 @@ protected:
   /// DQM Client Diagnostic
   void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& c);
 
+  /// EndRun: run the diagnostic if the last LS were skipped
+  void endRun(edm::Run const& run, edm::EventSetup const& c);
+
+  /// Fill the summaries from the residual distributions
+  void runClientDiagnostic();
+
 
 
 private:
@@ -81,6 +89,7 @@ private:
   int nevents;
   unsigned int nLumiSegs;
   int prescaleFactor;
+  int schedulerSlot;
   int run;
   int percentual;
 
@@ -113,6 +122,11 @@ private:
   std::map <std::pair<int,int>, int> cmsSlopeHistos;
   std::map <std::pair<int,int>, bool> SlopeFilled;
 
+  DTBadChannelCollector badChannelCollector;
+  int meanTest;
+  int sigmaTest;
+  int slopeTest;
+
   // Compute the station from the bin number of mean and sigma histos
   int stationFromBin(int bin) const;
   // Compute the sl from the bin number of mean and sigma histos
@@ -13,6 +13,8 @@
  *********************************/
 
 #include <DQM/DTMonitorClient/src/DTRunConditionVarClient.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTBookingTable.h"
 #include <DQMServices/Core/interface/MonitorElement.h>
 #include <DQMServices/Core/interface/DQMStore.h>
 
@@ -21,7 +23,6 @@
 
 #include "Geometry/Records/interface/MuonGeometryRecord.h"
 #include "Geometry/DTGeometry/interface/DTGeometry.h"
-#include "CondFormats/DataRecord/interface/DTMtimeRcd.h"
 
 #include <stdio.h>
 #include <sstream>
@@ -30,7 +31,14 @@
 using namespace edm;
 using namespace std;
 
-DTRunConditionVarClient::DTRunConditionVarClient(const ParameterSet& pSet)
+namespace {
+  // wheel summaries
+  const DTHistoSpec wheelSummarySpec = { "", 12, 1., 13., 4, 1., 5., 0, 0, DTBookingTable::stationLabels, 4, "Sector", 0 };
+}
+
+DTRunConditionVarClient::DTRunConditionVarClient(const ParameterSet& pSet) :
+  conditions(DTConditionsSnapshot::MTime),
+  calibRecorder(pSet,"DTRunConditionVarClient")
 {
 
   LogVerbatim ("DTDQM|DTMonitorClient|DTRunConditionVarClient")
@@ -52,6 +60,9 @@ DTRunConditionVarClient::DTRunConditionVarClient(const ParameterSet& pSet)
   maxGoodT0Sigma = pSet.getUntrackedParameter<double>("maxGoodT0Sigma");
   minBadT0Sigma = pSet.getUntrackedParameter<double>("minBadT0Sigma");
 
+  // fill the summaries also at each end of LS
+  runOnline = pSet.getUntrackedParameter<bool>("runOnline",false);
+
   theDbe = Service<DQMStore>().operator->();
 
 }
@@ -66,6 +77,7 @@ void DTRunConditionVarClient::beginJob()
 {
   LogVerbatim ("DTDQM|DTMonitorClient|DTRunConditionVarClient")
     << "DTRunConditionVarClient: BeginJob";
+  DTClientPerformance::Timer timer("DTRunConditionVarClient", DTClientPerformance::Booking);
 
   nevents = 0;
 
@@ -101,6 +113,47 @@ void DTRunConditionVarClient::beginJob()
     bookWheelHistos("SigmaT0","03-SigmaT0",wh,50,0,25);
   }
 
+  const char* wheelMENames[nWheelMEs] = { "MeanVDrift", "SigmaVDrift", "MeanT0", "SigmaT0",
+					  "MeanVDriftSummary", "SigmaVDriftSummary", "MeanT0Summary", "SigmaT0Summary" };
+  wheelMEs.assign(5,vector<MonitorElement*>(nWheelMEs,(MonitorElement*)0));
+  for(int wh=-2; wh<=2; wh++) {
+    for(int iME=0; iME<nWheelMEs; ++iME) {
+      wheelMEs[wh+2][iME] = wheelHistos[wh][wheelMENames[iME]];
+    }
+  }
+
+  // build the chamber table (the ME names are computed only once)
+  chIds.clear();
+  vDriftMENames.clear();
+  t0MENames.clear();
+  for(int wheel=-2;wheel<=2;wheel++){
+    for(int sec=1; sec<=14; sec++) {
+      for(int stat=1; stat<=4; stat++) {
+        if( (sec == 13 || sec == 14) && stat != 4  ) continue;
+        DTChamberId chId(wheel,stat,sec);
+        chIds.push_back(chId);
+        vDriftMENames.push_back(getChamberMEName(chId,"VDrift_FromSegm"));
+        t0MENames.push_back(getChamberMEName(chId,"T0_FromSegm"));
+      }
+    }
+  }
+
+  int nChambers = chIds.size();
+  vDriftMEs.assign(nChambers,(MonitorElement*)0);
+  t0MEs.assign(nChambers,(MonitorElement*)0);
+  hasVDrift.assign(nChambers,false);
+  hasT0.assign(nChambers,false);
+  vDriftMean.assign(nChambers,0.);
+  vDriftSigma.assign(nChambers,0.);
+  t0Mean.assign(nChambers,0.);
+  t0Sigma.assign(nChambers,0.);
+  vDriftDB.assign(nChambers,0.);
+  vDriftDev.assign(nChambers,0.);
+  vDriftDevQual.assign(nChambers,0.);
+  vDriftSigmaQual.assign(nChambers,0.);
+  t0MeanQual.assign(nChambers,0.);
+  t0SigmaQual.assign(nChambers,0.);
+
   return;
 }
 
@@ -131,139 +184,213 @@ void DTRunConditionVarClient::analyze(const Event& e, const EventSetup& context)
 
 void DTRunConditionVarClient::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context)
 {
+  DTClientPerformance::Timer timer("DTRunConditionVarClient", DTClientPerformance::EndLumi);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTRunConditionVarClient")
     << "DTRunConditionVarClient: endluminosityBlock";
+
+  if(runOnline) fillSummaries(context);
 }  
 
 
 void DTRunConditionVarClient::endRun(Run const& run, EventSetup const& context)
 {
+  DTClientPerformance::Timer timer("DTRunConditionVarClient", DTClientPerformance::EndRun);
+
   LogVerbatim ("DTDQM|DTMonitorClient|DTRunConditionVarClient")
     << "DTRunConditionVarClient: endRun";
 
-  // Get the map of vdrift from the setup
-  context.get<DTMtimeRcd>().get(mTime);
-  mTimeMap_ = &*mTime;
-
-  for(int wheel=-2;wheel<=2;wheel++){
-    for(int sec=1; sec<=14; sec++) {
-      for(int stat=1; stat<=4; stat++) {
-
-        if( (sec == 13 || sec == 14) && stat != 4  ) continue;
-
-        // Get the ME produced by DTRunConditionVar Source
-        MonitorElement* VDriftME = getChamberHistos(DTChamberId(wheel,stat,sec),"VDrift_FromSegm"); 
-        MonitorElement* T0ME = getChamberHistos(DTChamberId(wheel,stat,sec),"T0_FromSegm"); 
-
-        // Get the means per chamber
-        float vDriftMean = VDriftME->getMean();
-        float t0Mean = T0ME->getMean();
-
-        // Get the sigma per chamber
-        float vDriftSigma = VDriftME->getRMS();
-        float t0Sigma = T0ME->getRMS();
-
-        if( VDriftME->getEntries() != 0 ) {
-
-          allwheelHistos["allMeanVDrift"] -> Fill(vDriftMean);
-          allwheelHistos["allSigmaVDrift"] -> Fill(vDriftSigma);
-
-          (wheelHistos[wheel])["MeanVDrift"] -> Fill(vDriftMean); 
-          (wheelHistos[wheel])["SigmaVDrift"] -> Fill(vDriftSigma); 
-
-        }
-
-
-        if( T0ME->getEntries() != 0 ) {
-
-          allwheelHistos["allMeanT0"] -> Fill(t0Mean);
-          allwheelHistos["allSigmaT0"] -> Fill(t0Sigma);
-
-          (wheelHistos[wheel])["MeanT0"] -> Fill(t0Mean); 
-          (wheelHistos[wheel])["SigmaT0"] -> Fill(t0Sigma);
-
-        }
-
-        //
-        DTChamberId indexCh(wheel,stat,sec);
-
-        float vDriftDev(0.), errvDriftDev(0.);
-        percDevVDrift(indexCh, vDriftMean, vDriftSigma, vDriftDev, errvDriftDev);
-
-        int sec_ = sec;
-        if( sec == 13 || sec == 14 ) sec_ = ( sec == 13 ) ? 4 : 10;
-
-        float fillvDriftDev = max(min(vDriftDev,maxRangeVDrift),minRangeVDrift);
-        float fillT0Mean = max(min(t0Mean,maxRangeT0),minRangeT0);
-
-        float vDriftDevQ = varQuality(fabs(vDriftDev),maxGoodVDriftDev,minBadVDriftDev);
-        float t0MeanQ = varQuality(fabs(t0Mean),maxGoodT0,minBadT0);
-
-        float vDriftSigmQ = varQuality(vDriftSigma,maxGoodVDriftSigma,minBadVDriftSigma);
-        float t0SigmQ = varQuality(t0Sigma,maxGoodT0Sigma,minBadT0Sigma);
-
-        if( sec == 13 ||  sec == 14 ) {
-
-          float binVDriftDev = (wheelHistos[wheel])["MeanVDriftSummary"]->getBinContent(sec_,stat);
-          binVDriftDev = (fabs(binVDriftDev) > fabs(fillvDriftDev)) ? binVDriftDev : fillvDriftDev;
-          (wheelHistos[wheel])["MeanVDriftSummary"] -> setBinContent(sec_,stat,binVDriftDev);
-
-          float binT0MeanVal = (wheelHistos[wheel])["MeanT0Summary"] -> getBinContent(sec_,stat);
-          binT0MeanVal = (fabs(binT0MeanVal) > fabs(fillT0Mean)) ? binT0MeanVal : fillT0Mean;
-          (wheelHistos[wheel])["MeanT0Summary"] -> setBinContent(sec_,stat,binT0MeanVal);
-
-          float binVDriftSigmVal = (wheelHistos[wheel])["SigmaVDriftSummary"] -> getBinContent(sec_,stat);
-          binVDriftSigmVal = (binVDriftSigmVal > 0. && binVDriftSigmVal < vDriftSigmQ) ? binVDriftSigmVal : vDriftSigmQ;
-          (wheelHistos[wheel])["SigmaVDriftSummary"] -> setBinContent(sec_,stat,binVDriftSigmVal); 
-
-          float binT0SigmVal = (wheelHistos[wheel])["SigmaT0Summary"] -> getBinContent(sec_,stat);
-          binT0SigmVal = (binT0SigmVal > 0. && binT0SigmVal < t0SigmQ) ? binT0SigmVal : t0SigmQ;
-          (wheelHistos[wheel])["SigmaT0Summary"] -> setBinContent(sec_,stat,binT0SigmVal);
-
-        } else {
+  fillSummaries(context);
+
+  if(calibRecorder.enabled()) {
+    int nChambers = chIds.size();
+    for(int iCh=0; iCh<nChambers; ++iCh) {
+      if(hasVDrift[iCh]) {
+	calibRecorder.set(chIds[iCh].rawId(),DTCalibHistory::VDriftMean,vDriftMean[iCh]);
+	calibRecorder.set(chIds[iCh].rawId(),DTCalibHistory::VDriftSigma,vDriftSigma[iCh]);
+      }
+      if(hasT0[iCh]) {
+	calibRecorder.set(chIds[iCh].rawId(),DTCalibHistory::T0Mean,t0Mean[iCh]);
+	calibRecorder.set(chIds[iCh].rawId(),DTCalibHistory::T0Sigma,t0Sigma[iCh]);
+      }
+    }
+    calibRecorder.commit(run.run());
+  }
 
-          (wheelHistos[wheel])["MeanVDriftSummary"] -> setBinContent(sec_,stat,fillvDriftDev);
-          (wheelHistos[wheel])["MeanT0Summary"] -> setBinContent(sec_,stat,fillT0Mean);
-          (wheelHistos[wheel])["SigmaVDriftSummary"] -> setBinContent(sec_,stat,vDriftSigmQ); 
-          (wheelHistos[wheel])["SigmaT0Summary"] -> setBinContent(sec_,stat,t0SigmQ);
+  return;
+}
 
-        }
+void DTRunConditionVarClient::fillSummaries(const EventSetup& context)
+{
+  // Get the map of vdrift from the setup (read only if its IOV changed)
+  context.get<MuonGeometryRecord>().get(muonGeom);
+  conditions.update(context,*muonGeom);
 
-        double weight = 1/4.;
-        if(( sec_ == 4 || sec_ == 10) && stat == 4)  weight = 1/8.;
+  gatherChamberInputs();
+  computeChamberResults();
+  writeSummaries();
+}
 
-        if( vDriftDevQ > 0.85 && vDriftSigmQ > 0.85 ) {
-          glbVDriftSummary -> Fill(sec_,wheel,weight);
-          summaryHistos["MeanVDriftGlbSummary"] -> Fill(sec_,wheel,weight); 
-          summaryHistos["SigmaVDriftGlbSummary"] -> Fill(sec_,wheel,weight);
+void DTRunConditionVarClient::gatherChamberInputs()
+{
+  int nChambers = chIds.size();
+  for(int iCh=0; iCh<nChambers; ++iCh) {
+
+    // Get the ME produced by DTRunConditionVar Source (the pointers are cached once found)
+    if(!vDriftMEs[iCh]) vDriftMEs[iCh] = theDbe->get(vDriftMENames[iCh]);
+    if(!t0MEs[iCh]) t0MEs[iCh] = theDbe->get(t0MENames[iCh]);
+    MonitorElement* VDriftME = vDriftMEs[iCh];
+    MonitorElement* T0ME = t0MEs[iCh];
+
+    // Get the means and sigmas per chamber
+    hasVDrift[iCh]   = VDriftME && VDriftME->getEntries() != 0;
+    vDriftMean[iCh]  = VDriftME ? VDriftME->getMean() : 0.;
+    vDriftSigma[iCh] = VDriftME ? VDriftME->getRMS() : 0.;
+    hasT0[iCh]   = T0ME && T0ME->getEntries() != 0;
+    t0Mean[iCh]  = T0ME ? T0ME->getMean() : 0.;
+    t0Sigma[iCh] = T0ME ? T0ME->getRMS() : 0.;
+
+    // vDrift from DB: average of the two phi SLs
+    DTSuperLayerId indexSLPhi1(chIds[iCh],1);
+    DTSuperLayerId indexSLPhi2(chIds[iCh],3);
+    if(!conditions.hasVDrift(indexSLPhi1) || !conditions.hasVDrift(indexSLPhi2)) {
+      DTSuperLayerId sl = (!conditions.hasVDrift(indexSLPhi1)) ? indexSLPhi1 : indexSLPhi2; 
+      throw cms::Exception("DTRunConditionVarClient") << "Could not find vDrift entry in DB for"
+        << sl << endl;
+    }
+    vDriftDB[iCh] = (conditions.vDrift(indexSLPhi1) + conditions.vDrift(indexSLPhi2)) / 2.;
+  }
+}
 
-        } else {
-          if( vDriftDevQ > 0.85 && vDriftSigmQ < 0.85 ) {
-            summaryHistos["MeanVDriftGlbSummary"] -> Fill(sec_,wheel,weight); 
-          }
-          if( vDriftDevQ < 0.85 && vDriftSigmQ > 0.85 ) {
-            summaryHistos["SigmaVDriftGlbSummary"] -> Fill(sec_,wheel,weight);
-          }
-        }
+void DTRunConditionVarClient::computeChamberResults()
+{
+  int nChambers = chIds.size();
 
-        if( t0MeanQ > 0.85 && t0SigmQ > 0.85 ) {
-          glbT0Summary -> Fill(sec_,wheel,weight);
-          summaryHistos["MeanT0GlbSummary"] -> Fill(sec_,wheel,weight);
-          summaryHistos["SigmaT0GlbSummary"] -> Fill(sec_,wheel,weight);
-        } else {
-          if( t0MeanQ > 0.85 && t0SigmQ < 0.85 ) {
-            summaryHistos["MeanT0GlbSummary"] -> Fill(sec_,wheel,weight);
+  for(int iCh=0; iCh<nChambers; ++iCh) {
+    float devVD = (vDriftMean[iCh] - vDriftDB[iCh]) / vDriftDB[iCh];
+    vDriftDev[iCh] = devVD < 1. ? devVD  : 1.;
+  }
 
-          }
-          if( t0MeanQ < 0.85 && t0SigmQ > 0.85 ) {
-            summaryHistos["SigmaT0GlbSummary"] -> Fill(sec_,wheel,weight);
-          }
-        }
+  for(int iCh=0; iCh<nChambers; ++iCh) {
+    vDriftDevQual[iCh]   = varQuality(fabs(vDriftDev[iCh]),maxGoodVDriftDev,minBadVDriftDev);
+    t0MeanQual[iCh]      = varQuality(fabs(t0Mean[iCh]),maxGoodT0,minBadT0);
+    vDriftSigmaQual[iCh] = varQuality(vDriftSigma[iCh],maxGoodVDriftSigma,minBadVDriftSigma);
+    t0SigmaQual[iCh]     = varQuality(t0Sigma[iCh],maxGoodT0Sigma,minBadT0Sigma);
+  }
+}
 
+void DTRunConditionVarClient::writeSummaries()
+{
+  // the summaries are recomputed from scratch at each call
+  glbVDriftSummary->Reset();
+  glbT0Summary->Reset();
+  for(map<string, MonitorElement*>::iterator histo = summaryHistos.begin();
+      histo != summaryHistos.end(); ++histo) (*histo).second->Reset();
+  for(map<string, MonitorElement*>::iterator histo = allwheelHistos.begin();
+      histo != allwheelHistos.end(); ++histo) (*histo).second->Reset();
+  for(int wh=0; wh<5; wh++) {
+    for(int iME=0; iME<nWheelMEs; ++iME) wheelMEs[wh][iME]->Reset();
+  }
 
-      }// end loop on stations
-    }// end loop on sectors
-  }//end loop on wheels
+  MonitorElement* allMeanVDrift  = allwheelHistos["allMeanVDrift"];
+  MonitorElement* allSigmaVDrift = allwheelHistos["allSigmaVDrift"];
+  MonitorElement* allMeanT0      = allwheelHistos["allMeanT0"];
+  MonitorElement* allSigmaT0     = allwheelHistos["allSigmaT0"];
+  MonitorElement* meanVDriftGlb  = summaryHistos["MeanVDriftGlbSummary"];
+  MonitorElement* sigmaVDriftGlb = summaryHistos["SigmaVDriftGlbSummary"];
+  MonitorElement* meanT0Glb      = summaryHistos["MeanT0GlbSummary"];
+  MonitorElement* sigmaT0Glb     = summaryHistos["SigmaT0GlbSummary"];
+
+  int nChambers = chIds.size();
+  for(int iCh=0; iCh<nChambers; ++iCh) {
+
+    int wheel = chIds[iCh].wheel();
+    int sec   = chIds[iCh].sector();
+    int stat  = chIds[iCh].station();
+    vector<MonitorElement*>& whMEs = wheelMEs[wheel+2];
+
+    if( hasVDrift[iCh] ) {
+      allMeanVDrift -> Fill(vDriftMean[iCh]);
+      allSigmaVDrift -> Fill(vDriftSigma[iCh]);
+      whMEs[MeanVDrift] -> Fill(vDriftMean[iCh]); 
+      whMEs[SigmaVDrift] -> Fill(vDriftSigma[iCh]); 
+    }
+
+    if( hasT0[iCh] ) {
+      allMeanT0 -> Fill(t0Mean[iCh]);
+      allSigmaT0 -> Fill(t0Sigma[iCh]);
+      whMEs[MeanT0] -> Fill(t0Mean[iCh]); 
+      whMEs[SigmaT0] -> Fill(t0Sigma[iCh]);
+    }
+
+    int sec_ = sec;
+    if( sec == 13 || sec == 14 ) sec_ = ( sec == 13 ) ? 4 : 10;
+
+    float fillvDriftDev = max(min(vDriftDev[iCh],maxRangeVDrift),minRangeVDrift);
+    float fillT0Mean = max(min(t0Mean[iCh],maxRangeT0),minRangeT0);
+
+    float vDriftDevQ  = vDriftDevQual[iCh];
+    float t0MeanQ     = t0MeanQual[iCh];
+    float vDriftSigmQ = vDriftSigmaQual[iCh];
+    float t0SigmQ     = t0SigmaQual[iCh];
+
+    if( sec == 13 ||  sec == 14 ) {
+
+      float binVDriftDev = whMEs[MeanVDriftSummary]->getBinContent(sec_,stat);
+      binVDriftDev = (fabs(binVDriftDev) > fabs(fillvDriftDev)) ? binVDriftDev : fillvDriftDev;
+      whMEs[MeanVDriftSummary] -> setBinContent(sec_,stat,binVDriftDev);
+
+      float binT0MeanVal = whMEs[MeanT0Summary] -> getBinContent(sec_,stat);
+      binT0MeanVal = (fabs(binT0MeanVal) > fabs(fillT0Mean)) ? binT0MeanVal : fillT0Mean;
+      whMEs[MeanT0Summary] -> setBinContent(sec_,stat,binT0MeanVal);
+
+      float binVDriftSigmVal = whMEs[SigmaVDriftSummary] -> getBinContent(sec_,stat);
+      binVDriftSigmVal = (binVDriftSigmVal > 0. && binVDriftSigmVal < vDriftSigmQ) ? binVDriftSigmVal : vDriftSigmQ;
+      whMEs[SigmaVDriftSummary] -> setBinContent(sec_,stat,binVDriftSigmVal); 
+
+      float binT0SigmVal = whMEs[SigmaT0Summary] -> getBinContent(sec_,stat);
+      binT0SigmVal = (binT0SigmVal > 0. && binT0SigmVal < t0SigmQ) ? binT0SigmVal : t0SigmQ;
+      whMEs[SigmaT0Summary] -> setBinContent(sec_,stat,binT0SigmVal);
+
+    } else {
+
+      whMEs[MeanVDriftSummary] -> setBinContent(sec_,stat,fillvDriftDev);
+      whMEs[MeanT0Summary] -> setBinContent(sec_,stat,fillT0Mean);
+      whMEs[SigmaVDriftSummary] -> setBinContent(sec_,stat,vDriftSigmQ); 
+      whMEs[SigmaT0Summary] -> setBinContent(sec_,stat,t0SigmQ);
+
+    }
+
+    double weight = 1/4.;
+    if(( sec_ == 4 || sec_ == 10) && stat == 4)  weight = 1/8.;
+
+    if( vDriftDevQ > 0.85 && vDriftSigmQ > 0.85 ) {
+      glbVDriftSummary -> Fill(sec_,wheel,weight);
+      meanVDriftGlb -> Fill(sec_,wheel,weight); 
+      sigmaVDriftGlb -> Fill(sec_,wheel,weight);
+    } else {
+      if( vDriftDevQ > 0.85 && vDriftSigmQ < 0.85 ) {
+        meanVDriftGlb -> Fill(sec_,wheel,weight); 
+      }
+      if( vDriftDevQ < 0.85 && vDriftSigmQ > 0.85 ) {
+        sigmaVDriftGlb -> Fill(sec_,wheel,weight);
+      }
+    }
+
+    if( t0MeanQ > 0.85 && t0SigmQ > 0.85 ) {
+      glbT0Summary -> Fill(sec_,wheel,weight);
+      meanT0Glb -> Fill(sec_,wheel,weight);
+      sigmaT0Glb -> Fill(sec_,wheel,weight);
+    } else {
+      if( t0MeanQ > 0.85 && t0SigmQ < 0.85 ) {
+        meanT0Glb -> Fill(sec_,wheel,weight);
+      }
+      if( t0MeanQ < 0.85 && t0SigmQ > 0.85 ) {
+        sigmaT0Glb -> Fill(sec_,wheel,weight);
+      }
+    }
+
+  }// end loop on chambers
 
   return;
 }
@@ -285,32 +412,6 @@ float DTRunConditionVarClient::varQuality(float var, float maxGood, float minBad
   return qual;
 }
 
-void DTRunConditionVarClient::percDevVDrift(DTChamberId indexCh, float meanVD, float sigmaVD, float& devVD, float& errdevVD) {
-
-  DTSuperLayerId indexSLPhi1(indexCh,1);
-  DTSuperLayerId indexSLPhi2(indexCh,3);
-
-  float vDriftPhi1(0.), vDriftPhi2(0.); 
-  float ResPhi1(0.), ResPhi2(0.);
-  int status1 = mTimeMap_->get(indexSLPhi1,vDriftPhi1,ResPhi1,DTVelocityUnits::cm_per_ns); 
-  int status2 = mTimeMap_->get(indexSLPhi2,vDriftPhi2,ResPhi2,DTVelocityUnits::cm_per_ns); 
-
-  if(status1 != 0 || status2 != 0) {
-    DTSuperLayerId sl = (status1 != 0) ? indexSLPhi1 : indexSLPhi2; 
-    throw cms::Exception("DTRunConditionVarClient") << "Could not find vDrift entry in DB for"
-      << sl << endl;
-  }
-
-  float vDriftMed = (vDriftPhi1 + vDriftPhi2) / 2.;
-
-  devVD = (meanVD - vDriftMed) / vDriftMed;
-  devVD = devVD < 1. ? devVD  : 1.;
-
-  errdevVD = sigmaVD/vDriftMed;
-
-  return;
-}
-
 void DTRunConditionVarClient::bookWheelHistos(string histoType, string subfolder, int wh, int nbins, float min, float max, bool isVDCorr )
 {
   stringstream wheel; wheel << wh;
@@ -333,20 +434,12 @@ void DTRunConditionVarClient::bookWheelHistos(string histoType, string subfolder
     histoName = histoType + "Summary_W" + wheel.str();
   }
 
-  MonitorElement* me = theDbe -> book2D(histoName, histoLabel,12,1,13,4,1,5);
-
-  me->setBinLabel(1,"MB1",2);
-  me->setBinLabel(2,"MB2",2);
-  me->setBinLabel(3,"MB3",2);
-  me->setBinLabel(4,"MB4",2);
-  me->setAxisTitle("Sector",1);
-
-  (wheelHistos[wh])[histoType + "Summary"] = me;
+  (wheelHistos[wh])[histoType + "Summary"] = DTBookingTable::book(theDbe, wheelSummarySpec, histoName, histoLabel);
 
   return;
 }
 
-MonitorElement* DTRunConditionVarClient::getChamberHistos(const DTChamberId& dtCh, string histoType) {
+string DTRunConditionVarClient::getChamberMEName(const DTChamberId& dtCh, const string& histoType) const {
 
   int wh = dtCh.wheel();		
   int sc = dtCh.sector();	
@@ -357,14 +450,6 @@ MonitorElement* DTRunConditionVarClient::getChamberHistos(const DTChamberId& dtC
 
   string folder = "DT/02-Segments/Wheel" + wheel.str() + "/Sector" + sector.str() + "/Station" + station.str();
   string histoTag      = "_W" + wheel.str() + "_Sec" + sector.str() + "_St" + station.str();
-  string MEpath = folder + "/" + histoType + histoTag;
-
-  theDbe->setCurrentFolder(folder);
-
-  LogTrace ("DTDQM|DTMonitorModule|DTRunConditionVar") 
-    << "[DTRunConditionVar]: getting ME from " << folder << endl;
-
-  MonitorElement* ME = theDbe -> get(MEpath);
 
-  return ME;
+  return folder + "/" + histoType + histoTag;
 }
@@ -24,7 +24,8 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include <FWCore/Framework/interface/LuminosityBlock.h>
 
-#include "CondFormats/DTObjects/interface/DTMtime.h"
+#include "DQM/DTMonitorClient/src/DTConditionsSnapshot.h"
+#include "DQM/DTMonitorClient/src/DTCalibRecorder.h"
 
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
@@ -70,14 +71,24 @@ class DTRunConditionVarClient: public edm::EDAnalyzer{
     // 
     float varQuality(float var, float maxGood, float minBad);
 
-    //
-    void percDevVDrift(DTChamberId indexCh, float meanVD, float sigmaVD, float& devVD, float& errdevVD);
+    /// Gather the per chamber inputs, compute deviations and qualities, fill the summaries
+    void fillSummaries(const edm::EventSetup& context);
 
   private:
 
-    MonitorElement* getChamberHistos(const DTChamberId&, std::string);
+    /// Read vdrift/t0 mean and sigma of all chambers (and the DB vdrift) into the table
+    void gatherChamberInputs();
+
+    /// Compute deviations and quality classes for all the chambers of the table
+    void computeChamberResults();
+
+    /// Reset and fill all the summary MEs from the table
+    void writeSummaries();
+
+    std::string getChamberMEName(const DTChamberId&, const std::string&) const;
 
     int nevents;      
+    bool runOnline;
 
     float minRangeVDrift;
     float maxRangeVDrift; 
@@ -94,8 +105,8 @@ class DTRunConditionVarClient: public edm::EDAnalyzer{
     float maxGoodT0Sigma;
     float minBadT0Sigma;
 
-    edm::ESHandle<DTMtime> mTime;
-    const DTMtime* mTimeMap_;
+    edm::ESHandle<DTGeometry> muonGeom;
+    DTConditionsSnapshot conditions;
 
     DQMStore* theDbe;
 
@@ -106,6 +117,33 @@ class DTRunConditionVarClient: public edm::EDAnalyzer{
     std::map<std::string, MonitorElement *> summaryHistos;
     std::map<std::string, MonitorElement *> allwheelHistos;
 
+    // per chamber table (structure of arrays), ordered by wheel, sector, station
+    std::vector<DTChamberId> chIds;
+    std::vector<std::string> vDriftMENames;
+    std::vector<std::string> t0MENames;
+    std::vector<MonitorElement*> vDriftMEs;
+    std::vector<MonitorElement*> t0MEs;
+    std::vector<bool> hasVDrift;
+    std::vector<bool> hasT0;
+    std::vector<float> vDriftMean;
+    std::vector<float> vDriftSigma;
+    std::vector<float> t0Mean;
+    std::vector<float> t0Sigma;
+    std::vector<float> vDriftDB;
+    std::vector<float> vDriftDev;
+    std::vector<float> vDriftDevQual;
+    std::vector<float> vDriftSigmaQual;
+    std::vector<float> t0MeanQual;
+    std::vector<float> t0SigmaQual;
+
+    // wheel MEs by wheel+2 and WheelME, resolved from wheelHistos after booking
+    enum WheelME { MeanVDrift = 0, SigmaVDrift, MeanT0, SigmaT0,
+		   MeanVDriftSummary, SigmaVDriftSummary, MeanT0Summary, SigmaT0Summary, nWheelMEs };
+    std::vector<std::vector<MonitorElement*> > wheelMEs;
+
+    // history of the vDrift and t0 per chamber
+    DTCalibRecorder calibRecorder;
+
 };
 
 #endif
@@ -10,6 +10,8 @@
 
 
 #include <DQM/DTMonitorClient/src/DTSegmentAnalysisTest.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
 
 // Framework
 #include <FWCore/Framework/interface/Event.h>
@@ -42,7 +44,8 @@ using namespace edm;
 using namespace std;
 
 
-DTSegmentAnalysisTest::DTSegmentAnalysisTest(const ParameterSet& ps){
+DTSegmentAnalysisTest::DTSegmentAnalysisTest(const ParameterSet& ps) :
+  badChannelCollector(ps,"DTSegmentAnalysisTest","DTDQM|DTMonitorClient|DTSegmentAnalysisTest") {
 
   LogTrace ("DTDQM|DTMonitorClient|DTSegmentAnalysisTest") << "[DTSegmentAnalysisTest]: Constructor";
   parameters = ps;
@@ -61,6 +64,9 @@ DTSegmentAnalysisTest::DTSegmentAnalysisTest(const ParameterSet& ps){
   maxPhiHit  = ps.getUntrackedParameter<int>("maxPhiHit", 7);
   maxPhiZHit  = ps.getUntrackedParameter<int>("maxPhiZHit", 11);
 
+  chi2Test       = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("chi2TestName","chi2InRange"));
+  segmRecHitTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("segmRecHitTestName","segmRecHitInRange"));
+
 }
 
 
@@ -78,6 +84,7 @@ void DTSegmentAnalysisTest::beginJob(){
 
   // book the histos
   bookHistos();  
+  if(detailedAnalysis) badChannelCollector.bookHistos(dbe,topHistoFolder);
 
 }
 
@@ -87,6 +94,7 @@ void DTSegmentAnalysisTest::beginRun(const Run& run, const EventSetup& context){
   LogTrace ("DTDQM|DTMonitorClient|DTSegmentAnalysisTest") <<"[DTSegmentAnalysisTest]: BeginRun"; 
 
   context.get<MuonGeometryRecord>().get(muonGeom);
+  runNumber = run.run();
 
 }
 
@@ -108,6 +116,7 @@ void DTSegmentAnalysisTest::analyze(const Event& e, const EventSetup& context){
 
 
 void DTSegmentAnalysisTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTSegmentAnalysisTest", DTClientPerformance::EndLumi);
 
   // counts number of lumiSegs 
   nLumiSegs = lumiSeg.id().luminosityBlock();
@@ -122,10 +131,12 @@ void DTSegmentAnalysisTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, E
 }
 
 void DTSegmentAnalysisTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTSegmentAnalysisTest", DTClientPerformance::EndRun);
 
   if (!runOnline) {
     LogTrace ("DTDQM|DTMonitorClient|DTSegmentAnalysisTest")
       <<"[DTSegmentAnalysisTest]: endRun. Client called in offline mode , perform DQM client operation";
+    DTEventCounters::refresh(dbe, runNumber);
     performClientDiagnostic();
   }
 
@@ -156,6 +167,7 @@ void DTSegmentAnalysisTest::endRun(Run const& run, EventSetup const& context) {
 }
 
 void DTSegmentAnalysisTest::performClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTSegmentAnalysisTest", DTClientPerformance::Diagnostic);
 
   summaryHistos[3]->Reset();
   summaryHistos[4]->Reset();
@@ -242,60 +254,37 @@ void DTSegmentAnalysisTest::performClientDiagnostic() {
     
   } //loop over all the chambers
 
-  string nEvtsName = "DT/EventInfo/Counters/nProcessedEventsSegment";
-  MonitorElement * meProcEvts = dbe->get(nEvtsName);
+  const DTEventCounters& counters = DTEventCounters::get(dbe, runNumber, nLumiSegs);
 
-  if (meProcEvts) {
-    int nProcEvts = meProcEvts->getFloatValue();
+  if (counters.found(DTEventCounters::Segment)) {
+    int nProcEvts = counters.events(DTEventCounters::Segment);
     summaryHistos[4]->setEntries(nProcEvts < nMinEvts ? 10. : nProcEvts);
   } else {
     summaryHistos[4]->setEntries(nMinEvts + 1);
     LogVerbatim ("DTDQM|DTMonitorClient|DTOccupancyTest") << "[DTOccupancyTest] ME: "
-		       <<  nEvtsName << " not found!" << endl;
+		       <<  DTEventCounters::meName(DTEventCounters::Segment) << " not found!" << endl;
   }
 
   if(detailedAnalysis){
     
-    string chi2CriterionName = parameters.getUntrackedParameter<string>("chi2TestName","chi2InRange");
+    badChannelCollector.beginCollection(nLumiSegs);
+
     for(map<pair<int, int>, MonitorElement*> ::const_iterator histo = chi2Histos.begin();
 	histo != chi2Histos.end();
 	histo++) {
-
-      const QReport * theChi2QReport = (*histo).second->getQReport(chi2CriterionName);
-      if(theChi2QReport) {
-	vector<dqm::me_util::Channel> badChannels = theChi2QReport->getBadChannels();
-	for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	     channel != badChannels.end(); channel++) {
-	  // FIXME: log into a ME
-	  LogError ("DTDQM|DTMonitorClient|DTSegmentAnalysisTest") << "Wheel: "<<(*histo).first.first
-								   << " Sector: "<<(*histo).first.second
-								   << " Bad stations: "<<(*channel).getBin()
-								   <<"  Contents : "<<(*channel).getContents();
-	}
-      }
+      badChannelCollector.collect((*histo).second,chi2Test,
+				  DTBadChannelCollector::wheelSectorElement((*histo).first.first,(*histo).first.second));
     }
     
-    string segmRecHitCriterionName = parameters.getUntrackedParameter<string>("segmRecHitTestName","segmRecHitInRange");
     for(map<pair<int, int>, MonitorElement*> ::const_iterator histo = segmRecHitHistos.begin();
 	histo != segmRecHitHistos.end();
 	histo++) {
-
-      const QReport * theSegmRecHitQReport = (*histo).second->getQReport(segmRecHitCriterionName);
-      if(theSegmRecHitQReport) {
-	vector<dqm::me_util::Channel> badChannels = theSegmRecHitQReport->getBadChannels();
-	for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
-	     channel != badChannels.end(); channel++) {
-	  // FIXME: log into a ME
-	  LogError ("DTDQM|DTMonitorClient|DTSegmentAnalysisTest") << "Wheel: "<<(*histo).first.first
-								   << " Sector: "<<(*histo).first.second
-								   << " Bad stations on recHit number: "
-								   <<(*channel).getBin()
-								   <<"  Contents : "
-								   <<(*channel).getContents();
-	}
-      }
+      badChannelCollector.collect((*histo).second,segmRecHitTest,
+				  DTBadChannelCollector::wheelSectorElement((*histo).first.first,(*histo).first.second));
     }
 
+    badChannelCollector.endCollection();
+
   } // end of detailedAnalysis
 
 }
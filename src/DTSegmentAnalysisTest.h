@@ -26,6 +26,8 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+
 
 #include <memory>
 #include <iostream>
@@ -80,6 +82,7 @@ private:
 
   int nevents;
   unsigned int nLumiSegs;
+  int runNumber;
   // switch on for detailed analysis
   bool detailedAnalysis;
   int nMinEvts;
@@ -98,6 +101,9 @@ private:
   std::map< std::pair<int,int>, MonitorElement* > chi2Histos;
   std::map< std::pair<int,int>, MonitorElement* > segmRecHitHistos;
   std::map< int, MonitorElement* > summaryHistos;
+  DTBadChannelCollector badChannelCollector;
+  int chi2Test;
+  int segmRecHitTest;
   bool normalizeHistoPlots;
   // top folder for the histograms in DQMStore
   std::string topHistoFolder;
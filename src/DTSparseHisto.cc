@@ -0,0 +1,72 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTSparseHisto.h"
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <algorithm>
+
+using namespace std;
+
+
+DTSparseHisto::DTSparseHisto(int nBinsX, int nBinsY) : theNBinsX(nBinsX), theNBinsY(nBinsY) {}
+
+
+void DTSparseHisto::setBinContent(int binX, int binY, float value) {
+
+  Bin newBin;
+  newBin.bin = globalBin(binX, binY);
+  newBin.value = value;
+  vector<Bin>::iterator position = lower_bound(theBins.begin(), theBins.end(), newBin);
+  bool found = position != theBins.end() && position->bin == newBin.bin;
+  if(value == 0) {
+    if(found) theBins.erase(position);
+  } else if(found) {
+    position->value = value;
+  } else {
+    theBins.insert(position, newBin);
+  }
+
+}
+
+
+float DTSparseHisto::getBinContent(int binX, int binY) const {
+
+  Bin key;
+  key.bin = globalBin(binX, binY);
+  vector<Bin>::const_iterator position = lower_bound(theBins.begin(), theBins.end(), key);
+  return (position != theBins.end() && position->bin == key.bin) ? position->value : 0;
+
+}
+
+
+long DTSparseHisto::bytes() const {
+
+  return sizeof(*this) + theBins.capacity()*sizeof(Bin);
+
+}
+
+
+long DTSparseHisto::denseBytes() const {
+
+  return (theNBinsX+2)*(theNBinsY+2)*sizeof(float);
+
+}
+
+
+void DTSparseHisto::exportTo(MonitorElement* me) const {
+
+  me->Reset();
+  for(vector<Bin>::const_iterator bin = theBins.begin(); bin != theBins.end(); ++bin) {
+    int binX = bin->bin%(theNBinsX+2);
+    int binY = bin->bin/(theNBinsX+2);
+    if(theNBinsY == 0) me->setBinContent(binX, bin->value);
+    else me->setBinContent(binX, binY, bin->value);
+  }
+
+}
@@ -0,0 +1,65 @@
+#ifndef DTSparseHisto_H
+#define DTSparseHisto_H
+
+/** \class DTSparseHisto
+ *  Sparse bin contents of a 1D/2D histo: the bins different from 0
+ *  are kept as a list of (global bin, value) sorted by bin, the others
+ *  are 0 as in an empty TH1F/TH2F. It is meant for the working results
+ *  of the clients that stay mostly empty; exportTo writes them into a
+ *  dense ME when needed. Bin numbering follows ROOT (0 and nBins+1 are
+ *  the under/overflows).
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <vector>
+
+class MonitorElement;
+
+class DTSparseHisto {
+
+public:
+
+  /// Constructor (nBinsY = 0 for a 1D histo)
+  DTSparseHisto(int nBinsX = 1, int nBinsY = 0);
+
+  /// Set the content of a bin (a 0 removes it)
+  void setBinContent(int binX, float value) { setBinContent(binX, 0, value); };
+  void setBinContent(int binX, int binY, float value);
+
+  /// Content of a bin
+  float getBinContent(int binX, int binY = 0) const;
+
+  /// Remove all the bins
+  void reset() { theBins.clear(); };
+
+  /// # of bins different from 0
+  int nFilled() const { return theBins.size(); };
+
+  /// Memory used by the bins (bytes)
+  long bytes() const;
+
+  /// Memory of the bins of the equivalent dense TH1F/TH2F (bytes)
+  long denseBytes() const;
+
+  /// Reset the ME and copy the bins into it
+  void exportTo(MonitorElement* me) const;
+
+private:
+
+  struct Bin {
+    int bin;
+    float value;
+    bool operator<(const Bin& other) const { return bin < other.bin; };
+  };
+
+  int globalBin(int binX, int binY) const { return binX + (theNBinsX+2)*binY; };
+
+  int theNBinsX;
+  int theNBinsY;
+  std::vector<Bin> theBins;
+
+};
+
+#endif
@@ -10,6 +10,7 @@
 
 
 #include <DQM/DTMonitorClient/src/DTSummaryClients.h>
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include <FWCore/Framework/interface/Event.h>
@@ -33,6 +34,12 @@ DTSummaryClients::DTSummaryClients(const ParameterSet& ps) : nevents(0) {
   
   dbe = Service<DQMStore>().operator->();
 
+  for(int wheel = -2; wheel != 3; ++wheel) {
+    stringstream occName;
+    occName << "DT/01-Digi/OccupancySummary_W" << wheel;
+    theOccupancySummaryNames.push_back(occName.str());
+  }
+
 }
 
 DTSummaryClients::~DTSummaryClients(){
@@ -79,6 +86,7 @@ void DTSummaryClients::endJob(void){
 
 
 void DTSummaryClients::endRun(Run const& run, EventSetup const& eSetup) {
+  DTClientPerformance::Timer timer("DTSummaryClients", DTClientPerformance::EndRun);
   
   LogVerbatim ("DTDQM|DTMonitorClient|DTSummaryClients") <<"[DTSummaryClients]: endRun"; 
 
@@ -98,41 +106,37 @@ void DTSummaryClients::analyze(const Event& event, const EventSetup& context){
 
 
 void DTSummaryClients::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTSummaryClients", DTClientPerformance::EndLumi);
   
   LogVerbatim("DTDQM|DTMonitorClient|DTSummaryClients")
     << "[DTSummaryClients]: End of LS transition, performing the DQM client operation" << endl;
 
-  // reset the monitor elements
-  summaryReportMap->Reset();
-  summaryReport->Reset();
-  for(int ii = 0; ii != 5; ++ii) {
-    theSummaryContents[ii]->Reset();
-  }
+  // outputs start from 0, as after a reset of the MEs
+  reduction.reset(0.);
 
   bool noDTData = false;
 
   // Check if DT data in each ROS have been read out and set the SummaryContents and the ErrorSummary
   // accordignly
-  MonitorElement * dataIntegritySummary = dbe->get("DT/00-DataIntegrity/DataIntegritySummary");
-  if(dataIntegritySummary != 0) {
-  int nDisabledFED = 0;
-  for(int wheel = 1; wheel != 6; ++wheel) { // loop over the wheels
-    int nDisablesROS = 0;
-    for(int sect = 1; sect != 13; ++sect) { // loop over sectors
-      if(dataIntegritySummary->getBinContent(sect,wheel) == 1) {
-	nDisablesROS++;
+  if(reduction.loadSectorMap(dbe->get("DT/00-DataIntegrity/DataIntegritySummary"))) {
+    int nDisabledFED = 0;
+    for(int wheel = -2; wheel <= 2; ++wheel) { // loop over the wheels
+      int nDisablesROS = 0;
+      for(int sect = 1; sect != 13; ++sect) { // loop over sectors
+	if(reduction.sectorValue(wheel,sect) == 1) {
+	  nDisablesROS++;
+	}
+      }
+      if(nDisablesROS == 12) {
+	nDisabledFED++;
+	reduction.wheelStatus(wheel) = 0;
       }
     }
-    if(nDisablesROS == 12) {
-      nDisabledFED++;
-      theSummaryContents[wheel-1]->Fill(0);
-    }
-  }
   
-  if(nDisabledFED == 5) {
-    noDTData = true;
-    summaryReport->Fill(-1);
-  }
+    if(nDisabledFED == 5) {
+      noDTData = true;
+      reduction.report() = -1;
+    }
   
   } else {
     LogError("DTDQM|DTMonitorClient|DTSummaryClients")
@@ -147,37 +151,37 @@ void DTSummaryClients::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventS
   // problems at a granularity smaller than the chamber are ignored
   for(int wheel=-2; wheel<=2; wheel++){ // loop over wheels
     // retrieve the occupancy summary
-    stringstream str;
-    str << "DT/01-Digi/OccupancySummary_W" << wheel;
-    MonitorElement * wheelOccupancySummary =  dbe->get(str.str());
-    if(wheelOccupancySummary != 0) {
+    if(reduction.loadChamberMap(wheel,dbe->get(theOccupancySummaryNames[wheel+2]))) {
       int nFailingChambers = 0;
       for(int sector=1; sector<=12; sector++){ // loop over sectors
 	for(int station = 1; station != 5; ++station) { // loop over stations
-	  double chamberStatus = wheelOccupancySummary->getBinContent(sector, station);
+	  double chamberStatus = reduction.chamberValue(wheel, sector, station);
 	  LogTrace("DTDQM|DTMonitorClient|DTSummaryClients")
 	    << "Wheel: " << wheel << " Stat: " << station << " Sect: " << sector << " status: " << chamberStatus << endl;
 	  if(chamberStatus != 4) {
-	    summaryReportMap->Fill(sector, wheel, 0.25);
+	    reduction.sectorStatus(wheel, sector) += 0.25;
 	  } else {
 	    nFailingChambers++;
 	  }
-	  LogTrace("DTDQM|DTMonitorClient|DTSummaryClients") << " sector (" << sector << ") status on the map is: "
-							     << summaryReportMap->getBinContent(sector, wheel+3) << endl;
 	}
-
+	LogTrace("DTDQM|DTMonitorClient|DTSummaryClients") << " sector (" << sector << ") status on the map is: "
+							   << reduction.sectorStatus(wheel, sector) << endl;
       }
-      theSummaryContents[wheel+2]->Fill((48.-nFailingChambers)/48.);
+      reduction.wheelStatus(wheel) = (48.-nFailingChambers)/48.;
       totalStatus += (48.-nFailingChambers)/48.;
     } else {
       occupancyFound = false;
-      LogError("DTDQM|DTMonitorClient|DTSummaryClients")<< " Wheel Occupancy Summary not found with name: " << str.str() << endl;
+      LogError("DTDQM|DTMonitorClient|DTSummaryClients")<< " Wheel Occupancy Summary not found with name: "
+							<< theOccupancySummaryNames[wheel+2] << endl;
     }
   }
 
 
   if(occupancyFound && !noDTData)
-    summaryReport->Fill(totalStatus/5.);
+    reduction.report() = totalStatus/5.;
+
+  // write each ME once
+  reduction.write(summaryReport,summaryReportMap,theSummaryContents);
 
 //   cout << "-----------------------------------------------------------------------------" << endl;
 //   cout << " In the endLuminosityBlock: " << endl;
@@ -27,6 +27,8 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Framework/interface/Run.h"
 
+#include "DQM/DTMonitorClient/src/DTSummaryReduction.h"
+
 #include <memory>
 #include <string>
 
@@ -65,6 +67,9 @@ private:
   MonitorElement*  summaryReport;
   MonitorElement*  summaryReportMap;
   std::vector<MonitorElement*>  theSummaryContents;
+  std::vector<std::string>  theOccupancySummaryNames;
+
+  DTSummaryReduction reduction;
 
 };
 
@@ -0,0 +1,89 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+#include <DQM/DTMonitorClient/src/DTSummaryReduction.h>
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TH2F.h"
+
+using namespace std;
+
+
+DTSummaryReduction::DTSummaryReduction() : theChamberValues(240,0.), theChamberErrors(240,0.),
+					   theSectorValues(60,0.), theSectorStatus(60,0.),
+					   theWheelStatus(5,0.), theReport(0.) {
+
+}
+
+
+DTSummaryReduction::~DTSummaryReduction() {
+
+}
+
+
+void DTSummaryReduction::reset(double value) {
+
+  theChamberValues.assign(240,0.);
+  theChamberErrors.assign(240,0.);
+  theSectorValues.assign(60,0.);
+  theSectorStatus.assign(60,value);
+  theWheelStatus.assign(5,value);
+  theReport = value;
+
+}
+
+
+bool DTSummaryReduction::loadChamberMap(int wheel, MonitorElement* me) {
+
+  if (me == 0) return false;
+  TH2F* histo = me->getTH2F();
+
+  int stride = histo->GetNbinsX()+2;
+  for (int sector=1; sector<=12; ++sector) {
+    for (int station=1; station<=4; ++station) {
+      int bin = sector + stride*station;
+      int index = chamberIndex(wheel,sector,station);
+      theChamberValues[index] = histo->GetBinContent(bin);
+      theChamberErrors[index] = histo->GetBinError(bin);
+    }
+  }
+  return true;
+
+}
+
+
+bool DTSummaryReduction::loadSectorMap(MonitorElement* me) {
+
+  if (me == 0) return false;
+  TH2F* histo = me->getTH2F();
+
+  int stride = histo->GetNbinsX()+2;
+  for (int wheel=-2; wheel<=2; ++wheel) {
+    for (int sector=1; sector<=12; ++sector) {
+      theSectorValues[sectorIndex(wheel,sector)] = histo->GetBinContent(sector + stride*(wheel+3));
+    }
+  }
+  return true;
+
+}
+
+
+void DTSummaryReduction::write(MonitorElement* reportME, MonitorElement* reportMapME,
+			       const vector<MonitorElement*>& wheelMEs) const {
+
+  reportMapME->Reset();
+  for (int wheel=-2; wheel<=2; ++wheel) {
+    for (int sector=1; sector<=12; ++sector) {
+      reportMapME->setBinContent(sector,wheel+3,theSectorStatus[sectorIndex(wheel,sector)]);
+    }
+    wheelMEs[wheel+2]->Fill(theWheelStatus[wheel+2]);
+  }
+  reportME->Fill(theReport);
+
+}
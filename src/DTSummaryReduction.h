@@ -0,0 +1,76 @@
+#ifndef DTSummaryReduction_H
+#define DTSummaryReduction_H
+
+/** \class DTSummaryReduction
+ *  Dense storage for the reduction of the DT summary maps into the
+ *  EventInfo report: the input maps are loaded once into 5x12(x4) arrays,
+ *  the clients compute sector, wheel and global status on the arrays and
+ *  every output ME is written once at the end.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <vector>
+
+class MonitorElement;
+
+class DTSummaryReduction {
+
+public:
+
+  /// Constructor
+  DTSummaryReduction();
+
+  /// Destructor
+  virtual ~DTSummaryReduction();
+
+  /// Clear inputs and set all the outputs to the given value
+  void reset(double value = 0.);
+
+  /// Load a (sector,station) wheel summary map, returns false if the ME is null
+  bool loadChamberMap(int wheel, MonitorElement* me);
+
+  /// Load a (sector,wheel) map, returns false if the ME is null
+  bool loadSectorMap(MonitorElement* me);
+
+  /// Content of a chamber bin of the loaded wheel maps
+  inline double chamberValue(int wheel, int sector, int station) const {
+    return theChamberValues[chamberIndex(wheel,sector,station)]; };
+
+  /// Error of a chamber bin of the loaded wheel maps
+  inline double chamberError(int wheel, int sector, int station) const {
+    return theChamberErrors[chamberIndex(wheel,sector,station)]; };
+
+  /// Content of a bin of the loaded sector map
+  inline double sectorValue(int wheel, int sector) const { return theSectorValues[sectorIndex(wheel,sector)]; };
+
+  /// Status for the report map (output)
+  inline double& sectorStatus(int wheel, int sector) { return theSectorStatus[sectorIndex(wheel,sector)]; };
+
+  /// Status for the wheel summary contents (output)
+  inline double& wheelStatus(int wheel) { return theWheelStatus[wheel+2]; };
+
+  /// Global report (output)
+  inline double& report() { return theReport; };
+
+  /// Write the outputs, each ME once
+  void write(MonitorElement* reportME, MonitorElement* reportMapME,
+	     const std::vector<MonitorElement*>& wheelMEs) const;
+
+private:
+
+  inline int sectorIndex(int wheel, int sector) const { return (wheel+2)*12 + sector-1; };
+  inline int chamberIndex(int wheel, int sector, int station) const { return sectorIndex(wheel,sector)*4 + station-1; };
+
+  std::vector<double> theChamberValues;
+  std::vector<double> theChamberErrors;
+  std::vector<double> theSectorValues;
+
+  std::vector<double> theSectorStatus;
+  std::vector<double> theWheelStatus;
+  double theReport;
+
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef DTSummaryShmLayout_H
+#define DTSummaryShmLayout_H
+
+/** \file
+ *  Layout of the shared memory segment where DTSummaryShmPublisher writes
+ *  the DT summary maps and float reports. Plain C, shared with the reader
+ *  library (test/DTSummaryShmReader.h) used by the local consumers.
+ *
+ *  The writer increments the sequence number before and after each update:
+ *  a copy taken while the sequence is odd, or that changed during the copy,
+ *  is not consistent and has to be taken again.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <stdint.h>
+
+#define DTSUMMARYSHM_MAGIC      0x44545348u   /* "DTSH" */
+#define DTSUMMARYSHM_VERSION    1u
+#define DTSUMMARYSHM_NAMELENGTH 96
+#define DTSUMMARYSHM_MAXMAPS    64
+#define DTSUMMARYSHM_MAXBINS    256
+#define DTSUMMARYSHM_MAXREPORTS 64
+
+/* A 2D summary map: values[(binY-1)*nBinsX + (binX-1)], ROOT bin numbering */
+typedef struct {
+  char name[DTSUMMARYSHM_NAMELENGTH];   /* full DQM path */
+  int32_t nBinsX;
+  int32_t nBinsY;
+  float values[DTSUMMARYSHM_MAXBINS];
+} DTSummaryShmMap;
+
+/* A float report (reportSummary, reportSummaryContents) */
+typedef struct {
+  char name[DTSUMMARYSHM_NAMELENGTH];   /* full DQM path */
+  float value;
+  int32_t valid;                        /* 0 if the ME was not found */
+} DTSummaryShmReport;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;                        /* sizeof(DTSummaryShmSegment) of the writer */
+  volatile uint32_t sequence;           /* odd while an update is in progress */
+  int32_t run;
+  int32_t lumi;
+  double updateTime;                    /* wall time of the last update (s since the epoch) */
+  uint32_t nMaps;
+  uint32_t nReports;
+  DTSummaryShmMap maps[DTSUMMARYSHM_MAXMAPS];
+  DTSummaryShmReport reports[DTSUMMARYSHM_MAXREPORTS];
+} DTSummaryShmSegment;
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTSummaryShmPublisher.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+using namespace std;
+using namespace edm;
+
+
+DTSummaryShmPublisher::DTSummaryShmPublisher(const ParameterSet& pset) : theSegment(0) {
+
+  // name of the POSIX shared memory segment
+  theSegmentName = pset.getUntrackedParameter<string>("segmentName", "/dtDQMSummaries");
+  // remove the segment at the end of the job (by default it is left to the consumers)
+  theRemoveAtEnd = pset.getUntrackedParameter<bool>("removeAtEnd", false);
+  // full DQM paths of the summary maps and of the float reports
+  theMapNames = pset.getUntrackedParameter<vector<string> >("summaryMaps");
+  theReportNames = pset.getUntrackedParameter<vector<string> >("reports");
+
+  if(theMapNames.size() > DTSUMMARYSHM_MAXMAPS) {
+    LogWarning("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+      << "Only the first " << DTSUMMARYSHM_MAXMAPS << " summary maps are published";
+    theMapNames.resize(DTSUMMARYSHM_MAXMAPS);
+  }
+  if(theReportNames.size() > DTSUMMARYSHM_MAXREPORTS) {
+    LogWarning("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+      << "Only the first " << DTSUMMARYSHM_MAXREPORTS << " reports are published";
+    theReportNames.resize(DTSUMMARYSHM_MAXREPORTS);
+  }
+
+}
+
+
+
+
+DTSummaryShmPublisher::~DTSummaryShmPublisher() {
+
+  if(theSegment != 0) munmap(theSegment, sizeof(DTSummaryShmSegment));
+
+}
+
+
+
+void DTSummaryShmPublisher::beginJob(){
+  // get the DQMStore
+  theDbe = Service<DQMStore>().operator->();
+
+  int fd = shm_open(theSegmentName.c_str(), O_CREAT | O_RDWR, 0644);
+  if(fd < 0 || ftruncate(fd, sizeof(DTSummaryShmSegment)) != 0) {
+    LogError("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+      << "Cannot create the shared memory segment " << theSegmentName << ", publication disabled";
+    if(fd >= 0) close(fd);
+    return;
+  }
+  void *address = mmap(0, sizeof(DTSummaryShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if(address == MAP_FAILED) {
+    LogError("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+      << "Cannot map the shared memory segment " << theSegmentName << ", publication disabled";
+    return;
+  }
+  theSegment = static_cast<DTSummaryShmSegment*>(address);
+
+  // a segment left by a previous job is reused: keep its sequence so that the readers see the change
+  uint32_t sequence = theSegment->magic == DTSUMMARYSHM_MAGIC ? theSegment->sequence : 0;
+  theSegment->sequence = sequence | 1;
+  __sync_synchronize();
+  theSegment->magic = DTSUMMARYSHM_MAGIC;
+  theSegment->version = DTSUMMARYSHM_VERSION;
+  theSegment->size = sizeof(DTSummaryShmSegment);
+  theSegment->run = 0;
+  theSegment->lumi = 0;
+  theSegment->updateTime = 0.;
+  theSegment->nMaps = theMapNames.size();
+  theSegment->nReports = theReportNames.size();
+  for(unsigned int iMap = 0; iMap != theMapNames.size(); ++iMap) {
+    DTSummaryShmMap& map = theSegment->maps[iMap];
+    strncpy(map.name, theMapNames[iMap].c_str(), DTSUMMARYSHM_NAMELENGTH-1);
+    map.name[DTSUMMARYSHM_NAMELENGTH-1] = '\0';
+    map.nBinsX = 0;
+    map.nBinsY = 0;
+  }
+  for(unsigned int iReport = 0; iReport != theReportNames.size(); ++iReport) {
+    DTSummaryShmReport& report = theSegment->reports[iReport];
+    strncpy(report.name, theReportNames[iReport].c_str(), DTSUMMARYSHM_NAMELENGTH-1);
+    report.name[DTSUMMARYSHM_NAMELENGTH-1] = '\0';
+    report.value = 0.;
+    report.valid = 0;
+  }
+  __sync_synchronize();
+  theSegment->sequence = sequence + 2 - sequence%2;
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+    << "[DTSummaryShmPublisher]: publishing " << theMapNames.size() << " maps and "
+    << theReportNames.size() << " reports in " << theSegmentName;
+
+}
+
+
+
+void DTSummaryShmPublisher::analyze(const Event& event, const EventSetup& setup){}
+
+
+
+void DTSummaryShmPublisher::endLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup) {
+
+  publish(lumi.run(), lumi.id().luminosityBlock());
+
+}
+
+
+
+void DTSummaryShmPublisher::endRun(const Run& run, const EventSetup& setup) {
+
+  publish(run.run(), theSegment != 0 ? theSegment->lumi : 0);
+
+}
+
+
+
+void DTSummaryShmPublisher::endJob() {
+
+  if(theRemoveAtEnd && theSegment != 0) {
+    munmap(theSegment, sizeof(DTSummaryShmSegment));
+    theSegment = 0;
+    shm_unlink(theSegmentName.c_str());
+  }
+
+}
+
+
+
+void DTSummaryShmPublisher::publish(int run, int lumi) {
+
+  if(theSegment == 0) return;
+
+  // get the MEs before opening the update, to keep the readers out for the shortest time
+  vector<MonitorElement*> maps(theMapNames.size(), (MonitorElement*)0);
+  for(unsigned int iMap = 0; iMap != theMapNames.size(); ++iMap) {
+    maps[iMap] = theDbe->get(theMapNames[iMap]);
+  }
+  vector<MonitorElement*> reports(theReportNames.size(), (MonitorElement*)0);
+  for(unsigned int iReport = 0; iReport != theReportNames.size(); ++iReport) {
+    reports[iReport] = theDbe->get(theReportNames[iReport]);
+  }
+
+  theSegment->sequence++;
+  __sync_synchronize();
+
+  theSegment->run = run;
+  theSegment->lumi = lumi;
+  for(unsigned int iMap = 0; iMap != maps.size(); ++iMap) {
+    DTSummaryShmMap& map = theSegment->maps[iMap];
+    MonitorElement *me = maps[iMap];
+    int nBinsX = me != 0 ? me->getNbinsX() : 0;
+    int nBinsY = me != 0 ? me->getNbinsY() : 0;
+    if(nBinsX*nBinsY > DTSUMMARYSHM_MAXBINS) {
+      LogWarning("DTDQM|DTMonitorClient|DTSummaryShmPublisher")
+	<< theMapNames[iMap] << " has too many bins (" << nBinsX*nBinsY << "), not published";
+      nBinsX = 0;
+      nBinsY = 0;
+    }
+    map.nBinsX = nBinsX;
+    map.nBinsY = nBinsY;
+    for(int binY = 1; binY <= nBinsY; ++binY) {
+      for(int binX = 1; binX <= nBinsX; ++binX) {
+	map.values[(binY-1)*nBinsX + binX-1] = me->getBinContent(binX, binY);
+      }
+    }
+  }
+  for(unsigned int iReport = 0; iReport != reports.size(); ++iReport) {
+    DTSummaryShmReport& report = theSegment->reports[iReport];
+    report.valid = reports[iReport] != 0;
+    report.value = reports[iReport] != 0 ? reports[iReport]->getFloatValue() : 0.;
+  }
+  theSegment->updateTime = DTClientPerformance::wallTime();
+
+  __sync_synchronize();
+  theSegment->sequence++;
+
+}
@@ -0,0 +1,56 @@
+#ifndef DTMonitorClient_DTSummaryShmPublisher_H
+#define DTMonitorClient_DTSummaryShmPublisher_H
+
+/** \class DTSummaryShmPublisher
+ *  Copies the DT summary maps and float reports into a POSIX shared memory
+ *  segment (see DTSummaryShmLayout.h) at the end of each LS and run, so that
+ *  local consumers can read them without going through the DQMStore or ROOT.
+ *  The update is protected by a seqlock: the readers never block the job.
+ *  To see the results of all the clients it has to be put at the end of
+ *  the client sequence.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "DQM/DTMonitorClient/src/DTSummaryShmLayout.h"
+
+#include <string>
+#include <vector>
+
+class DQMStore;
+
+class DTSummaryShmPublisher : public edm::EDAnalyzer {
+public:
+  /// Constructor
+  DTSummaryShmPublisher(const edm::ParameterSet& pset);
+
+  /// Destructor
+  virtual ~DTSummaryShmPublisher();
+
+private:
+  virtual void beginJob();
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
+  virtual void endRun(const edm::Run& run, const edm::EventSetup& setup);
+  virtual void endJob();
+
+  /// Copy the MEs into the segment
+  void publish(int run, int lumi);
+
+  DQMStore *theDbe;
+
+  std::string theSegmentName;
+  bool theRemoveAtEnd;
+  std::vector<std::string> theMapNames;
+  std::vector<std::string> theReportNames;
+
+  DTSummaryShmSegment *theSegment;
+
+};
+
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTTrendBuffer.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TH1F.h"
+
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+
+
+DTTrendBuffer::DTTrendBuffer(DQMStore *dbe, const string& name, const string& title,
+			     int nSlots, int lsPerSlot, bool sliding) :
+  theDbe(dbe), theFolder(dbe->pwd()), theName(name), theTitle(title),
+  theLSPerSlot(max(lsPerSlot, 1)), isSliding(sliding), theME(0) {
+
+  Slot empty = { -1, 0., 0 };
+  theSlots.assign(max(nSlots, 1), empty);
+  reset();
+
+  // the range of the fixed trend is known at the first materialize
+  if(isSliding) {
+    theME = theDbe->book1D(theName, theTitle, theSlots.size(), 0., theSlots.size());
+    theME->setAxisTitle("LS", 1);
+  }
+
+}
+
+
+void DTTrendBuffer::append(int ls, float value) {
+
+  if(theFirstLS < 0) theFirstLS = ls;
+  int id = slotId(ls);
+  if(id < 0 || (!isSliding && id >= int(theSlots.size()))) return;
+  if(isSliding && id <= theLastId - int(theSlots.size())) return;
+
+  Slot& slot = theSlots[id%theSlots.size()];
+  if(slot.id != id) {
+    slot.id = id;
+    slot.sum = 0.;
+    slot.nLS = 0;
+  }
+  slot.sum += value;
+  ++slot.nLS;
+
+  theLastId = max(theLastId, id);
+  theDirtyId = min(theDirtyId, id);
+
+}
+
+
+void DTTrendBuffer::reset() {
+
+  for(vector<Slot>::iterator slot = theSlots.begin(); slot != theSlots.end(); ++slot) {
+    (*slot).id = -1;
+  }
+  theFirstLS = -1;
+  theLastId = -1;
+  theDirtyId = 0;
+  theMaterializedId = -1;
+  if(theME != 0) theME->Reset();
+
+}
+
+
+MonitorElement* DTTrendBuffer::materialize() {
+
+  if(theLastId < 0 || (theDirtyId > theLastId && theLastId == theMaterializedId)) return theME;
+
+  int nSlots = theSlots.size();
+  int firstBin = 1;
+  if(isSliding) {
+    // the window moved: all the bins shift
+    if(theLastId != theMaterializedId) {
+      theME->Reset();
+      int labelStep = max(nSlots/10, 1);
+      for(int bin = 1; bin <= nSlots; bin += labelStep) {
+	int id = theLastId - nSlots + bin;
+	stringstream label;
+	if(id >= 0) label << id*theLSPerSlot;
+	theME->setBinLabel(bin, label.str(), 1);
+      }
+    } else {
+      firstBin = theDirtyId - theLastId + nSlots;
+    }
+    for(int bin = max(firstBin, 1); bin <= nSlots; ++bin) {
+      theME->setBinContent(bin, content(theLastId - nSlots + bin));
+    }
+  } else {
+    // the fixed trend covers the slots up to the last one appended
+    int nBins = theLastId + 1;
+    if(theME == 0) {
+      string currentFolder = theDbe->pwd();
+      theDbe->setCurrentFolder(theFolder);
+      theME = theDbe->book1D(theName, theTitle, nBins, theFirstLS, theFirstLS + nBins*theLSPerSlot);
+      theME->setAxisTitle("LS", 1);
+      theDbe->setCurrentFolder(currentFolder);
+    } else if(theLastId != theMaterializedId) {
+      theME->getTH1F()->SetBins(nBins, theFirstLS, theFirstLS + nBins*theLSPerSlot);
+    } else {
+      firstBin = theDirtyId + 1;
+    }
+    for(int bin = firstBin; bin <= nBins; ++bin) {
+      theME->setBinContent(bin, content(bin - 1));
+    }
+  }
+
+  theMaterializedId = theLastId;
+  theDirtyId = theLastId + 1;
+  return theME;
+
+}
+
+
+int DTTrendBuffer::slotId(int ls) const {
+
+  if(isSliding) return ls/theLSPerSlot;
+  return ls < theFirstLS ? -1 : (ls - theFirstLS)/theLSPerSlot;
+
+}
+
+
+float DTTrendBuffer::content(int id) const {
+
+  if(id < 0) return 0.;
+  const Slot& slot = theSlots[id%theSlots.size()];
+  return (slot.id == id && slot.nLS != 0) ? slot.sum/slot.nLS : 0.;
+
+}
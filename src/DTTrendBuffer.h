@@ -0,0 +1,73 @@
+#ifndef DTTrendBuffer_H
+#define DTTrendBuffer_H
+
+/** \class DTTrendBuffer
+ *  Per LS trend of a client result kept in a fixed size ring of slots
+ *  (lsPerSlot LS each, the slot content is the average of its LS).
+ *  In sliding mode the ring holds the last nSlots slots, otherwise the
+ *  nSlots slots starting from the first LS appended (later LS are
+ *  dropped). Appending a LS is O(1) and the memory does not grow with
+ *  the run length; the ME is only written by materialize, and only the
+ *  bins changed since the previous call are rewritten.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <string>
+#include <vector>
+
+class DQMStore;
+class MonitorElement;
+
+class DTTrendBuffer {
+
+public:
+
+  /// Constructor: the ME is booked in the current folder of the DQMStore
+  DTTrendBuffer(DQMStore *dbe, const std::string& name, const std::string& title,
+		int nSlots, int lsPerSlot = 1, bool sliding = true);
+
+  /// Add the value of a LS
+  void append(int ls, float value);
+
+  /// Forget the content, the next LS appended starts a new trend
+  void reset();
+
+  /// Copy the changes to the ME and return it
+  MonitorElement* materialize();
+
+  /// Memory used by the ring (bytes)
+  unsigned int bytes() const { return theSlots.size()*sizeof(Slot); };
+
+private:
+
+  struct Slot {
+    int id;
+    float sum;
+    int nLS;
+  };
+
+  int slotId(int ls) const;
+  float content(int id) const;
+
+  DQMStore *theDbe;
+  std::string theFolder;
+  std::string theName;
+  std::string theTitle;
+  int theLSPerSlot;
+  bool isSliding;
+
+  std::vector<Slot> theSlots;
+  int theFirstLS;
+  // last slot appended and first slot changed since the last materialize
+  int theLastId;
+  int theDirtyId;
+  // last slot in the ME (-1 if the ME is empty)
+  int theMaterializedId;
+
+  MonitorElement *theME;
+
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+// This class header
+#include "DQM/DTMonitorClient/src/DTTrigEfficiencyKernel.h"
+
+// Root
+#include "TH1F.h"
+#include "TH2F.h"
+
+//C++ headers
+#include <cmath>
+
+using namespace std;
+
+
+DTTrigEfficiencyKernel::DTTrigEfficiencyKernel(bool wilsonErrors) :
+  useWilson(wilsonErrors), totNum(0.), totDen(0.) {
+
+}
+
+
+DTTrigEfficiencyKernel::~DTTrigEfficiencyKernel() {
+
+}
+
+
+bool DTTrigEfficiencyKernel::compute(TH2F* numerator, TH2F* denominator, TH2F* result2D,
+				     TH1F* resultX, TH1F* resultY) {
+
+  totNum = 0.;
+  totDen = 0.;
+
+  int nbinsx = denominator->GetNbinsX();
+  int nbinsy = denominator->GetNbinsY();
+  if (numerator->GetNbinsX() != nbinsx || numerator->GetNbinsY() != nbinsy ||
+      result2D->GetNbinsX()  != nbinsx || result2D->GetNbinsY()  != nbinsy ||
+      (resultX && resultX->GetNbinsX() != nbinsx) ||
+      (resultY && resultY->GetNbinsX() != nbinsy)) {
+    return false;
+  }
+
+  // Projections include under/overflows, as TH2::ProjectionX/Y by default
+  numX.assign(nbinsx+2,0.);
+  denX.assign(nbinsx+2,0.);
+  numY.assign(nbinsy+2,0.);
+  denY.assign(nbinsy+2,0.);
+
+  int stride = nbinsx+2;
+  for (int biny=0; biny<=nbinsy+1; ++biny){
+    bool inY = biny>=1 && biny<=nbinsy;
+    for (int binx=0; binx<=nbinsx+1; ++binx){
+      int bin = binx + stride*biny;
+      double num = numerator->GetBinContent(bin);
+      double den = denominator->GetBinContent(bin);
+
+      numX[binx] += num;
+      denX[binx] += den;
+      numY[biny] += num;
+      denY[biny] += den;
+      totNum += num;
+      totDen += den;
+
+      if (inY && binx>=1 && binx<=nbinsx) {
+	if (den) {
+	  float eff = num/den;
+	  result2D->SetBinContent(bin,eff);
+	  result2D->SetBinError(bin,error(eff,den));
+	}
+	else {
+	  result2D->SetBinContent(bin,0.);
+	  result2D->SetBinError(bin,1.);
+	}
+      }
+    }
+  }
+
+  if (resultX) fillProjection(numX,denX,resultX);
+  if (resultY) fillProjection(numY,denY,resultY);
+
+  return true;
+
+}
+
+
+float DTTrigEfficiencyKernel::error(float eff, double n) const {
+
+  float var = eff*(1-eff)/n;
+  if (var<0) var = 0; // rounding for eff~1
+  if (!useWilson) {
+    return sqrt(var);
+  }
+
+  // Half width of the Wilson score interval (1 sigma)
+  return sqrt(var + 1./(4*n*n)) / (1 + 1./n);
+
+}
+
+
+void DTTrigEfficiencyKernel::fillProjection(const vector<double>& num, const vector<double>& den, TH1F* result) const {
+
+  int nbins = result->GetNbinsX();
+  for (int bin=1; bin<=nbins; ++bin){
+    if (den[bin]) {
+      float eff = num[bin]/den[bin];
+      result->SetBinContent(bin,eff);
+      result->SetBinError(bin,error(eff,den[bin]));
+    }
+    else {
+      result->SetBinContent(bin,1.);
+      result->SetBinError(bin,1.);
+    }
+  }
+
+}
@@ -0,0 +1,60 @@
+#ifndef DTTrigEfficiencyKernel_H
+#define DTTrigEfficiencyKernel_H
+
+/** \class DTTrigEfficiencyKernel
+ *  Computes trigger efficiencies from numerator and denominator 2D
+ *  histograms in a single sweep over the bins: the 2D ratio, the ratios
+ *  of the X and Y projections and the integrated efficiency are filled
+ *  together, with binomial or Wilson errors.
+ *  Projection buffers are kept between calls, no temporary histogram is
+ *  allocated.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include <vector>
+
+class TH1F;
+class TH2F;
+
+class DTTrigEfficiencyKernel {
+
+public:
+
+  /// Constructor
+  DTTrigEfficiencyKernel(bool wilsonErrors = false);
+
+  /// Destructor
+  virtual ~DTTrigEfficiencyKernel();
+
+  /// Compute the 2D efficiency and (if not null) the X/Y projected ones.
+  /// Empty bins get efficiency 0 in 2D and 1 in 1D, with error 1.
+  /// Returns false if the binning of the inputs/outputs does not match
+  bool compute(TH2F* numerator, TH2F* denominator, TH2F* result2D,
+	       TH1F* resultX = 0, TH1F* resultY = 0);
+
+  /// Integrated efficiency from the last compute call
+  float efficiency() const { return totDen ? totNum/totDen : 0.; };
+
+  /// Error on the integrated efficiency from the last compute call
+  float efficiencyError() const { return totDen ? error(efficiency(),totDen) : 1.; };
+
+  /// Sum of the denominator contents from the last compute call
+  double denominatorEntries() const { return totDen; };
+
+private:
+
+  /// Error on eff measured with n trials
+  float error(float eff, double n) const;
+
+  /// Fill a 1D efficiency from the projection buffers
+  void fillProjection(const std::vector<double>& num, const std::vector<double>& den, TH1F* result) const;
+
+  bool useWilson;
+  std::vector<double> numX, denX, numY, denY;
+  double totNum, totDen;
+
+};
+
+#endif
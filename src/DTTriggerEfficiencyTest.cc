@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTTriggerEfficiencyTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -36,7 +37,8 @@ using namespace edm;
 using namespace std;
 
 
-DTTriggerEfficiencyTest::DTTriggerEfficiencyTest(const edm::ParameterSet& ps){
+DTTriggerEfficiencyTest::DTTriggerEfficiencyTest(const edm::ParameterSet& ps) :
+  effKernel(ps.getUntrackedParameter<bool>("wilsonErrors",false)) {
 
   setConfig(ps,"DTTriggerEfficiency");
   baseFolderDCC = "DT/03-LocalTrigger-DCC/";
@@ -59,6 +61,7 @@ void DTTriggerEfficiencyTest::beginJob(){
 
 
 void DTTriggerEfficiencyTest::beginRun(const edm::Run& r,const edm::EventSetup& c){
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::Booking);
 
   DTLocalTriggerBaseTest::beginRun(r,c);
   trigGeomUtils = new DTTrigGeomUtils(muonGeom);
@@ -99,6 +102,7 @@ void DTTriggerEfficiencyTest::beginRun(const edm::Run& r,const edm::EventSetup&
 
 
 void DTTriggerEfficiencyTest::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTTriggerEfficiencyTest", DTClientPerformance::Diagnostic);
 
   // Loop over Trig & Hw sources
   for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
@@ -172,28 +176,16 @@ void DTTriggerEfficiencyTest::runClientDiagnostic() {
 
 void DTTriggerEfficiencyTest::makeEfficiencyME(TH2F* numerator, TH2F* denominator, MonitorElement* result2DWh, MonitorElement* result1DWh, MonitorElement* result1D){
 
-  TH2F* efficiency = result2DWh->getTH2F();
-  efficiency->Divide(numerator,denominator,1,1,"");
+  makeEfficiencyME(numerator,denominator,result2DWh);
 
+  TH2F* efficiency = result2DWh->getTH2F();
   int nbinsx = efficiency->GetNbinsX();
   int nbinsy = efficiency->GetNbinsY();
   for (int binx=1; binx<=nbinsx; ++binx){
     for (int biny=1; biny<=nbinsy; ++biny){
-      float error = 0;
       float bineff = efficiency->GetBinContent(binx,biny);
-
       result1DWh->Fill(bineff);
       result1D->Fill(bineff);
-
-      if (denominator->GetBinContent(binx,biny)){
-        error = sqrt(bineff*(1-bineff)/denominator->GetBinContent(binx,biny));
-      }
-      else {
-        error = 1;
-        efficiency->SetBinContent(binx,biny,0.);
-      }
-
-      efficiency->SetBinError(binx,biny,error);
     }
   }
 
@@ -201,29 +193,11 @@ void DTTriggerEfficiencyTest::makeEfficiencyME(TH2F* numerator, TH2F* denominato
 
 void DTTriggerEfficiencyTest::makeEfficiencyME(TH2F* numerator, TH2F* denominator, MonitorElement* result2DWh){
 
-  TH2F* efficiency = result2DWh->getTH2F();
-  efficiency->Divide(numerator,denominator,1,1,"");
-
-  int nbinsx = efficiency->GetNbinsX();
-  int nbinsy = efficiency->GetNbinsY();
-  for (int binx=1; binx<=nbinsx; ++binx){
-    for (int biny=1; biny<=nbinsy; ++biny){
-      float error = 0;
-      float bineff = efficiency->GetBinContent(binx,biny);
-
-      if (denominator->GetBinContent(binx,biny)){
-        error = sqrt(bineff*(1-bineff)/denominator->GetBinContent(binx,biny));
-      }
-      else {
-        error = 1;
-        efficiency->SetBinContent(binx,biny,0.);
-      }
-
-      efficiency->SetBinError(binx,biny,error);
-    }
+  if (!effKernel.compute(numerator,denominator,result2DWh->getTH2F())) {
+    LogVerbatim(category()) << "[" << testName << "Test]: binning mismatch computing " << result2DWh->getName();
   }
 
-}    
+}
 
 string DTTriggerEfficiencyTest::getMEName(string histoTag, string folder, int wh) {
 
@@ -14,6 +14,7 @@
 
 
 #include "DQM/DTMonitorClient/src/DTLocalTriggerBaseTest.h"
+#include "DQM/DTMonitorClient/src/DTTrigEfficiencyKernel.h"
 
 #include <string>
 
@@ -66,6 +67,7 @@ protected:
   std::map<int,std::map<std::string,MonitorElement*> > EffDistrPerWh;
   std::map<uint32_t,std::map<std::string,MonitorElement*> > chambME;
   DTTrigGeomUtils* trigGeomUtils;
+  DTTrigEfficiencyKernel effKernel;
   bool detailedPlots;
 
 };
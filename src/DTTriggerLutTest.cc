@@ -9,6 +9,7 @@
 
 // This class header
 #include "DQM/DTMonitorClient/src/DTTriggerLutTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework headers
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -45,6 +46,11 @@ DTTriggerLutTest::DTTriggerLutTest(const edm::ParameterSet& ps){
   validRange = ps.getUntrackedParameter<double>("validRange");
   detailedAnalysis = ps.getUntrackedParameter<bool>("detailedAnalysis");
 
+  phiTkvsTrigInput  = addChamberInput("PhitkvsPhitrig","Segment");
+  phibTkvsTrigInput = addChamberInput("PhibtkvsPhibtrig","Segment");
+  phiResidualInput  = addChamberInput("PhiResidual","Segment");
+  phibResidualInput = addChamberInput("PhibResidual","Segment");
+
 }
 
 
@@ -54,7 +60,8 @@ DTTriggerLutTest::~DTTriggerLutTest(){
 
 
 void DTTriggerLutTest::beginJob(){
-  
+  DTClientPerformance::Timer timer(testName + "Test", DTClientPerformance::Booking);
+
   DTLocalTriggerBaseTest::beginJob();
   
   vector<string>::const_iterator iTr   = trigSources.begin();
@@ -113,50 +120,109 @@ void DTTriggerLutTest::beginRun(const edm::Run& r, const edm::EventSetup& c){
 
 
 void DTTriggerLutTest::runClientDiagnostic() {
+  DTClientPerformance::Timer timer("DTTriggerLutTest", DTClientPerformance::Diagnostic);
 
   // Reset lut percentage 1D summaries
   if (detailedAnalysis){
-    cmsME.find(fullName("PhiPercentageSummary"))->second->Reset();
-    cmsME.find(fullName("PhibPercentageSummary"))->second->Reset();
+    vector<TrigHwSource>::const_iterator srcIt  = sources.begin();
+    vector<TrigHwSource>::const_iterator srcEnd = sources.end();
+    for (; srcIt != srcEnd; ++srcIt){
+      cmsME.find(fullName("PhiPercentageSummary",(*srcIt)))->second->Reset();
+      cmsME.find(fullName("PhibPercentageSummary",(*srcIt)))->second->Reset();
+    }
   }
 
-  // Loop over Trig & Hw sources
-  for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
-    trigSource = (*iTr);
-    for (vector<string>::const_iterator iHw = hwSources.begin(); iHw != hwSources.end(); ++iHw){
-      hwSource = (*iHw);
-      vector<DTChamber*>::const_iterator chIt  = muonGeom->chambers().begin();
-      vector<DTChamber*>::const_iterator chEnd = muonGeom->chambers().end();
-      for (; chIt != chEnd; ++chIt) {
-
-	DTChamberId chId((*chIt)->id());
-	int wh   = chId.wheel();
-	int sect = chId.sector();
-	int stat = chId.station();
-	
-	std::map<std::string,MonitorElement*> &innerME = whME[wh];
-	  
-	// Make Phi Residual Summary
-	TH1F * PhiResidual = getHisto<TH1F>(dbe->get(getMEName("PhiResidual","Segment", chId)));
-	int phiSummary = 1;
-	if (PhiResidual && PhiResidual->GetEntries()>10) {
+  // Single chamber sweep for all the Trig & Hw sources
+  sweepChambers();
 
-	  if( innerME.find(fullName("PhiResidualPercentage")) == innerME.end() ){
-	    bookWheelHistos(wh,"PhiResidualPercentage");  
+  // Barrel Summary Plots
+  vector<TrigHwSource>::const_iterator srcIt  = sources.begin();
+  vector<TrigHwSource>::const_iterator srcEnd = sources.end();
+  for (; srcIt != srcEnd; ++srcIt){
+    const TrigHwSource& src = (*srcIt);
+    for (int wh=-2; wh<=2; ++wh){
+
+      std::map<std::string,MonitorElement*> *innerME = &(whME[wh]);
+
+      TH2F* phiWhSummary   = getHisto<TH2F>(innerME->find(fullName("PhiLutSummary",src))->second);
+      TH2F* phibWhSummary  = getHisto<TH2F>(innerME->find(fullName("PhibLutSummary",src))->second);
+
+      for (int sect=1; sect<=12; ++sect){
+
+	int phiSectorTotal  = 0;   // CB dai 1 occhio a questo
+	int phibSectorTotal = 0;
+	int nullphi  = 0;
+	int nullphib = 0;
+	int phiStatus  = 5;
+	int phibStatus = 5;
+	int glbStatus  = 0;
+
+	for (int stat=1; stat<=4; ++stat){
+	  if (phiWhSummary->GetBinContent(sect,stat)==2){
+	    phiSectorTotal +=1;
+	    glbStatus += 1;
 	  }
-	  
-	  float rangeBin = validRange/(PhiResidual->GetBinWidth(1));
-	  float center   = (PhiResidual->GetNbinsX())/2.;
-	  float perc     = (PhiResidual->Integral(floor(center-rangeBin),ceil(center+rangeBin)))/(PhiResidual->Integral());
-	  fillWhPlot(innerME.find(fullName("PhiResidualPercentage"))->second,sect,stat,perc,false);
-	  phiSummary = performLutTest(perc,thresholdWarnPhi,thresholdErrPhi);
-	  if (detailedAnalysis) cmsME.find(fullName("PhiPercentageSummary"))->second->Fill(perc);
-
+	  if (phiWhSummary->GetBinContent(sect,stat)==1)
+	    nullphi+=1;
+	  if (phibWhSummary->GetBinContent(sect,stat)==2) {
+	    phibSectorTotal+=1;
+	    glbStatus += 1;
+	  }
+	  if (phibWhSummary->GetBinContent(sect,stat)==1)
+	    nullphib+=1;
 	}
+	if (nullphi!=4)
+	  phiStatus=phiSectorTotal;
+	else 
+	  phiStatus=5;
+	if (nullphib!=3)
+	  phibStatus=phibSectorTotal;
+	else 
+	  phibStatus=5;
+
+	cmsME.find("TrigLutSummary")->second->setBinContent(sect,wh+3,glbStatus);
+	cmsME.find(fullName("PhiLutSummary",src))->second->setBinContent(sect,wh+3,phiStatus);
+	cmsME.find(fullName("PhibLutSummary",src))->second->setBinContent(sect,wh+3,phibStatus);
+      }
+    }
+  }
 
-	fillWhPlot(innerME.find(fullName("PhiLutSummary"))->second,sect,stat,phiSummary);
-	
-	if (detailedAnalysis){
+}
+
+void DTTriggerLutTest::runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs) {
+
+  int wh   = chId.wheel();
+  int sect = chId.sector();
+  int stat = chId.station();
+  int nSources = sources.size();
+
+  std::map<std::string,MonitorElement*> &innerME = whME[wh];
+
+  for (int iSrc=0; iSrc<nSources; ++iSrc) {
+    const TrigHwSource& src = sources[iSrc];
+    const vector<MonitorElement*>& srcInputs = inputs[iSrc];
+
+    // Make Phi Residual Summary
+    TH1F * PhiResidual = getHisto<TH1F>(srcInputs[phiResidualInput]);
+    int phiSummary = 1;
+    if (PhiResidual && PhiResidual->GetEntries()>10) {
+
+      if( innerME.find(fullName("PhiResidualPercentage",src)) == innerME.end() ){
+	bookWheelHistos(src,wh,"PhiResidualPercentage");  
+      }
+
+      float rangeBin = validRange/(PhiResidual->GetBinWidth(1));
+      float center   = (PhiResidual->GetNbinsX())/2.;
+      float perc     = (PhiResidual->Integral(floor(center-rangeBin),ceil(center+rangeBin)))/(PhiResidual->Integral());
+      fillWhPlot(innerME.find(fullName("PhiResidualPercentage",src))->second,sect,stat,perc,false);
+      phiSummary = performLutTest(perc,thresholdWarnPhi,thresholdErrPhi);
+      if (detailedAnalysis) cmsME.find(fullName("PhiPercentageSummary",src))->second->Fill(perc);
+
+    }
+
+    fillWhPlot(innerME.find(fullName("PhiLutSummary",src))->second,sect,stat,phiSummary);
+
+    if (detailedAnalysis){
 
 // 	  if ((phiSummary ==0)&& (PhiResidual->GetEntries()>100)) {  //Precision Peak test
 
@@ -169,72 +235,72 @@ void DTTriggerLutTest::runClientDiagnostic() {
 // 	      source[i]=PhiResidual->GetBinContent(center+i-15);}
 // 	    int nFound = g->SearchHighRes(source, dest, 30, 1, 6, kFALSE, 5, kTRUE,2);
 // 	    /if (nFound>1) { // has more than 1 peak
-// 	      if( innerME.find(fullName("DoublePeakFlagPhi")) == innerME.end() ){
-// 		bookWheelHistos(wh,"DoublePeakFlagPhi");
+// 	      if( innerME.find(fullName("DoublePeakFlagPhi",src)) == innerME.end() ){
+// 		bookWheelHistos(src,wh,"DoublePeakFlagPhi");
 // 	      }
 // 	    }
 
-// 	    fillWhPlot(innerME.find(fullName("DoublePeakFlagPhi"))->second,sect,stat,1,false);	    
+// 	    fillWhPlot(innerME.find(fullName("DoublePeakFlagPhi",src))->second,sect,stat,1,false);	    
 // 	  }
 
-	  if ((phiSummary==0)||(phiSummary==3)){ //Information on the Peak
-
-	    if( innerME.find(fullName("PhiResidualMean")) == innerME.end() ){
-	      bookWheelHistos(wh,"PhiResidualMean");  
-	      bookWheelHistos(wh,"PhiResidualRMS");  
-	    }
-
-	    float center   = (PhiResidual->GetNbinsX())/2.;                   
-	    float rangeBin = validRange/(PhiResidual->GetBinWidth(1));
-	    PhiResidual->GetXaxis()->SetRange(floor(center-rangeBin),ceil(center+rangeBin));
-	    float max     = PhiResidual->GetMaximumBin();
-	    float maxBin  = PhiResidual->GetXaxis()->FindBin(max);
-	    float nBinMax = 0.5/(PhiResidual->GetBinWidth(1));
-	    PhiResidual->GetXaxis()->SetRange(floor(maxBin-nBinMax),ceil(maxBin+nBinMax));
-	    float Mean = PhiResidual->GetMean();
-	    float rms  = PhiResidual->GetRMS();	    
-
-	    fillWhPlot(innerME.find(fullName("PhiResidualMean"))->second,sect,stat,Mean);
-	    fillWhPlot(innerME.find(fullName("PhiResidualRMS"))->second,sect,stat,rms);
-	    
-	  }
-	  
-	  TH2F * TrackPhitkvsPhitrig   = getHisto<TH2F>(dbe->get(getMEName("PhitkvsPhitrig","Segment", chId)));
-
-	  if (TrackPhitkvsPhitrig && TrackPhitkvsPhitrig->GetEntries()>100) {
-	    float corr = TrackPhitkvsPhitrig->GetCorrelationFactor();
-	    if( innerME.find(fullName("CorrelationFactorPhi")) == innerME.end() ){
-	      bookWheelHistos(wh,"CorrelationFactorPhi");
-	    }
-	    fillWhPlot(innerME.find(fullName("CorrelationFactorPhi"))->second,sect,stat,corr,false);
-	  }
-	  
+      if ((phiSummary==0)||(phiSummary==3)){ //Information on the Peak
+
+	if( innerME.find(fullName("PhiResidualMean",src)) == innerME.end() ){
+	  bookWheelHistos(src,wh,"PhiResidualMean");  
+	  bookWheelHistos(src,wh,"PhiResidualRMS");  
 	}
-	
-				
-	// Make Phib Residual Summary
-	TH1F * PhibResidual = getHisto<TH1F>(dbe->get(getMEName("PhibResidual","Segment", chId)));
-	int phibSummary = stat==3 ? -1 : 1; // station 3 has no meaningful MB3 phi bending information
-	
-	if (stat != 3 && PhibResidual && PhibResidual->GetEntries()>10) {// station 3 has no meaningful MB3 phi bending information
 
-	  if( innerME.find(fullName("PhibResidualPercentage")) == innerME.end() ){
-	    bookWheelHistos(wh,"PhibResidualPercentage");  
-	  }
-	  
-	  float rangeBin = validRange/(PhibResidual->GetBinWidth(1));
-	  float center   = (PhibResidual->GetNbinsX())/2.;
-	  float perc     = (PhibResidual->Integral(floor(center-rangeBin),ceil(center+rangeBin)))/(PhibResidual->Integral());
+	float center   = (PhiResidual->GetNbinsX())/2.;                   
+	float rangeBin = validRange/(PhiResidual->GetBinWidth(1));
+	PhiResidual->GetXaxis()->SetRange(floor(center-rangeBin),ceil(center+rangeBin));
+	float max     = PhiResidual->GetMaximumBin();
+	float maxBin  = PhiResidual->GetXaxis()->FindBin(max);
+	float nBinMax = 0.5/(PhiResidual->GetBinWidth(1));
+	PhiResidual->GetXaxis()->SetRange(floor(maxBin-nBinMax),ceil(maxBin+nBinMax));
+	float Mean = PhiResidual->GetMean();
+	float rms  = PhiResidual->GetRMS();	    
 
-	  fillWhPlot(innerME.find(fullName("PhibResidualPercentage"))->second,sect,stat,perc,false);
-	  phibSummary = performLutTest(perc,thresholdWarnPhiB,thresholdErrPhiB);
-	  if (detailedAnalysis) cmsME.find(fullName("PhibPercentageSummary"))->second->Fill(perc);
+	fillWhPlot(innerME.find(fullName("PhiResidualMean",src))->second,sect,stat,Mean);
+	fillWhPlot(innerME.find(fullName("PhiResidualRMS",src))->second,sect,stat,rms);
 
+      }
+
+      TH2F * TrackPhitkvsPhitrig   = getHisto<TH2F>(srcInputs[phiTkvsTrigInput]);
+
+      if (TrackPhitkvsPhitrig && TrackPhitkvsPhitrig->GetEntries()>100) {
+	float corr = TrackPhitkvsPhitrig->GetCorrelationFactor();
+	if( innerME.find(fullName("CorrelationFactorPhi",src)) == innerME.end() ){
+	  bookWheelHistos(src,wh,"CorrelationFactorPhi");
 	}
+	fillWhPlot(innerME.find(fullName("CorrelationFactorPhi",src))->second,sect,stat,corr,false);
+      }
 
-	fillWhPlot(innerME.find(fullName("PhibLutSummary"))->second,sect,stat,phibSummary);
-	
-	if (detailedAnalysis){
+    }
+
+
+    // Make Phib Residual Summary
+    TH1F * PhibResidual = getHisto<TH1F>(srcInputs[phibResidualInput]);
+    int phibSummary = stat==3 ? -1 : 1; // station 3 has no meaningful MB3 phi bending information
+
+    if (stat != 3 && PhibResidual && PhibResidual->GetEntries()>10) {// station 3 has no meaningful MB3 phi bending information
+
+      if( innerME.find(fullName("PhibResidualPercentage",src)) == innerME.end() ){
+	bookWheelHistos(src,wh,"PhibResidualPercentage");  
+      }
+
+      float rangeBin = validRange/(PhibResidual->GetBinWidth(1));
+      float center   = (PhibResidual->GetNbinsX())/2.;
+      float perc     = (PhibResidual->Integral(floor(center-rangeBin),ceil(center+rangeBin)))/(PhibResidual->Integral());
+
+      fillWhPlot(innerME.find(fullName("PhibResidualPercentage",src))->second,sect,stat,perc,false);
+      phibSummary = performLutTest(perc,thresholdWarnPhiB,thresholdErrPhiB);
+      if (detailedAnalysis) cmsME.find(fullName("PhibPercentageSummary",src))->second->Fill(perc);
+
+    }
+
+    fillWhPlot(innerME.find(fullName("PhibLutSummary",src))->second,sect,stat,phibSummary);
+
+    if (detailedAnalysis){
 
 // 	  if ((phibSummary ==0)&& (PhibResidual->GetEntries()>100)) {  //Precision Peak test 
 // 	    Float_t * source = new float[31];
@@ -247,102 +313,48 @@ void DTTriggerLutTest::runClientDiagnostic() {
 // 	    }
 // 	    int nFound = spec->SearchHighRes(source,dest,30,1,6,kFALSE,5,kTRUE,2);
 // 	    if (nFound>1) { // has more than 1 peak
-// 	      if( innerME.find(fullName("DoublePeakFlagPhib")) == innerME.end() ){
-// 		bookWheelHistos(wh,"DoublePeakFlagPhib");
+// 	      if( innerME.find(fullName("DoublePeakFlagPhib",src)) == innerME.end() ){
+// 		bookWheelHistos(src,wh,"DoublePeakFlagPhib");
 // 	      }
-// 	      fillWhPlot(innerME.find(fullName("DoublePeakFlagPhib"))->second,sect,stat,1,false);
+// 	      fillWhPlot(innerME.find(fullName("DoublePeakFlagPhib",src))->second,sect,stat,1,false);
 // 	    }
 // 	  }	  
-	  
-	  if ((phibSummary==0)||(phibSummary==3)){
-
-	    if( innerME.find(fullName("PhibResidualMean")) == innerME.end() ){
-	      bookWheelHistos(wh,"PhibResidualMean");  
-	      bookWheelHistos(wh,"PhibResidualRMS");  
-	    }
-
-	    float center   = (PhibResidual->GetNbinsX())/2.;
-	    float rangeBin =  validRange/(PhibResidual->GetBinWidth(1));
-	    PhibResidual->GetXaxis()->SetRange(floor(center-rangeBin),ceil(center+rangeBin));
-	    float max     = PhibResidual->GetMaximumBin();
-	    float maxBin  = PhibResidual->GetXaxis()->FindBin(max);
-	    float nBinMax = 0.5/(PhibResidual->GetBinWidth(1));
-	    PhibResidual->GetXaxis()->SetRange(floor(maxBin-nBinMax),ceil(maxBin+nBinMax));
-	    float Mean = PhibResidual->GetMean();
-	    float rms = PhibResidual->GetRMS();
-	    
-	    fillWhPlot(innerME.find(fullName("PhibResidualMean"))->second,sect,stat,Mean);
-	    fillWhPlot(innerME.find(fullName("PhibResidualRMS"))->second,sect,stat,rms);
-	  }
-
-	  TH2F * TrackPhibtkvsPhibtrig   = getHisto<TH2F>(dbe->get(getMEName("PhibtkvsPhibtrig","Segment", chId)));
-	  if (TrackPhibtkvsPhibtrig && TrackPhibtkvsPhibtrig->GetEntries()>100) {
 
-	    float corr = TrackPhibtkvsPhibtrig->GetCorrelationFactor();
-	    if( innerME.find(fullName("CorrelationFactorPhib")) == innerME.end() ){
-	      bookWheelHistos(wh,"CorrelationFactorPhib");
-	    }
+      if ((phibSummary==0)||(phibSummary==3)){
 
-	    fillWhPlot(innerME.find(fullName("CorrelationFactorPhib"))->second,sect,stat,corr,false);
+	if( innerME.find(fullName("PhibResidualMean",src)) == innerME.end() ){
+	  bookWheelHistos(src,wh,"PhibResidualMean");  
+	  bookWheelHistos(src,wh,"PhibResidualRMS");  
+	}
 
-	  }	  
-	  
-	}						
+	float center   = (PhibResidual->GetNbinsX())/2.;
+	float rangeBin =  validRange/(PhibResidual->GetBinWidth(1));
+	PhibResidual->GetXaxis()->SetRange(floor(center-rangeBin),ceil(center+rangeBin));
+	float max     = PhibResidual->GetMaximumBin();
+	float maxBin  = PhibResidual->GetXaxis()->FindBin(max);
+	float nBinMax = 0.5/(PhibResidual->GetBinWidth(1));
+	PhibResidual->GetXaxis()->SetRange(floor(maxBin-nBinMax),ceil(maxBin+nBinMax));
+	float Mean = PhibResidual->GetMean();
+	float rms = PhibResidual->GetRMS();
+
+	fillWhPlot(innerME.find(fullName("PhibResidualMean",src))->second,sect,stat,Mean);
+	fillWhPlot(innerME.find(fullName("PhibResidualRMS",src))->second,sect,stat,rms);
       }
-    }
-  }
-	
-  // Barrel Summary Plots
-  for (vector<string>::const_iterator iTr = trigSources.begin(); iTr != trigSources.end(); ++iTr){
-    trigSource = (*iTr);
-    for (vector<string>::const_iterator iHw = hwSources.begin(); iHw != hwSources.end(); ++iHw){
-      hwSource = (*iHw);  
-      for (int wh=-2; wh<=2; ++wh){
 
-	std::map<std::string,MonitorElement*> *innerME = &(whME[wh]);
-	
-	TH2F* phiWhSummary   = getHisto<TH2F>(innerME->find(fullName("PhiLutSummary"))->second);
-	TH2F* phibWhSummary  = getHisto<TH2F>(innerME->find(fullName("PhibLutSummary"))->second);
-
-	for (int sect=1; sect<=12; ++sect){
-
-	  int phiSectorTotal  = 0;   // CB dai 1 occhio a questo
-	  int phibSectorTotal = 0;
-	  int nullphi  = 0;
-	  int nullphib = 0;
-	  int phiStatus  = 5;
-	  int phibStatus = 5;
-	  int glbStatus  = 0;
-
-	  for (int stat=1; stat<=4; ++stat){
-	    if (phiWhSummary->GetBinContent(sect,stat)==2){
-	      phiSectorTotal +=1;
-	      glbStatus += 1;
-	    }
-	    if (phiWhSummary->GetBinContent(sect,stat)==1)
-	      nullphi+=1;
-	    if (phibWhSummary->GetBinContent(sect,stat)==2) {
-	      phibSectorTotal+=1;
-	      glbStatus += 1;
-	    }
-	    if (phibWhSummary->GetBinContent(sect,stat)==1)
-	      nullphib+=1;
-	  }
-	  if (nullphi!=4)
-	    phiStatus=phiSectorTotal;
-	  else 
-	    phiStatus=5;
-	  if (nullphib!=3)
-	    phibStatus=phibSectorTotal;
-	  else 
-	    phibStatus=5;
-	  
-	  cmsME.find("TrigLutSummary")->second->setBinContent(sect,wh+3,glbStatus);
-	  cmsME.find(fullName("PhiLutSummary"))->second->setBinContent(sect,wh+3,phiStatus);
-	  cmsME.find(fullName("PhibLutSummary"))->second->setBinContent(sect,wh+3,phibStatus);
+      TH2F * TrackPhibtkvsPhibtrig   = getHisto<TH2F>(srcInputs[phibTkvsTrigInput]);
+      if (TrackPhibtkvsPhibtrig && TrackPhibtkvsPhibtrig->GetEntries()>100) {
+
+	float corr = TrackPhibtkvsPhibtrig->GetCorrelationFactor();
+	if( innerME.find(fullName("CorrelationFactorPhib",src)) == innerME.end() ){
+	  bookWheelHistos(src,wh,"CorrelationFactorPhib");
 	}
-      }
-    }
+
+	fillWhPlot(innerME.find(fullName("CorrelationFactorPhib",src))->second,sect,stat,corr,false);
+
+      }	  
+
+    }						
+
   }
 
 }
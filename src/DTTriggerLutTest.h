@@ -39,6 +39,9 @@ protected:
   /// Run client analysis
   void runClientDiagnostic();
 
+  /// Run client analysis (per chamber, all the trig/hw sources)
+  void runChamberDiagnostic(const DTChamberId& chId, const ChamberInputs& inputs);
+
  private:
 
   /// Perform Lut Test logical operations
@@ -53,6 +56,8 @@ protected:
   double thresholdWarnPhiB, thresholdErrPhiB;
   double validRange;
   bool   detailedAnalysis;	
+  int phiTkvsTrigInput, phibTkvsTrigInput;
+  int phiResidualInput, phibResidualInput;
 	
 };
 
@@ -10,6 +10,8 @@
 
 
 #include "DQM/DTMonitorClient/src/DTtTrigCalibrationTest.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
+#include "DQM/DTMonitorClient/src/DTClientScheduler.h"
 
 // Framework
 #include <FWCore/Framework/interface/EventSetup.h>
@@ -36,7 +38,9 @@
 using namespace edm;
 using namespace std;
 
-DTtTrigCalibrationTest::DTtTrigCalibrationTest(const edm::ParameterSet& ps){
+DTtTrigCalibrationTest::DTtTrigCalibrationTest(const edm::ParameterSet& ps) :
+  badChannelCollector(ps,"DTtTrigCalibrationTest","tTrigCalibration"),
+  calibRecorder(ps,"DTtTrigCalibrationTest") {
   
   edm::LogVerbatim ("tTrigCalibration") <<"[DTtTrigCalibrationTest]: Constructor";
 
@@ -47,9 +51,12 @@ DTtTrigCalibrationTest::DTtTrigCalibrationTest(const edm::ParameterSet& ps){
   theFitter = new DTTimeBoxFitter();
 
   prescaleFactor = parameters.getUntrackedParameter<int>("diagnosticPrescale", 3);
+  schedulerSlot = DTClientScheduler::instance().registerClient("DTtTrigCalibrationTest", DTEventCounters::Digi, prescaleFactor);
 
   percentual = parameters.getUntrackedParameter<int>("BadSLpercentual", 10);
 
+  tTrigTest = badChannelCollector.addTest(parameters.getUntrackedParameter<string>("tTrigTestName","tTrigOffSet"));
+
 }
 
 
@@ -68,6 +75,8 @@ void DTtTrigCalibrationTest::beginJob(){
 
   nevents = 0;
 
+  badChannelCollector.bookHistos(dbe,"DT/Tests/DTtTrigCalibration");
+
 }
 
 
@@ -99,6 +108,7 @@ void DTtTrigCalibrationTest::analyze(const edm::Event& e, const edm::EventSetup&
 
 
 void DTtTrigCalibrationTest::endLuminosityBlock(LuminosityBlock const& lumiSeg, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTtTrigCalibrationTest", DTClientPerformance::EndLumi);
 
 
   // counts number of updats (online mode) or number of events (standalone mode)
@@ -114,8 +124,29 @@ void DTtTrigCalibrationTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
   // counts number of lumiSegs 
   nLumiSegs = lumiSeg.id().luminosityBlock();
 
-  // prescale factor
-  if ( nLumiSegs%prescaleFactor != 0 ) return;
+  // prescale factor or scheduler decision
+  if ( !DTClientScheduler::instance().runInLS(schedulerSlot, lumiSeg.run(), nLumiSegs, nLumiSegs) ) return;
+
+  runClientDiagnostic(context);
+
+}
+
+
+
+void DTtTrigCalibrationTest::endRun(Run const& run, EventSetup const& context) {
+  DTClientPerformance::Timer timer("DTtTrigCalibrationTest", DTClientPerformance::EndRun);
+
+  if ( DTClientScheduler::instance().pending(schedulerSlot) ) runClientDiagnostic(context);
+
+  // the tTrig of the last diagnostic go to the history
+  calibRecorder.commit(run.run());
+
+}
+
+
+
+void DTtTrigCalibrationTest::runClientDiagnostic(EventSetup const& context) {
+  DTClientScheduler::Execution execution(schedulerSlot);
 
   for(map<int, MonitorElement*> ::const_iterator histo = wheelHistos.begin();
       histo != wheelHistos.end();
@@ -137,6 +168,8 @@ void DTtTrigCalibrationTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
     }
   }
   
+  badChannelCollector.beginCollection(nLumiSegs);
+
   vector<DTChamber*>::const_iterator ch_it = muonGeom->chambers().begin();
   vector<DTChamber*>::const_iterator ch_end = muonGeom->chambers().end();
   for (; ch_it != ch_end; ++ch_it) {
@@ -161,18 +194,17 @@ void DTtTrigCalibrationTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 
 	if (histos.find((*ch_it)->id().rawId()) == histos.end()) bookHistos((*ch_it)->id());
 	histos.find((*ch_it)->id().rawId())->second->setBinContent(slID.superLayer(), meanAndSigma.first-tTrig);
+	calibRecorder.set(slID.rawId(), DTCalibHistory::TTrig, meanAndSigma.first);
 
       }
     }
     
-    if (histos.find((*ch_it)->id().rawId()) != histos.end()) {
-      string criterionName = parameters.getUntrackedParameter<string>("tTrigTestName","tTrigOffSet"); 
-      const QReport * theQReport = histos.find((*ch_it)->id().rawId())->second->getQReport(criterionName);
-      if(theQReport) {
-	vector<dqm::me_util::Channel> badChannels = theQReport->getBadChannels();
-	for (vector<dqm::me_util::Channel>::iterator channel = badChannels.begin(); 
+    map<uint32_t, MonitorElement*>::const_iterator chHisto = histos.find((*ch_it)->id().rawId());
+    if (chHisto != histos.end()) {
+      const vector<dqm::me_util::Channel>& badChannels = badChannelCollector.collect((*chHisto).second,tTrigTest,(*chHisto).first);
+      if(!badChannels.empty()) {
+	for (vector<dqm::me_util::Channel>::const_iterator channel = badChannels.begin(); 
 	     channel != badChannels.end(); channel++) {
-	  edm::LogError ("tTrigCalibration") <<"Chamber ID : "<<(*ch_it)->id()<<" Bad channels: "<<(*channel).getBin()<<" "<<(*channel).getContents();
 	  if(wheelHistos.find((*ch_it)->id().wheel()) == wheelHistos.end()) bookHistos((*ch_it)->id(), (*ch_it)->id().wheel());
 	  // fill the wheel summary histos if the SL has not passed the test
 	  if(!((*ch_it)->id().station() == 4 && (*channel).getBin() == 3))
@@ -192,13 +224,13 @@ void DTtTrigCalibrationTest::endLuminosityBlock(LuminosityBlock const& lumiSeg,
 	    wheelHistos[3]->Fill((*ch_it)->id().sector()-1,(*ch_it)->id().wheel());
 	  }
 	}
-	// FIXME: getMessage() sometimes returns and invalid string (null pointer inside QReport data member)
-	// edm::LogWarning ("tTrigCalibration") <<"-------- "<<theQReport->getMessage()<<" ------- "<<theQReport->getStatus();
       } 
     }
 
   }
 
+  badChannelCollector.endCollection();
+
 }
 
 
@@ -25,6 +25,9 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
+#include "DQM/DTMonitorClient/src/DTBadChannelCollector.h"
+#include "DQM/DTMonitorClient/src/DTCalibRecorder.h"
+
 #include <memory>
 #include <iostream>
 #include <fstream>
@@ -76,6 +79,12 @@ protected:
   /// DQM Client Diagnostic
   void endLuminosityBlock(edm::LuminosityBlock const& lumiSeg, edm::EventSetup const& c);
 
+  /// EndRun: run the diagnostic if the last LS were skipped
+  void endRun(edm::Run const& run, edm::EventSetup const& c);
+
+  /// Fit the time boxes and fill the summaries
+  void runClientDiagnostic(edm::EventSetup const& c);
+
 
 
 
@@ -84,6 +93,7 @@ private:
   int nevents;
   unsigned int nLumiSegs;
   int prescaleFactor;
+  int schedulerSlot;
   int run;
   int percentual;
 
@@ -101,6 +111,12 @@ private:
   // wheel summary histograms  
   std::map< int, MonitorElement* > wheelHistos;
 
+  DTBadChannelCollector badChannelCollector;
+  int tTrigTest;
+
+  // history of the fitted tTrig per SL
+  DTCalibRecorder calibRecorder;
+
 };
 
 #endif
@@ -9,6 +9,7 @@
 */
 
 #include "DQM/DTMonitorClient/src/L1TdeDTTPGClient.h"
+#include "DQM/DTMonitorClient/src/DTClientPerformance.h"
 
 // Framework
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -35,6 +36,7 @@ L1TdeDTTPGClient::L1TdeDTTPGClient(const ParameterSet& parameters) {
   theDQMStore    = Service<DQMStore>().operator->();
   
   theRunOnline  = parameters.getUntrackedParameter<bool>("runOnline");
+  theHasBothTh  = parameters.getUntrackedParameter<double>("hasBothThreshold");
   theQualTh     = parameters.getUntrackedParameter<double>("qualThreshold");
   theStatQualTh = parameters.getUntrackedParameter<double>("statQualThreshold");
   thePhiTh      = parameters.getUntrackedParameter<double>("phiThreshold");
@@ -66,6 +68,15 @@ void L1TdeDTTPGClient::beginRun(const Run& run, const EventSetup& context) {
     bookWheelHistos(wh); 
   }
   bookBarrelHistos();
+
+  // MEs are looked up again in the new run
+  theInputs.assign(240,ChamberInputs());
+  theHasResults.assign(240,false);
+  theQualInRange.assign(240,-1.);
+  thePhiInRange.assign(240,-1.);
+  thePhiBendInRange.assign(240,-1.);
+  theHasBothFrac.assign(240,0.);
+  theStatAgr.assign(240,-1.);
 		
 }
 
@@ -78,6 +89,7 @@ void L1TdeDTTPGClient::beginLuminosityBlock(const LuminosityBlock& lumiSeg, cons
 }
 
 void L1TdeDTTPGClient::endLuminosityBlock(const LuminosityBlock&  lumiSeg, const  EventSetup& context){
+  DTClientPerformance::Timer timer("L1TdeDTTPGClient", DTClientPerformance::EndLumi);
 
   if (theRunOnline)
     performClientDiagnostic();
@@ -85,48 +97,79 @@ void L1TdeDTTPGClient::endLuminosityBlock(const LuminosityBlock&  lumiSeg, const
 }
 
 void L1TdeDTTPGClient::performClientDiagnostic(){
+  DTClientPerformance::Timer timer("L1TdeDTTPGClient", DTClientPerformance::Diagnostic);
 
-  barrelHistos["hFracHasBoth"]->Reset();
-  barrelHistos["hFracQualInRange"]->Reset();
-  barrelHistos["hQualStatAgreement"]->Reset();
-  barrelHistos["hFracPhiInRange"]->Reset();
-  barrelHistos["hFracPhiBendInRange"]->Reset();
+  resolveChamberInputs();
 
+  // Compute the comparison for all the chambers
+  for (int iCh=0; iCh<240; ++iCh) {
+    const ChamberInputs& in = theInputs[iCh];
+    bool hasPhiBend = (iCh%4) != 2; // no phi bending in MB3
+    theHasResults[iCh] = in.deltaQual && in.deltaPhi && in.entries && in.dataQual && in.emuQual
+                         && (in.deltaPhiBend || !hasPhiBend);
+    if (!theHasResults[iCh]) continue;
+
+    theQualInRange[iCh]    = fracInRange(in.deltaQual,in.qualRange);
+    thePhiInRange[iCh]     = fracInRange(in.deltaPhi,in.phiRange);
+    thePhiBendInRange[iCh] = hasPhiBend ? fracInRange(in.deltaPhiBend,in.phiBendRange) : 1.;
+
+    float entries = in.entries->Integral();
+    theHasBothFrac[iCh] = entries>0 ? in.entries->GetBinContent(1)/entries : 0.;
+
+    theStatAgr[iCh] = computeAgreement(in.dataQual,in.emuQual);
+  }
+
+  // Write back the results
+  MonitorElement* hFracHasBoth        = barrelHistos["hFracHasBoth"];
+  MonitorElement* hFracQualInRange    = barrelHistos["hFracQualInRange"];
+  MonitorElement* hQualStatAgreement  = barrelHistos["hQualStatAgreement"];
+  MonitorElement* hFracPhiInRange     = barrelHistos["hFracPhiInRange"];
+  MonitorElement* hFracPhiBendInRange = barrelHistos["hFracPhiBendInRange"];
+
+  hFracHasBoth->Reset();
+  hFracQualInRange->Reset();
+  hQualStatAgreement->Reset();
+  hFracPhiInRange->Reset();
+  hFracPhiBendInRange->Reset();
 
-  
   for (int wh=-2;wh<=2;++wh){
-    for (int sec=1;sec<=12;++sec){
-      for (int st=1;st<=4;++st){
-	DTChamberId chId(wh,st,sec);
-	
-	float qualInRange    = fracInRange(getHisto(chId,"hDeltaQuality"),1);
-	float phiInRange     = fracInRange(getHisto(chId,"hDeltaPhi"),2);
-	float phiBendInRange = st != 3 ? fracInRange(getHisto(chId,"hDeltaPhiBend"),2) : 1.;
 
-	TH1F* hEntries = getHisto(chId,"hEntries")->getTH1F();
-	float hasBothFrac = hEntries->Integral()>0 ? 
-	  hEntries->GetBinContent(1)/hEntries->Integral() : 0.;
+    map<string, MonitorElement*>& whMap = whHistos[wh];
+    MonitorElement* hQualStatAgreementWheelMap = whMap["hQualStatAgreementWheelMap"];
+    MonitorElement* hDeltaQualityWheelMap      = whMap["hDeltaQualityWheelMap"];
+    MonitorElement* hEntriesWheelMap           = whMap["hEntriesWheelMap"];
+    MonitorElement* hTestSummary               = whMap["hTestSummary"];
+    MonitorElement* hDeltaPhiWheelMap          = whMap["hDeltaPhiWheelMap"];
+    MonitorElement* hDeltaPhiBendWheelMap      = whMap["hDeltaPhiBendWheelMap"];
 
-	float statAgr = computeAgreement(getHisto(chId,"hDataQuality"),
-					 getHisto(chId,"hEmuQuality"));
+    for (int sec=1;sec<=12;++sec){
+      for (int st=1;st<=4;++st){
+	int iCh = chamberIndex(wh,sec,st);
+	if (!theHasResults[iCh]) continue;
+
+	float qualInRange    = theQualInRange[iCh];
+	float phiInRange     = thePhiInRange[iCh];
+	float phiBendInRange = thePhiBendInRange[iCh];
+	float hasBothFrac    = theHasBothFrac[iCh];
+	float statAgr        = theStatAgr[iCh];
 	
 	float summary = qualInRange>theQualTh && hasBothFrac>theHasBothTh && statAgr>theStatQualTh 
 	                && phiInRange >= thePhiTh && phiBendInRange >= thePhiBendTh ? 1. : 0. ; 
 	
 	int phiBendId = st==4 ? 3 : st;  
-	whHistos[wh]["hQualStatAgreementWheelMap"]->setBinContent(sec,st,statAgr);
-	whHistos[wh]["hDeltaQualityWheelMap"]->setBinContent(sec,st,qualInRange);
-	whHistos[wh]["hEntriesWheelMap"]->setBinContent(sec,st,hasBothFrac);
-	whHistos[wh]["hTestSummary"]->setBinContent(sec,st,summary);
-	whHistos[wh]["hDeltaPhiWheelMap"]->setBinContent(sec,st,phiInRange);
+	hQualStatAgreementWheelMap->setBinContent(sec,st,statAgr);
+	hDeltaQualityWheelMap->setBinContent(sec,st,qualInRange);
+	hEntriesWheelMap->setBinContent(sec,st,hasBothFrac);
+	hTestSummary->setBinContent(sec,st,summary);
+	hDeltaPhiWheelMap->setBinContent(sec,st,phiInRange);
 	if (st!=3) {
-	  whHistos[wh]["hDeltaPhiBendWheelMap"]->setBinContent(sec,phiBendId,phiBendInRange);
+	  hDeltaPhiBendWheelMap->setBinContent(sec,phiBendId,phiBendInRange);
 	}
-	barrelHistos["hFracHasBoth"]->Fill(hasBothFrac);
-	barrelHistos["hFracQualInRange"]->Fill(qualInRange);
-	barrelHistos["hQualStatAgreement"]->Fill(statAgr);
-	barrelHistos["hFracPhiInRange"]->Fill(phiInRange);
-	barrelHistos["hFracPhiBendInRange"]->Fill(phiBendInRange);
+	hFracHasBoth->Fill(hasBothFrac);
+	hFracQualInRange->Fill(qualInRange);
+	hQualStatAgreement->Fill(statAgr);
+	hFracPhiInRange->Fill(phiInRange);
+	hFracPhiBendInRange->Fill(phiBendInRange);
       }
     }	
   }  
@@ -134,7 +177,47 @@ void L1TdeDTTPGClient::performClientDiagnostic(){
 }
 
 
+void L1TdeDTTPGClient::resolveChamberInputs(){
+
+  for (int wh=-2;wh<=2;++wh){
+    for (int sec=1;sec<=12;++sec){
+      for (int st=1;st<=4;++st){
+	ChamberInputs& in = theInputs[chamberIndex(wh,sec,st)];
+	if (in.deltaQual && in.deltaPhi && in.entries && in.dataQual && in.emuQual
+	    && (in.deltaPhiBend || st==3)) continue;
+
+	DTChamberId chId(wh,st,sec);
+	MonitorElement* me = 0;
+	if (!in.deltaQual && (me = getHisto(chId,"hDeltaQuality"))) {
+	  in.deltaQual = me->getTH1F();
+	  in.qualRange = binRange(in.deltaQual,1);
+	}
+	if (!in.deltaPhi && (me = getHisto(chId,"hDeltaPhi"))) {
+	  in.deltaPhi = me->getTH1F();
+	  in.phiRange = binRange(in.deltaPhi,2);
+	}
+	if (st!=3 && !in.deltaPhiBend && (me = getHisto(chId,"hDeltaPhiBend"))) {
+	  in.deltaPhiBend = me->getTH1F();
+	  in.phiBendRange = binRange(in.deltaPhiBend,2);
+	}
+	if (!in.entries && (me = getHisto(chId,"hEntries"))) {
+	  in.entries = me->getTH1F();
+	}
+	if (!in.dataQual && (me = getHisto(chId,"hDataQuality"))) {
+	  in.dataQual = me->getTH1F();
+	}
+	if (!in.emuQual && (me = getHisto(chId,"hEmuQuality"))) {
+	  in.emuQual = me->getTH1F();
+	}
+      }
+    }
+  }
+
+}
+
+
 void L1TdeDTTPGClient::endRun(const Run& run, const EventSetup& context) {
+  DTClientPerformance::Timer timer("L1TdeDTTPGClient", DTClientPerformance::EndRun);
 
   if(!theRunOnline)
     performClientDiagnostic();
@@ -226,12 +309,30 @@ void L1TdeDTTPGClient::bookBarrelHistos() {
 }
 
 
-float L1TdeDTTPGClient::fracInRange(MonitorElement *me, int range) {
+pair<int,int> L1TdeDTTPGClient::binRange(const TH1F *histo, int range) const {
+
+  const TAxis* axis = histo->GetXaxis();
+  int first = max(axis->FindFixBin(-range),1);
+  int last  = min(axis->FindFixBin(range),histo->GetNbinsX());
+
+  return make_pair(first,last);
+
+}
+
+
+float L1TdeDTTPGClient::fracInRange(const TH1F *histo, const pair<int,int>& range) const {
 
-  TH1F *histo = me->getTH1F();
+  const float* bins = histo->GetArray();
+  int nBins = histo->GetNbinsX();
 
-  float entries = histo->Integral();
-  float entriesInRange = histo->Integral(histo->FindBin(-range),histo->FindBin(range));
+  float entries = 0.;
+  for (int iBin=1; iBin<=nBins; ++iBin) {
+    entries += bins[iBin];
+  }
+  float entriesInRange = 0.;
+  for (int iBin=range.first; iBin<=range.second; ++iBin) {
+    entriesInRange += bins[iBin];
+  }
   float fracInRange =  entries>20 ?  entriesInRange/entries : -1. ;
   
   return fracInRange;
@@ -239,22 +340,26 @@ float L1TdeDTTPGClient::fracInRange(MonitorElement *me, int range) {
 }
 
 
-float L1TdeDTTPGClient::computeAgreement(MonitorElement *data , MonitorElement *emu) {
+float L1TdeDTTPGClient::computeAgreement(const TH1F *data , const TH1F *emu) const {
 
-  if ( data->getNbinsX()!=emu->getNbinsX() ) {
+  if ( data->GetNbinsX()!=emu->GetNbinsX() ) {
     LogPrint("L1TdeDTTPGClient") << 
       "[L1TdeDTTPGClient]: data & emu plots have different # of bins!" << endl;
     return -1.;
   }
 
-  int nBins = data->getNbinsX();
+  int nBins = data->GetNbinsX();
+  const float* dataBins = data->GetArray();
+  const float* emuBins  = emu->GetArray();
 
   double delta = 0.;
   for (int iBin=1; iBin<=nBins; ++iBin) {
-    delta += fabs(data->getBinContent(iBin) - emu->getBinContent(iBin));
+    delta += fabs(dataBins[iBin] - emuBins[iBin]);
   }
-  delta /= (data->getEntries() + emu->getEntries());
-  float matching = data->getEntries()>20 || emu->getEntries()>20 ? max(1-delta,0.) : -1;
+  double dataEntries = data->GetEntries();
+  double emuEntries  = emu->GetEntries();
+  delta /= (dataEntries + emuEntries);
+  float matching = dataEntries>20 || emuEntries>20 ? max(1-delta,0.) : -1;
   
   return matching;	   
 
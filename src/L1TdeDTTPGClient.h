@@ -31,6 +31,9 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <utility>
+
+class TH1F;
 
 class L1TdeDTTPGClient: public edm::EDAnalyzer{
 
@@ -76,13 +79,31 @@ class L1TdeDTTPGClient: public edm::EDAnalyzer{
   /// Get the top folder
   std::string& topFolder() { return theBaseFolder; }
 
-  float fracInRange(MonitorElement *me, int range);
+  /// Per chamber inputs, resolved from the DQMStore once per run
+  struct ChamberInputs {
+    ChamberInputs() : deltaQual(0), deltaPhi(0), deltaPhiBend(0), entries(0), dataQual(0), emuQual(0),
+		      qualRange(0,-1), phiRange(0,-1), phiBendRange(0,-1) {};
+    TH1F *deltaQual, *deltaPhi, *deltaPhiBend, *entries, *dataQual, *emuQual;
+    std::pair<int,int> qualRange, phiRange, phiBendRange; // [first,last] bins in range
+  };
+
+  /// Dense index of the (wh,sec,st) chamber
+  inline int chamberIndex(int wh, int sec, int st) const { return (wh+2)*48 + (sec-1)*4 + (st-1); };
+
+  /// Resolve (or retry, if still missing) the inputs of every chamber
+  void resolveChamberInputs();
+
+  /// Fraction of entries in the [first,last] bin range, -1 if not enough entries
+  float fracInRange(const TH1F *histo, const std::pair<int,int>& range) const;
+
+  /// Bins corresponding to the [-range,range] interval
+  std::pair<int,int> binRange(const TH1F *histo, int range) const;
 
   MonitorElement * getHisto(const DTChamberId & chId, std::string histoTag ) const;
 
   void performClientDiagnostic();
 
-  float computeAgreement(MonitorElement *data, MonitorElement *emu);
+  float computeAgreement(const TH1F *data, const TH1F *emu) const;
 
  private:
   
@@ -103,6 +124,14 @@ class L1TdeDTTPGClient: public edm::EDAnalyzer{
   std::map<int, std::map<std::string, MonitorElement*> > whHistos;
   std::map<std::string, MonitorElement*> barrelHistos;
 
+  std::vector<ChamberInputs> theInputs;
+  std::vector<bool>  theHasResults;
+  std::vector<float> theQualInRange;
+  std::vector<float> thePhiInRange;
+  std::vector<float> thePhiBendInRange;
+  std::vector<float> theHasBothFrac;
+  std::vector<float> theStatAgr;
+
 };
 
 #endif
@@ -81,3 +81,18 @@ DEFINE_FWK_MODULE(DTRunConditionVarClient);
 
 #include "DQM/DTMonitorClient/src/L1TdeDTTPGClient.h"
 DEFINE_FWK_MODULE(L1TdeDTTPGClient);
+
+#include "DQM/DTMonitorClient/src/DTClientPerformanceMonitor.h"
+DEFINE_FWK_MODULE(DTClientPerformanceMonitor);
+
+#include "DQM/DTMonitorClient/src/DTClientSchedulePlanner.h"
+DEFINE_FWK_MODULE(DTClientSchedulePlanner);
+
+#include "DQM/DTMonitorClient/src/DTSummaryShmPublisher.h"
+DEFINE_FWK_MODULE(DTSummaryShmPublisher);
+
+#include "DQM/DTMonitorClient/src/DTDeltaStreamWriter.h"
+DEFINE_FWK_MODULE(DTDeltaStreamWriter);
+
+#include "DQM/DTMonitorClient/src/DTReferenceComparisonTest.h"
+DEFINE_FWK_MODULE(DTReferenceComparisonTest);
@@ -0,0 +1,126 @@
+/*
+ *  See header file for a description of this library.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/test/DTSummaryShmReader.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* attempts to get a consistent copy before giving up */
+#define DTSUMMARYSHM_MAXATTEMPTS 100
+
+struct DTSummaryShmReader {
+  const DTSummaryShmSegment *segment;
+};
+
+
+DTSummaryShmReader* dtSummaryShmOpen(const char *name) {
+
+  DTSummaryShmReader *reader;
+  void *address;
+  struct stat info;
+  int fd = shm_open(name, O_RDONLY, 0);
+  if(fd < 0) return 0;
+  if(fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(DTSummaryShmSegment)) {
+    close(fd);
+    return 0;
+  }
+  address = mmap(0, sizeof(DTSummaryShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(address == MAP_FAILED) return 0;
+
+  reader = (DTSummaryShmReader*)malloc(sizeof(DTSummaryShmReader));
+  if(reader == 0) {
+    munmap(address, sizeof(DTSummaryShmSegment));
+    return 0;
+  }
+  reader->segment = (const DTSummaryShmSegment*)address;
+  return reader;
+
+}
+
+
+void dtSummaryShmClose(DTSummaryShmReader *reader) {
+
+  if(reader == 0) return;
+  munmap((void*)reader->segment, sizeof(DTSummaryShmSegment));
+  free(reader);
+
+}
+
+
+uint32_t dtSummaryShmSequence(const DTSummaryShmReader *reader) {
+
+  return reader->segment->sequence;
+
+}
+
+
+int dtSummaryShmRead(const DTSummaryShmReader *reader, DTSummaryShmSegment *snapshot) {
+
+  const DTSummaryShmSegment *segment = reader->segment;
+  int attempt;
+  for(attempt = 0; attempt != DTSUMMARYSHM_MAXATTEMPTS; ++attempt) {
+    uint32_t before = segment->sequence;
+    uint32_t after;
+    if(before%2 != 0) {
+      /* update in progress */
+      usleep(10);
+      continue;
+    }
+    __sync_synchronize();
+    memcpy(snapshot, (const void*)segment, sizeof(DTSummaryShmSegment));
+    __sync_synchronize();
+    after = segment->sequence;
+    if(after != before) continue;
+    if(snapshot->magic != DTSUMMARYSHM_MAGIC ||
+       snapshot->version != DTSUMMARYSHM_VERSION ||
+       snapshot->size != sizeof(DTSummaryShmSegment)) return -1;
+    return 0;
+  }
+  return -2;
+
+}
+
+
+const DTSummaryShmMap* dtSummaryShmFindMap(const DTSummaryShmSegment *snapshot, const char *name) {
+
+  uint32_t iMap;
+  for(iMap = 0; iMap < snapshot->nMaps && iMap < DTSUMMARYSHM_MAXMAPS; ++iMap) {
+    if(strncmp(snapshot->maps[iMap].name, name, DTSUMMARYSHM_NAMELENGTH) == 0) return &snapshot->maps[iMap];
+  }
+  return 0;
+
+}
+
+
+float dtSummaryShmBin(const DTSummaryShmMap *map, int binX, int binY) {
+
+  if(binX < 1 || binX > map->nBinsX || binY < 1 || binY > map->nBinsY) return 0.;
+  return map->values[(binY-1)*map->nBinsX + binX-1];
+
+}
+
+
+int dtSummaryShmFindReport(const DTSummaryShmSegment *snapshot, const char *name, float *value) {
+
+  uint32_t iReport;
+  for(iReport = 0; iReport < snapshot->nReports && iReport < DTSUMMARYSHM_MAXREPORTS; ++iReport) {
+    const DTSummaryShmReport *report = &snapshot->reports[iReport];
+    if(strncmp(report->name, name, DTSUMMARYSHM_NAMELENGTH) == 0) {
+      if(!report->valid) return -1;
+      *value = report->value;
+      return 0;
+    }
+  }
+  return -1;
+
+}
@@ -0,0 +1,56 @@
+#ifndef DTSummaryShmReader_H
+#define DTSummaryShmReader_H
+
+/** \file
+ *  C reader of the DT summary maps published in shared memory by
+ *  DTSummaryShmPublisher. No ROOT or CMSSW dependency: a consumer
+ *  links only this file (and -lrt).
+ *
+ *    DTSummaryShmReader *reader = dtSummaryShmOpen("/dtDQMSummaries");
+ *    DTSummaryShmSegment snapshot;
+ *    if(dtSummaryShmRead(reader, &snapshot) == 0) {
+ *      const DTSummaryShmMap *map = dtSummaryShmFindMap(&snapshot, "DT/EventInfo/reportSummaryMap");
+ *      ...
+ *    }
+ *    dtSummaryShmClose(reader);
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTSummaryShmLayout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DTSummaryShmReader DTSummaryShmReader;
+
+/* Map the segment read-only (0 if it does not exist) */
+DTSummaryShmReader* dtSummaryShmOpen(const char *name);
+
+/* Unmap the segment */
+void dtSummaryShmClose(DTSummaryShmReader *reader);
+
+/* Current sequence number: cheap polling, it changes at every update */
+uint32_t dtSummaryShmSequence(const DTSummaryShmReader *reader);
+
+/* Copy a consistent snapshot of the segment.
+   Return 0 on success, -1 if the segment is not valid (wrong magic, version or size),
+   -2 if no consistent copy could be taken (the writer is updating too often) */
+int dtSummaryShmRead(const DTSummaryShmReader *reader, DTSummaryShmSegment *snapshot);
+
+/* Map of a snapshot by DQM path (0 if not published) */
+const DTSummaryShmMap* dtSummaryShmFindMap(const DTSummaryShmSegment *snapshot, const char *name);
+
+/* Content of a map bin (ROOT numbering, 0 outside the map) */
+float dtSummaryShmBin(const DTSummaryShmMap *map, int binX, int binY);
+
+/* Value of a report by DQM path: return 0 if found and valid, -1 otherwise */
+int dtSummaryShmFindReport(const DTSummaryShmSegment *snapshot, const char *name, float *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
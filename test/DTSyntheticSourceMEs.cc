@@ -0,0 +1,270 @@
+/*
+ *  See header file for a description of this class.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+
+#include "DQM/DTMonitorClient/test/DTSyntheticSourceMEs.h"
+#include "DQM/DTMonitorClient/src/DTEventCounters.h"
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <sstream>
+
+
+using namespace std;
+using namespace edm;
+
+
+
+DTSyntheticSourceMEs::DTSyntheticSourceMEs(const ParameterSet& pset) :
+  theRandom(pset.getUntrackedParameter<unsigned int>("seed", 4357)), theEvents(0) {
+
+  // # of events added to the EventInfo counters at each LS
+  eventsPerLS = pset.getUntrackedParameter<int>("eventsPerLS", 1000);
+  // mean # of entries per bin per LS of the occupancy MEs
+  occupancy = pset.getUntrackedParameter<double>("occupancy", 5.);
+  // fraction of dead and noisy columns (wires) of the occupancy MEs
+  deadFraction = pset.getUntrackedParameter<double>("deadFraction", 0.01);
+  noisyFraction = pset.getUntrackedParameter<double>("noisyFraction", 0.005);
+  noiseFactor = pset.getUntrackedParameter<double>("noiseFactor", 50.);
+  // fraction of the entries of the error MEs outside the first bin
+  errorFraction = pset.getUntrackedParameter<double>("errorFraction", 0.001);
+  theTemplates = pset.getUntrackedParameter<vector<ParameterSet> >("histos");
+
+}
+
+
+
+
+DTSyntheticSourceMEs::~DTSyntheticSourceMEs() {}
+
+
+
+void DTSyntheticSourceMEs::beginJob(){
+  // get the DQMStore
+  theDbe = Service<DQMStore>().operator->();
+
+  // the counters read by the clients (see DTEventCounters): the source
+  // counters are float MEs, processedEvents is an int ME
+  theDbe->setCurrentFolder("DT/EventInfo/Counters");
+  theCounters.push_back(theDbe->bookFloat("nProcessedEventsDigi"));
+  theCounters.push_back(theDbe->bookFloat("nProcessedEventsNoise"));
+  theCounters.push_back(theDbe->bookFloat("nProcessedEventsSegment"));
+  theCounters.push_back(theDbe->bookFloat("nProcessedEventsTrigger"));
+  theDbe->setCurrentFolder("DT/EventInfo");
+  theCounters.push_back(theDbe->bookInt("processedEvents"));
+
+  // the counters must have the type DTEventCounters reads (booked in the order of its streams)
+  for(int stream = 0; stream != DTEventCounters::nStreams; ++stream) {
+    const MonitorElement* counter = theCounters[stream];
+    MonitorElement::Kind kind = stream == DTEventCounters::Processed ?
+      MonitorElement::DQM_KIND_INT : MonitorElement::DQM_KIND_REAL;
+    if(counter->kind() != kind) {
+      throw cms::Exception("DTSyntheticSourceMEs") << "counter " << counter->getFullname()
+						   << " does not match what DTEventCounters reads";
+    }
+  }
+
+  for(vector<ParameterSet>::const_iterator pset = theTemplates.begin();
+      pset != theTemplates.end(); ++pset) {
+    bookTemplate(*pset);
+  }
+
+  LogVerbatim("DTDQM|DTMonitorClient|DTSyntheticSourceMEs")
+    << "[DTSyntheticSourceMEs]: booked " << theMEs.size() << " synthetic MEs from "
+    << theTemplates.size() << " templates";
+
+}
+
+
+
+void DTSyntheticSourceMEs::beginLuminosityBlock(const LuminosityBlock& lumi, const  EventSetup& setup) {
+
+  theEvents += eventsPerLS;
+  for(vector<MonitorElement*>::const_iterator counter = theCounters.begin();
+      counter != theCounters.end(); ++counter) {
+    (*counter)->Fill(theEvents);
+  }
+
+  for(vector<SyntheticME>::iterator synthME = theMEs.begin(); synthME != theMEs.end(); ++synthME) {
+    fill(*synthME);
+  }
+
+}
+
+
+
+void DTSyntheticSourceMEs::analyze(const Event& event, const EventSetup& setup){}
+
+
+
+void DTSyntheticSourceMEs::bookTemplate(const ParameterSet& pset) {
+
+  string folder = pset.getUntrackedParameter<string>("folder");
+  string name = pset.getUntrackedParameter<string>("name");
+  string granularity = pset.getUntrackedParameter<string>("granularity", "chamber");
+
+  if(granularity == "global") {
+    bookME(pset, folder, name);
+  } else if(granularity == "fed") {
+    for(int fed = 770; fed != 775; ++fed) {
+      bookME(pset, substitute(folder,0,0,0,0,fed), substitute(name,0,0,0,0,fed));
+    }
+  } else {
+    for(int wheel = -2; wheel != 3; ++wheel) {
+      if(granularity == "wheel") {
+	bookME(pset, substitute(folder,wheel,0,0,0,0), substitute(name,wheel,0,0,0,0));
+	continue;
+      }
+      for(int sector = 1; sector != 13; ++sector) {
+	if(granularity == "sector") {
+	  bookME(pset, substitute(folder,wheel,0,sector,0,0), substitute(name,wheel,0,sector,0,0));
+	  continue;
+	}
+	for(int station = 1; station != 5; ++station) {
+	  // sectors 13 and 14 only exist in MB4
+	  int lastSector = (station == 4 && (sector == 4 || sector == 10)) ? 2 : 1;
+	  for(int iSector = 0; iSector != lastSector; ++iSector) {
+	    int sec = iSector == 0 ? sector : (sector == 4 ? 13 : 14);
+	    if(granularity == "chamber") {
+	      bookME(pset, substitute(folder,wheel,station,sec,0,0), substitute(name,wheel,station,sec,0,0));
+	      continue;
+	    }
+	    // superlayer
+	    for(int sl = 1; sl != 4; ++sl) {
+	      if(station == 4 && sl == 2) continue;
+	      bookME(pset, substitute(folder,wheel,station,sec,sl,0), substitute(name,wheel,station,sec,sl,0));
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+}
+
+
+
+void DTSyntheticSourceMEs::bookME(const ParameterSet& pset, const string& folder, const string& name) {
+
+  SyntheticME synthME;
+
+  int nBinsX = pset.getUntrackedParameter<int>("nBinsX");
+  double xMin = pset.getUntrackedParameter<double>("xMin");
+  double xMax = pset.getUntrackedParameter<double>("xMax");
+  int nBinsY = pset.getUntrackedParameter<int>("nBinsY", 0);
+
+  theDbe->setCurrentFolder(folder);
+  synthME.is2D = nBinsY > 0;
+  if(synthME.is2D) {
+    double yMin = pset.getUntrackedParameter<double>("yMin");
+    double yMax = pset.getUntrackedParameter<double>("yMax");
+    synthME.me = theDbe->book2D(name, name, nBinsX, xMin, xMax, nBinsY, yMin, yMax);
+  } else {
+    synthME.me = theDbe->book1D(name, name, nBinsX, xMin, xMax);
+  }
+
+  string pattern = pset.getUntrackedParameter<string>("pattern", "occupancy");
+  synthME.pattern = pattern == "gaussian" ? Gaussian : (pattern == "errors" ? Errors : Occupancy);
+  // relative to the global occupancy for Occupancy, # of entries otherwise
+  synthME.rate = pset.getUntrackedParameter<double>("rate", 1.);
+  if(synthME.pattern == Occupancy) synthME.rate *= occupancy;
+  synthME.mean = pset.getUntrackedParameter<double>("mean", 0.);
+  synthME.sigma = pset.getUntrackedParameter<double>("sigma", 1.);
+
+  if(synthME.pattern == Occupancy) {
+    synthME.columnScale.resize(nBinsX, 1.);
+    for(int bin = 0; bin != nBinsX; ++bin) {
+      double random = theRandom.Rndm();
+      if(random < deadFraction) synthME.columnScale[bin] = 0.;
+      else if(random < deadFraction + noisyFraction) synthME.columnScale[bin] = noiseFactor;
+    }
+  }
+
+  theMEs.push_back(synthME);
+
+}
+
+
+
+string DTSyntheticSourceMEs::substitute(string pattern, int wheel, int station, int sector, int sl, int fed) {
+
+  const char* tags[5] = { "%W", "%St", "%Sec", "%SL", "%FED" };
+  int values[5] = { wheel, station, sector, sl, fed };
+  for(int iTag = 0; iTag != 5; ++iTag) {
+    stringstream value; value << values[iTag];
+    string::size_type pos;
+    while((pos = pattern.find(tags[iTag])) != string::npos) {
+      pattern.replace(pos, string(tags[iTag]).size(), value.str());
+    }
+  }
+  return pattern;
+
+}
+
+
+
+void DTSyntheticSourceMEs::fill(SyntheticME& synthME) {
+
+  MonitorElement* me = synthME.me;
+  int nBinsX = me->getNbinsX();
+  int nBinsY = synthME.is2D ? me->getNbinsY() : 1;
+
+  switch(synthME.pattern) {
+
+  case Occupancy: {
+    double entries = me->getEntries();
+    for(int binX = 1; binX <= nBinsX; ++binX) {
+      double mu = synthME.rate*synthME.columnScale[binX-1];
+      if(mu == 0.) continue;
+      for(int binY = 1; binY <= nBinsY; ++binY) {
+	int counts = theRandom.Poisson(mu);
+	if(synthME.is2D) me->setBinContent(binX, binY, me->getBinContent(binX, binY) + counts);
+	else me->setBinContent(binX, me->getBinContent(binX) + counts);
+	entries += counts;
+      }
+    }
+    me->setEntries(entries);
+    break;
+  }
+
+  case Gaussian: {
+    int entries = theRandom.Poisson(synthME.rate);
+    for(int entry = 0; entry != entries; ++entry) {
+      double x = theRandom.Gaus(synthME.mean, synthME.sigma);
+      if(synthME.is2D) me->Fill(x, theRandom.Gaus(synthME.mean, synthME.sigma));
+      else me->Fill(x);
+    }
+    break;
+  }
+
+  case Errors: {
+    // the first bin collects the good entries, the errors are spread over the other bins
+    int entries = theRandom.Poisson(synthME.rate);
+    int errors = theRandom.Binomial(entries, errorFraction);
+    double xFirst = me->getTH1()->GetXaxis()->GetBinCenter(1);
+    for(int entry = 0; entry != entries - errors; ++entry) me->Fill(xFirst);
+    for(int error = 0; error != errors; ++error) {
+      int binX = 2 + theRandom.Integer(nBinsX > 1 ? nBinsX - 1 : 1);
+      double x = me->getTH1()->GetXaxis()->GetBinCenter(binX);
+      if(synthME.is2D) me->Fill(x, me->getTH1()->GetYaxis()->GetBinCenter(1 + theRandom.Integer(nBinsY)));
+      else me->Fill(x);
+    }
+    break;
+  }
+
+  }
+
+}
+
+
+DEFINE_FWK_MODULE(DTSyntheticSourceMEs);
@@ -0,0 +1,85 @@
+#ifndef DTMonitorClient_DTSyntheticSourceMEs_H
+#define DTMonitorClient_DTSyntheticSourceMEs_H
+
+/** \class DTSyntheticSourceMEs
+ *  Books and fills, at the beginning of each LS, synthetic versions of the
+ *  MEs filled by the DT DQM sources, with the folder layout read by the
+ *  clients, so that the clients can be run (and benchmarked) on a job with
+ *  no input data. The MEs are described by the "histos" VPSet (folder and
+ *  name patterns, granularity, binning and fill pattern); occupancy, noise
+ *  and error rates are configurable. The EventInfo event counters are
+ *  filled too.
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "TRandom3.h"
+
+#include <string>
+#include <vector>
+
+class DQMStore;
+class MonitorElement;
+
+class DTSyntheticSourceMEs : public edm::EDAnalyzer {
+public:
+  /// Constructor
+  DTSyntheticSourceMEs(const edm::ParameterSet& pset);
+
+  /// Destructor
+  virtual ~DTSyntheticSourceMEs();
+
+private:
+  virtual void beginJob();
+  virtual void beginLuminosityBlock(const edm::LuminosityBlock& lumi, const  edm::EventSetup& setup);
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+
+  /// How an ME is filled at each LS
+  enum Pattern { Occupancy, Gaussian, Errors };
+
+  struct SyntheticME {
+    MonitorElement* me;
+    Pattern pattern;
+    bool is2D;
+    double rate;   // entries per bin (Occupancy) or per ME (Gaussian, Errors) per LS
+    double mean;
+    double sigma;
+    std::vector<float> columnScale; // 0 for dead, noiseFactor for noisy columns
+  };
+
+  /// Book the MEs of one template for all the elements of its granularity
+  void bookTemplate(const edm::ParameterSet& pset);
+
+  /// Book one ME, the placeholders %W %St %Sec %SL %FED already replaced
+  void bookME(const edm::ParameterSet& pset, const std::string& folder, const std::string& name);
+
+  /// Replace the placeholders of a pattern
+  static std::string substitute(std::string pattern, int wheel, int station, int sector, int sl, int fed);
+
+  /// Add one LS worth of entries
+  void fill(SyntheticME& synthME);
+
+  DQMStore *theDbe;
+  TRandom3 theRandom;
+
+  int eventsPerLS;
+  double occupancy;
+  double deadFraction;
+  double noisyFraction;
+  double noiseFactor;
+  double errorFraction;
+  std::vector<edm::ParameterSet> theTemplates;
+
+  std::vector<SyntheticME> theMEs;
+  std::vector<MonitorElement*> theCounters;
+  int theEvents;
+
+};
+
+
+#endif
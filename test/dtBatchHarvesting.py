@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+#
+# Batch harvesting of many runs with the DT clients.
+# The input must be EDM files with the MEtoEDM products of the DT sources
+# (the plain DQM root files can not be read by EDMtoME). The files are
+# grouped by run from their /store path (.../000/123/456/...) and each run
+# is harvested by its own cmsRun job (dt_batch_harvesting_cfg.py), with at
+# most N jobs running in parallel: one run per job keeps the DQMStore of a
+# job free of the MEs of other runs. Files whose run can not be found from
+# the name are harvested alone, they must contain a single run.
+# The output (one file per run) is written by the DQM saver in <outputDir>,
+# the log of each job in <outputDir>/job<N>.log
+#
+# Usage: dtBatchHarvesting.py [-j N] [-o outputDir] [-c client1,client2]
+#                             [-m mapping.db] [-g globalTag] <files or @fileList>
+
+import optparse
+import os
+import re
+import subprocess
+import sys
+import time
+
+CFG = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'dt_batch_harvesting_cfg.py')
+
+# run number from the /store path of the EDM file: /store/.../000/123/456/...
+RUN_PATTERN = re.compile(r'/(\d{3})/(\d{3})/(\d{3})/')
+
+def runNumber(fileName):
+    match = RUN_PATTERN.search(fileName)
+    if match:
+        return int(''.join(match.groups()))
+    return 0
+
+def fileSize(fileName):
+    try:
+        return os.path.getsize(fileName)
+    except OSError:
+        return 1
+
+def readInputs(args):
+    files = []
+    for arg in args:
+        if arg.startswith('@'):
+            files += [line.strip() for line in open(arg[1:]) if line.strip() and not line.startswith('#')]
+        else:
+            files.append(arg)
+    return files
+
+def splitRuns(files):
+    # one job per run, the largest runs first; the files of unknown run go alone
+    runs = {}
+    unknown = []
+    for fileName in files:
+        run = runNumber(fileName)
+        if run == 0:
+            unknown.append([fileName])
+        else:
+            runs.setdefault(run, []).append(fileName)
+    jobs = [sorted(runs[run]) for run in sorted(runs, key=lambda run: -sum([fileSize(f) for f in runs[run]]))]
+    return jobs + unknown
+
+def main(argv):
+    parser = optparse.OptionParser(usage='%prog [options] <files or @fileList>')
+    parser.add_option('-j', '--jobs', type='int', default=4, help='number of parallel jobs')
+    parser.add_option('-o', '--outputDir', default='harvesting', help='output directory')
+    parser.add_option('-c', '--clients', default='', help='comma separated list of client modules')
+    parser.add_option('-m', '--mappingFile', default='', help='local sqlite file with the readout mapping')
+    parser.add_option('-g', '--globalTag', default='', help='global tag')
+    (opts, args) = parser.parse_args(argv[1:])
+
+    files = readInputs(args)
+    if not files:
+        parser.print_usage()
+        return 1
+    if not os.path.isdir(opts.outputDir):
+        os.makedirs(opts.outputDir)
+
+    def start(iJob, jobFiles):
+        command = ['cmsRun', CFG, 'inputFiles=' + ','.join(jobFiles),
+                   'outputDir=' + opts.outputDir]
+        if opts.clients:
+            command.append('clients=' + opts.clients)
+        if opts.mappingFile:
+            command.append('mappingFile=' + os.path.abspath(opts.mappingFile))
+        if opts.globalTag:
+            command.append('globalTag=' + opts.globalTag)
+        log = open(os.path.join(opts.outputDir, 'job%d.log' % iJob), 'w')
+        return (iJob, len(jobFiles), time.time(), log,
+                subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT))
+
+    def finish(job):
+        iJob, nFiles, start, log, process = job
+        code = process.returncode
+        log.close()
+        print('job %d: %d files, exit code %d, %.0f s' % (iJob, nFiles, code, time.time() - start))
+        return code
+
+    # at most N jobs at a time, a new one is started when one ends
+    status = 0
+    pending = list(enumerate(splitRuns(files)))
+    running = []
+    while pending or running:
+        while pending and len(running) < max(opts.jobs, 1):
+            running.append(start(*pending.pop(0)))
+        time.sleep(1)
+        for job in [job for job in running if job[4].poll() is not None]:
+            running.remove(job)
+            if finish(job) != 0:
+                status = 1
+    return status
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+#
+# Summary of the JSON-lines file written by DTClientPerformanceMonitor
+# (e.g. by dt_client_benchmark_cfg.py): for each client method the
+# percentiles of the wall time per LS, the mean CPU time and heap growth,
+# then the resident memory high-water mark of the job.
+#
+# Usage: dtClientBenchmarkReport.py <jsonFile>
+
+import json
+import sys
+
+def percentile(values, fraction):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(fraction*len(values)))]
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write('Usage: %s <jsonFile>\n' % argv[0])
+        return 1
+    records = {}
+    maxRSS = 0
+    for line in open(argv[1]):
+        if not line.strip():
+            continue
+        record = json.loads(line)
+        key = '%s:%s' % (record['client'], record['method'])
+        records.setdefault(key, []).append(record)
+        maxRSS = max(maxRSS, record.get('maxRSS', 0))
+
+    print('%-55s %6s %9s %9s %9s %9s %9s %11s' % ('client:method', 'LS', 'p50 (ms)', 'p90 (ms)',
+                                                   'p99 (ms)', 'max (ms)', 'cpu (ms)', 'heap (kB)'))
+    rows = []
+    for key, values in records.items():
+        wall = [1000.*r['wallTime'] for r in values]
+        cpu = sum([1000.*r['cpuTime'] for r in values])/len(values)
+        heap = sum([r['heapGrowth'] for r in values])/len(values)/1024.
+        rows.append((percentile(wall, 0.99), key, len(values), percentile(wall, 0.5),
+                     percentile(wall, 0.9), max(wall), cpu, heap))
+    for p99, key, n, p50, p90, peak, cpu, heap in sorted(rows, reverse=True):
+        print('%-55s %6d %9.2f %9.2f %9.2f %9.2f %9.2f %11.1f' % (key, n, p50, p90, p99, peak, cpu, heap))
+    print('peak resident memory: %d MB' % (maxRSS/1024))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
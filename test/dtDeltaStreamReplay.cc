@@ -0,0 +1,207 @@
+/*
+ *  Replay of the per LS delta log of the DT client results written by
+ *  DTDeltaStreamWriter (see src/DTDeltaStreamFormat.h).
+ *
+ *  Usage: dtDeltaStreamReplay <file>                 list the archived runs and LS
+ *         dtDeltaStreamReplay <file> <run> <LS>      print the state of the MEs at the end of the LS
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTDeltaStreamFormat.h"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+
+using namespace std;
+using namespace DTDeltaStream;
+
+namespace {
+
+  struct MEDefinition {
+    string name;
+    int nBinsX;
+    int nBinsY;
+  };
+
+  /// Read the definition payload
+  bool readDefinition(istream& in, map<int, MEDefinition>& definitions) {
+    uint16_t id, nBinsX, nBinsY, length;
+    if(!get(in, id) || !get(in, nBinsX) || !get(in, nBinsY) || !get(in, length)) return false;
+    string name(length, ' ');
+    if(length != 0 && !in.read(&name[0], length)) return false;
+    MEDefinition& definition = definitions[id];
+    definition.name = name;
+    definition.nBinsX = nBinsX;
+    definition.nBinsY = nBinsY;
+    return true;
+  }
+
+  /// Read a KeyFrame/Delta payload, applying it to the state if given
+  bool readResults(istream& in, uint32_t& run, uint32_t& lumi, map<int, vector<float> >* state) {
+    uint16_t nMEs;
+    if(!get(in, run) || !get(in, lumi) || !get(in, nMEs)) return false;
+    for(int iME = 0; iME != nMEs; ++iME) {
+      uint16_t id, nBins;
+      if(!get(in, id) || !get(in, nBins)) return false;
+      for(int iBin = 0; iBin != nBins; ++iBin) {
+	uint16_t bin;
+	float value;
+	if(!get(in, bin) || !get(in, value)) return false;
+	if(state != 0) {
+	  vector<float>& values = (*state)[id];
+	  if(values.size() <= bin) values.resize(bin+1, 0.);
+	  values[bin] = value;
+	}
+      }
+    }
+    return true;
+  }
+
+  /// Read the index at the end of the file
+  bool readIndex(ifstream& in, vector<IndexEntry>& index) {
+    in.seekg(0, ios::end);
+    long fileSize = in.tellg();
+    if(fileSize < 2*long(sizeof(uint32_t)) + trailerSize) return false;
+    in.seekg(fileSize - trailerSize);
+    uint64_t offset;
+    uint32_t magic, nEntries;
+    if(!get(in, offset) || !get(in, magic) || magic != indexMagic) return false;
+    in.seekg(offset);
+    if(!get(in, magic) || magic != indexMagic || !get(in, nEntries)) return false;
+    index.resize(nEntries);
+    for(uint32_t iEntry = 0; iEntry != nEntries; ++iEntry) {
+      IndexEntry& entry = index[iEntry];
+      if(!get(in, entry.type) || !get(in, entry.run) || !get(in, entry.lumi) || !get(in, entry.offset)) return false;
+    }
+    return true;
+  }
+
+  /// Build the index reading all the blocks (file without index, e.g. of a job that crashed)
+  void scanBlocks(ifstream& in, vector<IndexEntry>& index) {
+    in.clear();
+    in.seekg(2*sizeof(uint32_t));
+    index.clear();
+    map<int, MEDefinition> definitions;
+    while(true) {
+      IndexEntry entry;
+      entry.offset = in.tellg();
+      entry.run = 0;
+      entry.lumi = 0;
+      if(!get(in, entry.type)) break;
+      bool good = false;
+      if(entry.type == Definition) good = readDefinition(in, definitions);
+      else if(entry.type == KeyFrame || entry.type == Delta) good = readResults(in, entry.run, entry.lumi, 0);
+      if(!good) break;
+      index.push_back(entry);
+    }
+    in.clear();
+  }
+
+}
+
+
+int main(int argc, char **argv) {
+
+  if(argc != 2 && argc != 4) {
+    cerr << "Usage: " << argv[0] << " <file> [<run> <LS>]" << endl;
+    return 1;
+  }
+
+  ifstream in(argv[1], ios::in | ios::binary);
+  uint32_t magic, fileVersion;
+  if(!in || !get(in, magic) || !get(in, fileVersion) || magic != fileMagic || fileVersion != version) {
+    cerr << "Cannot read " << argv[1] << ": not a DT delta log of version " << version << endl;
+    return 1;
+  }
+
+  vector<IndexEntry> index;
+  if(!readIndex(in, index)) {
+    cerr << "No index in " << argv[1] << ", reading the blocks sequentially" << endl;
+    scanBlocks(in, index);
+  }
+  in.clear();
+
+  // the ME definitions
+  map<int, MEDefinition> definitions;
+  for(vector<IndexEntry>::const_iterator entry = index.begin(); entry != index.end(); ++entry) {
+    if((*entry).type != Definition) continue;
+    in.seekg((*entry).offset + 1);
+    readDefinition(in, definitions);
+  }
+
+  if(argc == 2) {
+    // list the runs
+    map<uint32_t, vector<const IndexEntry*> > runs;
+    for(vector<IndexEntry>::const_iterator entry = index.begin(); entry != index.end(); ++entry) {
+      if((*entry).type != Definition) runs[(*entry).run].push_back(&*entry);
+    }
+    cout << definitions.size() << " MEs archived" << endl;
+    for(map<int, MEDefinition>::const_iterator definition = definitions.begin();
+	definition != definitions.end(); ++definition) {
+      cout << "  " << (*definition).second.name << " (" << (*definition).second.nBinsX
+	   << " x " << (*definition).second.nBinsY << ")" << endl;
+    }
+    for(map<uint32_t, vector<const IndexEntry*> >::const_iterator run = runs.begin(); run != runs.end(); ++run) {
+      int nKeyFrames = 0;
+      for(vector<const IndexEntry*>::const_iterator entry = (*run).second.begin(); entry != (*run).second.end(); ++entry) {
+	if((*entry)->type == KeyFrame) ++nKeyFrames;
+      }
+      cout << "run " << (*run).first << ": LS " << (*run).second.front()->lumi << " - " << (*run).second.back()->lumi
+	   << ", " << (*run).second.size() << " blocks (" << nKeyFrames << " key frames)" << endl;
+    }
+    return 0;
+  }
+
+  // the blocks to apply: from the last key frame of the run before the LS up to the LS
+  uint32_t run = strtoul(argv[2], 0, 10);
+  uint32_t lumi = strtoul(argv[3], 0, 10);
+  int first = -1;
+  int last = -1;
+  for(unsigned int iEntry = 0; iEntry != index.size(); ++iEntry) {
+    const IndexEntry& entry = index[iEntry];
+    if(entry.type == Definition || entry.run != run || entry.lumi > lumi) continue;
+    if(entry.type == KeyFrame) first = iEntry;
+    last = iEntry;
+  }
+  if(first < 0) {
+    cerr << "No results archived for run " << run << " up to LS " << lumi << endl;
+    return 1;
+  }
+
+  map<int, vector<float> > state;
+  for(int iEntry = first; iEntry <= last; ++iEntry) {
+    const IndexEntry& entry = index[iEntry];
+    if(entry.type == Definition || entry.run != run || entry.lumi > lumi) continue;
+    in.seekg(entry.offset + 1);
+    uint32_t blockRun, blockLumi;
+    if(!readResults(in, blockRun, blockLumi, &state)) {
+      cerr << "Corrupted block at offset " << entry.offset << endl;
+      return 1;
+    }
+  }
+
+  cout << "run " << run << " LS " << lumi << " (" << last-first+1 << " blocks applied)" << endl;
+  for(map<int, MEDefinition>::const_iterator definition = definitions.begin();
+      definition != definitions.end(); ++definition) {
+    const MEDefinition& me = (*definition).second;
+    vector<float> values = state[(*definition).first];
+    values.resize(me.nBinsX*me.nBinsY, 0.);
+    cout << me.name << endl;
+    for(int binY = me.nBinsY; binY >= 1; --binY) {
+      for(int binX = 1; binX <= me.nBinsX; ++binX) {
+	cout << " " << setw(7) << setprecision(3) << values[(binX-1) + (binY-1)*me.nBinsX];
+      }
+      cout << endl;
+    }
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/env python
+#
+# Convert DTFineDelayCorr delay tables between the text format
+# ("wheel sector station coarse fine" per line) and the binary format
+# read by DTFineDelayTable (magic "DTFD", uint32 version, uint32 # of records,
+# then int32 wheel, sector, station, coarse and float fine per record).
+#
+# Usage: dtFineDelayConvert.py <input> <output>
+# The input format is recognized from the magic, the output is the other one.
+
+import struct
+import sys
+
+MAGIC = b'DTFD'
+VERSION = 1
+RECORD = struct.Struct('=iiiif')
+HEADER = struct.Struct('=4sII')
+
+def readText(fileName):
+    records = []
+    for line in open(fileName):
+        if not line.strip() or line.startswith('#'):
+            continue
+        fields = line.split()
+        records.append((int(fields[0]), int(fields[1]), int(fields[2]),
+                        int(float(fields[3])), float(fields[4])))
+    return records
+
+def readBinary(data):
+    magic, version, nRecords = HEADER.unpack_from(data, 0)
+    if version != VERSION:
+        raise ValueError('unsupported binary version %d' % version)
+    return [RECORD.unpack_from(data, HEADER.size + i*RECORD.size) for i in range(nRecords)]
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write('Usage: %s <input> <output>\n' % argv[0])
+        return 1
+    data = open(argv[1], 'rb').read()
+    if data[:4] == MAGIC:
+        out = open(argv[2], 'w')
+        for rec in readBinary(data):
+            out.write('%d %d %d %d %g \n' % rec)
+    else:
+        records = readText(argv[1])
+        # same ordering as DTFineDelayTable: wheel, station, sector
+        records.sort(key=lambda rec: (rec[0], rec[2], rec[1]))
+        out = open(argv[2], 'wb')
+        out.write(HEADER.pack(MAGIC, VERSION, len(records)))
+        for rec in records:
+            out.write(RECORD.pack(*rec))
+    out.close()
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,102 @@
+/*
+ *  Heap and resident memory of the chamber X vs Y efficiency maps kept as
+ *  DTSparseHisto (sparseStorage) and as dense bin arrays of the size of the
+ *  TH2F contents (the ROOT object overhead of the dense MEs is not included).
+ *  The maps are filled with a random fraction of non-empty bins; run the
+ *  two storages in separate processes to compare the resident memory.
+ *
+ *  Usage: dtSparseHistoMemory sparse|dense [nChambers=250] [fillFraction=0.3] [nBins=25]
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/src/DTSparseHisto.h"
+
+#include <malloc.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+  /// Heap in use (bytes)
+  long heapBytes() {
+    struct mallinfo info = mallinfo();
+    return long(info.uordblks) + long(info.hblkhd);
+  }
+
+  /// Resident set size (bytes)
+  long rssBytes() {
+    long pages = 0, resident = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if(statm == 0) return 0;
+    if(fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(statm);
+    return resident*sysconf(_SC_PAGESIZE);
+  }
+
+  void report(const char* label, long heapBefore, long rssBefore, int nChambers) {
+    long heap = heapBytes() - heapBefore;
+    long rss = rssBytes() - rssBefore;
+    printf("%-8s heap %9.1f kB (%7.0f B/chamber)   RSS %9.1f kB\n",
+	   label, heap/1024., double(heap)/nChambers, rss/1024.);
+  }
+
+}
+
+
+int main(int argc, char* argv[]) {
+
+  if(argc < 2 || (string(argv[1]) != "sparse" && string(argv[1]) != "dense")) {
+    fprintf(stderr, "Usage: %s sparse|dense [nChambers=250] [fillFraction=0.3] [nBins=25]\n", argv[0]);
+    return 1;
+  }
+  bool sparseMode = string(argv[1]) == "sparse";
+  int nChambers = argc > 2 ? atoi(argv[2]) : 250;
+  double fillFraction = argc > 3 ? atof(argv[3]) : 0.3;
+  int nBins = argc > 4 ? atoi(argv[4]) : 25;
+  srand(12345);
+
+  long heapBefore = heapBytes();
+  long rssBefore = rssBytes();
+
+  if(!sparseMode) {
+    // dense bin arrays, one per chamber as the TH2F of the eager booking
+    vector<float*> dense(nChambers);
+    for(int chamber = 0; chamber != nChambers; ++chamber) {
+      dense[chamber] = new float[(nBins+2)*(nBins+2)]();
+      for(int binX = 1; binX <= nBins; ++binX) {
+	for(int binY = 1; binY <= nBins; ++binY) {
+	  if(rand() < fillFraction*RAND_MAX) dense[chamber][binX + (nBins+2)*binY] = 0.5 + 0.5*rand()/RAND_MAX;
+	}
+      }
+    }
+    report("dense", heapBefore, rssBefore, nChambers);
+    return 0;
+  }
+
+  // sparse maps
+  vector<DTSparseHisto> sparse(nChambers, DTSparseHisto(nBins, nBins));
+  long nFilled = 0;
+  for(int chamber = 0; chamber != nChambers; ++chamber) {
+    for(int binX = 1; binX <= nBins; ++binX) {
+      for(int binY = 1; binY <= nBins; ++binY) {
+	if(rand() < fillFraction*RAND_MAX) {
+	  sparse[chamber].setBinContent(binX, binY, 0.5 + 0.5*rand()/RAND_MAX);
+	  ++nFilled;
+	}
+      }
+    }
+  }
+  printf("%d chambers, %dx%d bins, %ld filled bins (%.0f%%)\n", nChambers, nBins, nBins, nFilled,
+	 100.*nFilled/(double(nChambers)*nBins*nBins));
+  report("sparse", heapBefore, rssBefore, nChambers);
+
+  return 0;
+
+}
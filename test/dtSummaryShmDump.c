@@ -0,0 +1,58 @@
+/*
+ *  Print the DT summary maps published in shared memory by DTSummaryShmPublisher.
+ *
+ *  Usage: dtSummaryShmDump [segmentName]    (default /dtDQMSummaries)
+ *
+ *  $Date$
+ *  $Revision$
+ */
+
+#include "DQM/DTMonitorClient/test/DTSummaryShmReader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv) {
+
+  const char *name = argc > 1 ? argv[1] : "/dtDQMSummaries";
+  DTSummaryShmSegment *snapshot;
+  DTSummaryShmReader *reader;
+  uint32_t iMap, iReport;
+  int binX, binY, status;
+
+  reader = dtSummaryShmOpen(name);
+  if(reader == 0) {
+    fprintf(stderr, "cannot open the segment %s\n", name);
+    return 1;
+  }
+  snapshot = (DTSummaryShmSegment*)malloc(sizeof(DTSummaryShmSegment));
+  status = snapshot != 0 ? dtSummaryShmRead(reader, snapshot) : -2;
+  dtSummaryShmClose(reader);
+  if(status != 0) {
+    fprintf(stderr, "cannot read the segment %s (%s)\n", name, status == -1 ? "incompatible layout" : "no consistent copy");
+    free(snapshot);
+    return 1;
+  }
+
+  printf("run %d LS %d, sequence %u, updated at %.3f\n",
+	 snapshot->run, snapshot->lumi, snapshot->sequence, snapshot->updateTime);
+  for(iMap = 0; iMap < snapshot->nMaps; ++iMap) {
+    const DTSummaryShmMap *map = &snapshot->maps[iMap];
+    printf("%s (%d x %d)\n", map->name, map->nBinsX, map->nBinsY);
+    for(binY = map->nBinsY; binY >= 1; --binY) {
+      for(binX = 1; binX <= map->nBinsX; ++binX) {
+	printf(" %7.3g", dtSummaryShmBin(map, binX, binY));
+      }
+      printf("\n");
+    }
+  }
+  for(iReport = 0; iReport < snapshot->nReports; ++iReport) {
+    const DTSummaryShmReport *report = &snapshot->reports[iReport];
+    if(report->valid) printf("%s = %g\n", report->name, report->value);
+    else printf("%s not available\n", report->name);
+  }
+
+  free(snapshot);
+  return 0;
+
+}
@@ -0,0 +1,94 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Harvesting of one run with the DT clients: the input files are EDM files
+# with the MEtoEDM products of the DT sources (EDMtoME can not read the plain
+# DQM root files) and must all belong to the same run, since EDMtoME adds
+# the MEs of each run to those already in the DQMStore.
+# The selected DT clients are run at the end of the run, the output is
+# saved by the DQM saver in outputDir.
+#
+# cmsRun dt_batch_harvesting_cfg.py inputFiles=file1.root,file2.root \
+#        clients=segmentTest,dtResolutionAnalysisTest outputDir=harvest
+#
+# Driven by dtBatchHarvesting.py, which runs one job per run over N parallel workers.
+
+options = VarParsing.VarParsing('analysis')
+options.register('clients', '',
+                 VarParsing.VarParsing.multiplicity.list,
+                 VarParsing.VarParsing.varType.string,
+                 "Modules of dtClients to run (default: the whole sequence)")
+options.register('outputDir', '.',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Directory for the per run output files")
+options.register('globalTag', 'GR09_P_V1::All',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Global tag")
+options.register('mappingFile', '',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Local sqlite file with the DT readout mapping (default: from the global tag)")
+options.register('workflow', '/Global/Harvesting/DQM',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Workflow name used in the output file names")
+options.parseArguments()
+
+process = cms.Process("DTHarvesting")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
+
+# Geometry & Calibration Tag
+process.load("Configuration.StandardSequences.Geometry_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+process.GlobalTag.globaltag = options.globalTag
+
+if options.mappingFile != '':
+    from CondCore.DBCommon.CondDBSetup_cfi import *
+    process.mappingsource = cms.ESSource("PoolDBESSource",
+        CondDBSetup,
+        timetype = cms.string('runnumber'),
+        toGet = cms.VPSet(cms.PSet(record = cms.string('DTReadOutMappingRcd'),
+                                   tag = cms.string('map')
+                                   )
+                          ),
+        connect = cms.string('sqlite_file:' + options.mappingFile),
+        authenticationMethod = cms.untracked.uint32(0)
+        )
+    process.es_prefer_mappingsource = cms.ESPrefer('PoolDBESSource','mappingsource')
+
+# the source: EDM files of a single run
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles),
+    processingMode = cms.untracked.string('RunsAndLumis')
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+
+process.load("DQMServices.Core.DQM_cfg")
+process.load("DQMServices.Components.EDMtoMEConverter_cff")
+process.load("DQMServices.Components.DQMEnvironment_cfi")
+process.dqmSaver.convention = "Offline"
+process.dqmSaver.workflow = options.workflow
+process.dqmSaver.dirName = options.outputDir
+process.dqmSaver.saveByRun = 1
+process.dqmSaver.saveAtJobEnd = False
+process.dqmEnv.subSystemFolder = "DT"
+
+process.load("DQM.DTMonitorClient.dtDQMOfflineClients_cff")
+
+if len(options.clients) == 0:
+    process.dtSelectedClients = cms.Sequence(process.dtClients)
+else:
+    process.dtSelectedClients = cms.Sequence(getattr(process, options.clients[0]))
+    for client in options.clients[1:]:
+        process.dtSelectedClients += getattr(process, client)
+
+process.p = cms.Path(process.EDMtoME *
+                     process.dtSelectedClients *
+                     process.dqmSaver)
@@ -0,0 +1,145 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Benchmark of the DT clients on synthetic source MEs (DTSyntheticSourceMEs):
+# no input file and no conditions DB, the geometry is built from the ideal XML.
+# Each iteration is one LS: the synthetic MEs are filled at the beginning of
+# the LS and the clients run their end of LS (and, at the end, end of run) code.
+# The per LS measurements are written by DTClientPerformanceMonitor to jsonFile:
+#
+# cmsRun dt_client_benchmark_cfg.py iterations=200 occupancy=20 jsonFile=bench.json
+# dtClientBenchmarkReport.py bench.json
+
+options = VarParsing.VarParsing()
+options.register('iterations', 100,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of LS")
+options.register('clients', '',
+                 VarParsing.VarParsing.multiplicity.list,
+                 VarParsing.VarParsing.varType.string,
+                 "Client modules to run (default: all the ones below)")
+options.register('occupancy', 5.,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.float,
+                 "Mean entries per cell per LS")
+options.register('deadFraction', 0.01,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.float,
+                 "Fraction of dead cells")
+options.register('noisyFraction', 0.005,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.float,
+                 "Fraction of noisy cells")
+options.register('errorFraction', 0.001,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.float,
+                 "Fraction of entries in the error bins")
+options.register('jsonFile', 'dtClientBenchmark.json',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Output of the per LS measurements")
+options.parseArguments()
+
+process = cms.Process("DTClientBenchmark")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+
+# memory high-water marks
+process.SimpleMemoryCheck = cms.Service("SimpleMemoryCheck",
+                                        ignoreTotal = cms.untracked.int32(1)
+                                        )
+
+# ideal geometry from the XML description
+process.load("Geometry.MuonCommonData.muonIdealGeometryXML_cfi")
+process.load("Geometry.MuonNumbering.muonNumberingInitialization_cfi")
+process.load("Geometry.DTGeometry.dtGeometry_cfi")
+process.DTGeometryESModule.applyAlignment = False
+
+# one event per LS
+process.source = cms.Source("EmptySource",
+                            numberEventsInLuminosityBlock = cms.untracked.uint32(1)
+                            )
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.iterations)
+)
+
+process.load("DQMServices.Core.DQM_cfg")
+
+# the synthetic source MEs
+def untracked(value):
+    if isinstance(value, int):
+        return cms.untracked.int32(value)
+    if isinstance(value, float):
+        return cms.untracked.double(value)
+    return cms.untracked.string(value)
+
+def meTemplate(folder, name, **parameters):
+    pset = cms.PSet(folder = cms.untracked.string(folder),
+                    name = cms.untracked.string(name))
+    for key, value in parameters.items():
+        setattr(pset, key, untracked(value))
+    return pset
+
+process.dtSyntheticSourceMEs = cms.EDAnalyzer("DTSyntheticSourceMEs",
+    occupancy = cms.untracked.double(options.occupancy),
+    deadFraction = cms.untracked.double(options.deadFraction),
+    noisyFraction = cms.untracked.double(options.noisyFraction),
+    errorFraction = cms.untracked.double(options.errorFraction),
+    histos = cms.untracked.VPSet(
+        # DTDigiTask
+        meTemplate("DT/01-Digi/Wheel%W/Sector%Sec/Station%St", "OccupancyAllHits_perCh_W%W_St%St_Sec%Sec",
+                        nBinsX = 100, xMin = 0.5, xMax = 100.5, nBinsY = 12, yMin = 0.5, yMax = 12.5),
+        # DTNoiseTask
+        meTemplate("DT/05-Noise/Wheel%W/Sector%Sec", "NoiseRate_W%W_St%St_Sec%Sec",
+                        nBinsX = 100, xMin = 0.5, xMax = 100.5, nBinsY = 12, yMin = 0.5, yMax = 12.5,
+                        rate = 0.1),
+        # DTSegmentAnalysisTask
+        meTemplate("DT/02-Segments/Wheel%W/Sector%Sec/Station%St", "h4DSegmNHits_W%W_St%St_Sec%Sec",
+                        nBinsX = 16, xMin = 0.5, xMax = 16.5, pattern = 'gaussian', rate = 200., mean = 8., sigma = 2.),
+        meTemplate("DT/02-Segments/Wheel%W/Sector%Sec/Station%St", "h4DChi2_W%W_St%St_Sec%Sec",
+                        nBinsX = 20, xMin = 0., xMax = 20., pattern = 'gaussian', rate = 200., mean = 3., sigma = 2.),
+        meTemplate("DT/02-Segments/Wheel%W", "numberOfSegments_W%W", granularity = 'wheel',
+                        nBinsX = 12, xMin = 0.5, xMax = 12.5, nBinsY = 4, yMin = 0.5, yMax = 4.5, rate = 40.),
+        # DTResolutionAnalysisTask
+        meTemplate("DT/02-Segments/Wheel%W/Sector%Sec/Station%St", "hResDist_W%W_St%St_Sec%Sec_SL%SL",
+                        granularity = 'superlayer', nBinsX = 200, xMin = -0.4, xMax = 0.4,
+                        pattern = 'gaussian', rate = 1000., mean = 0., sigma = 0.03),
+        # DTLocalTriggerTask (DCC)
+        meTemplate("DT/03-LocalTrigger-DCC/Wheel%W/Sector%Sec/Station%St/LocalTriggerPhi", "DCC_BXvsQual_W%W_Sec%Sec_St%St",
+                        nBinsX = 7, xMin = -0.5, xMax = 6.5, nBinsY = 20, yMin = -9.5, yMax = 10.5,
+                        pattern = 'gaussian', rate = 200., mean = 4., sigma = 1.5),
+        meTemplate("DT/03-LocalTrigger-DCC/Wheel%W/Sector%Sec/Station%St/LocalTriggerPhi", "DCC_BestQual_W%W_Sec%Sec_St%St",
+                        nBinsX = 7, xMin = -0.5, xMax = 6.5, pattern = 'gaussian', rate = 200., mean = 4., sigma = 1.5),
+        meTemplate("DT/03-LocalTrigger-DCC/Wheel%W/Sector%Sec/Station%St/LocalTriggerPhi", "DCC_Flag1stvsQual_W%W_Sec%Sec_St%St",
+                        nBinsX = 7, xMin = -0.5, xMax = 6.5, nBinsY = 2, yMin = -0.5, yMax = 1.5,
+                        pattern = 'gaussian', rate = 200., mean = 2., sigma = 1.5),
+        # DTDataIntegrityTask
+        meTemplate("DT/00-DataIntegrity/FED%FED", "FED%FED_ROSStatus", granularity = 'fed',
+                        nBinsX = 12, xMin = 0., xMax = 12., nBinsY = 12, yMin = 1., yMax = 13.,
+                        pattern = 'errors', rate = 10000.)
+        )
+    )
+
+# the clients
+process.load("DQM.DTMonitorClient.dtOccupancyTest_cfi")
+process.load("DQM.DTMonitorClient.dtNoiseAnalysis_cfi")
+process.load("DQM.DTMonitorClient.dtSegmentAnalysisTest_cfi")
+process.load("DQM.DTMonitorClient.dtResolutionAnalysisTest_cfi")
+process.load("DQM.DTMonitorClient.dtLocalTriggerTest_cfi")
+process.triggerTest.hwSources = cms.untracked.vstring('DCC')
+process.load("DQM.DTMonitorClient.dtSummaryClients_cfi")
+
+clients = options.clients or ['dtOccupancyTest', 'dtNoiseAnalysisMonitor', 'segmentTest',
+                              'dtResolutionAnalysisTest', 'triggerTest', 'dtSummaryClients']
+process.dtBenchmarkClients = cms.Sequence(getattr(process, clients[0]))
+for client in clients[1:]:
+    process.dtBenchmarkClients += getattr(process, client)
+
+process.load("DQM.DTMonitorClient.dtClientPerformanceMonitor_cfi")
+process.dtClientPerformanceMonitor.jsonFile = options.jsonFile
+
+process.p = cms.Path(process.dtSyntheticSourceMEs *
+                     process.dtBenchmarkClients *
+                     process.dtClientPerformanceMonitor)